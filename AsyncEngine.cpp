@@ -0,0 +1,283 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO AsyncEngine
+ */
+
+#include <atomic>
+#include <limits>
+
+#if defined(__linux__)
+# include <cerrno>
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#include <Kube/Core/Abort.hpp>
+
+#include "AsyncEngine.hpp"
+#include "Instrumentation.hpp"
+
+using namespace kF;
+
+#if defined(__linux__)
+namespace
+{
+    [[nodiscard]] inline int RingEnter(const int ring, const std::uint32_t toSubmit, const std::uint32_t minComplete, const std::uint32_t flags) noexcept
+    {
+        if constexpr (IO::Instrumentation::IsEnabled())
+            IO::Instrumentation::RecordSyscall();
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, 0));
+    }
+}
+#endif
+
+IO::AsyncEngine::~AsyncEngine(void) noexcept
+{
+    // The kernel may still write into user buffers, so all in-flight requests must complete
+    while (_inFlight) {
+        waitCompletion();
+        reap();
+    }
+    destroyRing();
+}
+
+IO::AsyncEngine::AsyncEngine(const std::uint32_t queueDepth) noexcept
+    : _queueDepth(queueDepth)
+{
+    kFEnsure(queueDepth, "IO::AsyncEngine: Queue depth must be greater than zero");
+    createRing(queueDepth);
+}
+
+void IO::AsyncEngine::queueRead(File &file, std::uint8_t * const from, std::uint8_t * const to,
+        const std::size_t offset, const std::uint64_t userData) noexcept
+{
+    kFEnsure(Core::HasFlags(file.mode(), File::Mode::Read), "IO::AsyncEngine::queueRead: File not opened for reading");
+    const auto size = static_cast<std::size_t>(std::distance(from, to));
+    kFEnsure(size <= std::numeric_limits<std::uint32_t>::max(), "IO::AsyncEngine::queueRead: Request is too large");
+
+    // Resources are already in memory, complete them immediately
+    if (file.isResource()) {
+        const auto range = file.queryResource();
+        const auto count = offset < range.size() ? std::min(range.size() - offset, size) : std::size_t {};
+        // Reads past the end don't form pointers outside of the resource
+        if (count)
+            std::copy(range.begin() + offset, range.begin() + offset + count, from);
+        _completions.push(Completion { .userData = userData, .result = static_cast<std::int64_t>(count) });
+    } else {
+        _queued.push(Request {
+            .lease = file.leaseHandle(),
+            .data = from,
+            .size = static_cast<std::uint32_t>(size),
+            .operation = Operation::Read,
+            .offset = offset,
+            .userData = userData
+        });
+    }
+}
+
+void IO::AsyncEngine::queueWrite(File &file, const std::uint8_t * const from, const std::uint8_t * const to,
+        const std::size_t offset, const std::uint64_t userData) noexcept
+{
+    kFEnsure(!file.isResource(), "IO::AsyncEngine::queueWrite: Cannot write into resource file");
+    kFEnsure(Core::HasFlags(file.mode(), File::Mode::Write), "IO::AsyncEngine::queueWrite: File not opened for writing");
+    const auto size = static_cast<std::size_t>(std::distance(from, to));
+    kFEnsure(size <= std::numeric_limits<std::uint32_t>::max(), "IO::AsyncEngine::queueWrite: Request is too large");
+
+    _queued.push(Request {
+        .lease = file.leaseHandle(),
+        .data = const_cast<std::uint8_t *>(from),
+        .size = static_cast<std::uint32_t>(size),
+        .operation = Operation::Write,
+        .offset = offset,
+        .userData = userData
+    });
+}
+
+std::uint32_t IO::AsyncEngine::submit(void) noexcept
+{
+    if (_queued.empty())
+        return 0u;
+
+    std::uint32_t count {};
+    std::uint32_t submitted {};
+
+#if defined(__linux__)
+    if (isAsync()) {
+        const auto entries = reinterpret_cast<io_uring_sqe *>(_state.entries);
+        count = std::min(_queueDepth - _inFlight, _queued.size());
+        auto tail = *_state.submissionTail;
+        // Entries refer to free submissions from the back, so the ones the kernel accepts are simply popped
+        for (auto i = 0u; i != count; ++i) {
+            const auto &request = _queued[i];
+            const auto index = tail & _state.submissionMask;
+            auto &entry = entries[index];
+            entry = io_uring_sqe {};
+            entry.opcode = request.operation == Operation::Read ? IORING_OP_READ : IORING_OP_WRITE;
+            entry.fd = static_cast<int>(request.lease.handle());
+            entry.addr = reinterpret_cast<std::uint64_t>(request.data);
+            entry.len = request.size;
+            entry.off = request.offset;
+            entry.user_data = _freeSubmissions[_freeSubmissions.size() - 1u - i];
+            _state.submissionArray[index] = index;
+            ++tail;
+        }
+        std::atomic_ref(*_state.submissionTail).store(tail, std::memory_order_release);
+
+        // Submit the whole batch, the kernel may consume it in several calls
+        while (submitted != count) {
+            const auto ret = RingEnter(_ring, count - submitted, 0u, 0u);
+            if (ret >= 0) [[likely]]
+                submitted += static_cast<std::uint32_t>(ret);
+            else if (errno != EINTR)
+                break;
+        }
+        _inFlight += submitted;
+        for (auto &request : Core::IteratorRange<Request *> { _queued.begin(), _queued.begin() + submitted }) {
+            auto &submission = _submissions[_freeSubmissions.back()];
+            submission.lease = std::move(request.lease);
+            submission.userData = request.userData;
+            _freeSubmissions.pop();
+        }
+
+        // Take back entries the kernel refused, they will be executed synchronously
+        if (submitted != count) [[unlikely]]
+            std::atomic_ref(*_state.submissionTail).store(tail - (count - submitted), std::memory_order_release);
+    } else
+#endif
+        count = _queued.size();
+
+    for (const auto &request : Core::IteratorRange<Request *> { _queued.begin() + submitted, _queued.begin() + count })
+        _completions.push(execute(request));
+    _queued.erase(_queued.begin(), _queued.begin() + count);
+    return count;
+}
+
+std::uint32_t IO::AsyncEngine::poll(Completion * const from, Completion * const to) noexcept
+{
+    reap();
+    submit();
+    return popCompletions(from, to);
+}
+
+std::uint32_t IO::AsyncEngine::wait(Completion * const from, Completion * const to) noexcept
+{
+    reap();
+    if (_completions.empty()) {
+        submit();
+        if (_completions.empty() && _inFlight) {
+            waitCompletion();
+            reap();
+        }
+    }
+    submit();
+    return popCompletions(from, to);
+}
+
+void IO::AsyncEngine::createRing([[maybe_unused]] const std::uint32_t queueDepth) noexcept
+{
+#if defined(__linux__)
+    io_uring_params params {};
+    const auto ring = static_cast<int>(::syscall(__NR_io_uring_setup, queueDepth, &params));
+    if (ring < 0) // Not supported by the kernel or forbidden by the sandbox
+        return;
+
+    _state.submissionMappingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    _state.completionMappingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMapping = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMapping) {
+        _state.submissionMappingSize = std::max(_state.submissionMappingSize, _state.completionMappingSize);
+        _state.completionMappingSize = _state.submissionMappingSize;
+    }
+    _state.entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    const auto mapRing = [ring](const std::size_t size, const off_t offset) {
+        const auto data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+        return data == MAP_FAILED ? nullptr : data;
+    };
+    _state.submissionMapping = reinterpret_cast<std::uint8_t *>(mapRing(_state.submissionMappingSize, IORING_OFF_SQ_RING));
+    _state.completionMapping = singleMapping
+        ? _state.submissionMapping
+        : reinterpret_cast<std::uint8_t *>(mapRing(_state.completionMappingSize, IORING_OFF_CQ_RING));
+    _state.entries = mapRing(_state.entriesSize, IORING_OFF_SQES);
+    _ring = ring;
+    if (!_state.submissionMapping || !_state.completionMapping || !_state.entries) [[unlikely]] {
+        destroyRing();
+        return;
+    }
+
+    _state.submissionTail = reinterpret_cast<std::uint32_t *>(_state.submissionMapping + params.sq_off.tail);
+    _state.submissionArray = reinterpret_cast<std::uint32_t *>(_state.submissionMapping + params.sq_off.array);
+    _state.submissionMask = *reinterpret_cast<std::uint32_t *>(_state.submissionMapping + params.sq_off.ring_mask);
+    _state.completionHead = reinterpret_cast<std::uint32_t *>(_state.completionMapping + params.cq_off.head);
+    _state.completionTail = reinterpret_cast<std::uint32_t *>(_state.completionMapping + params.cq_off.tail);
+    _state.completionMask = *reinterpret_cast<std::uint32_t *>(_state.completionMapping + params.cq_off.ring_mask);
+    _state.completions = _state.completionMapping + params.cq_off.cqes;
+    _queueDepth = params.sq_entries;
+    _submissions.resize(_queueDepth);
+    for (auto index = _queueDepth; index; --index)
+        _freeSubmissions.push(index - 1u);
+#endif
+}
+
+void IO::AsyncEngine::destroyRing(void) noexcept
+{
+#if defined(__linux__)
+    if (_ring < 0)
+        return;
+    if (_state.entries)
+        ::munmap(_state.entries, _state.entriesSize);
+    if (_state.completionMapping && _state.completionMapping != _state.submissionMapping)
+        ::munmap(_state.completionMapping, _state.completionMappingSize);
+    if (_state.submissionMapping)
+        ::munmap(_state.submissionMapping, _state.submissionMappingSize);
+    ::close(_ring);
+    _ring = -1;
+    _state = Ring {};
+#endif
+}
+
+void IO::AsyncEngine::reap(void) noexcept
+{
+#if defined(__linux__)
+    if (!isAsync())
+        return;
+    const auto completions = reinterpret_cast<const io_uring_cqe *>(_state.completions);
+    auto head = *_state.completionHead;
+    const auto tail = std::atomic_ref(*_state.completionTail).load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+        const auto &completion = completions[head & _state.completionMask];
+        const auto index = static_cast<std::uint32_t>(completion.user_data);
+        auto &submission = _submissions[index];
+        _completions.push(Completion { .userData = submission.userData, .result = completion.res });
+        submission.lease.release();
+        _freeSubmissions.push(index);
+        --_inFlight;
+    }
+    std::atomic_ref(*_state.completionHead).store(head, std::memory_order_release);
+#endif
+}
+
+void IO::AsyncEngine::waitCompletion(void) noexcept
+{
+#if defined(__linux__)
+    while (RingEnter(_ring, 0u, 1u, IORING_ENTER_GETEVENTS) < 0 && errno == EINTR);
+#endif
+}
+
+IO::AsyncEngine::Completion IO::AsyncEngine::execute(const Request &request) const noexcept
+{
+    const auto count = request.operation == Operation::Read
+        ? Native::ReadAt(request.lease.handle(), request.data, request.size, request.offset)
+        : Native::WriteAt(request.lease.handle(), request.data, request.size, request.offset);
+    return Completion { .userData = request.userData, .result = static_cast<std::int64_t>(count) };
+}
+
+std::uint32_t IO::AsyncEngine::popCompletions(Completion * const from, Completion * const to) noexcept
+{
+    const auto count = std::min(Core::Distance<std::uint32_t>(from, to), _completions.size());
+    std::copy(_completions.begin(), _completions.begin() + count, from);
+    _completions.erase(_completions.begin(), _completions.begin() + count);
+    return count;
+}
@@ -0,0 +1,177 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO AsyncEngine
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "File.hpp"
+
+namespace kF::IO
+{
+    class AsyncEngine;
+}
+
+/** @brief Batched asynchronous read / write engine
+ *  @note On Linux requests are submitted through io_uring, a single system call submits a whole batch
+ *  @note When io_uring is not available, requests are executed synchronously at submission
+ *  @note The engine is not thread-safe, it must be used from a single thread
+ *  @note Handle pools of queued files must outlive the engine */
+class kF::IO::AsyncEngine
+{
+public:
+    /** @brief Default number of requests that can be in-flight at the same time */
+    static constexpr std::uint32_t DefaultQueueDepth = 256;
+
+    /** @brief Operation of a request */
+    enum class Operation : std::uint32_t
+    {
+        Read,
+        Write
+    };
+
+    /** @brief Result of a request */
+    struct Completion
+    {
+        /** @brief User data passed at request */
+        std::uint64_t userData {};
+        /** @brief Number of bytes transferred or negative error code */
+        std::int64_t result {};
+    };
+
+
+    /** @brief Destructor, waits for all in-flight requests */
+    ~AsyncEngine(void) noexcept;
+
+    /** @brief Constructor
+     *  @param queueDepth Maximum number of requests in-flight at the same time */
+    AsyncEngine(const std::uint32_t queueDepth = DefaultQueueDepth) noexcept;
+
+    /** @brief Deleted copy constructor */
+    AsyncEngine(const AsyncEngine &other) noexcept = delete;
+
+    /** @brief Deleted copy assignment */
+    AsyncEngine &operator=(const AsyncEngine &other) noexcept = delete;
+
+
+    /** @brief Check if the engine is truly asynchronous (io_uring available) */
+    [[nodiscard]] inline bool isAsync(void) const noexcept { return _ring >= 0; }
+
+    /** @brief Get the number of queued requests that are not submitted yet */
+    [[nodiscard]] inline std::uint32_t queuedCount(void) const noexcept { return _queued.size(); }
+
+    /** @brief Get the number of submitted requests that are not completed yet */
+    [[nodiscard]] inline std::uint32_t inFlightCount(void) const noexcept { return _inFlight; }
+
+    /** @brief Check if the engine has no queued, in-flight or unread completion */
+    [[nodiscard]] inline bool idle(void) const noexcept
+        { return _queued.empty() && !_inFlight && _completions.empty(); }
+
+
+    /** @brief Queue a read of 'file' into range
+     *  @note The range must stay valid until completion, a pooled handle is leased until then */
+    void queueRead(File &file, std::uint8_t * const from, std::uint8_t * const to,
+            const std::size_t offset, const std::uint64_t userData = 0u) noexcept;
+
+    /** @brief Queue a write of range into 'file'
+     *  @note The range must stay valid until completion, a pooled handle is leased until then */
+    void queueWrite(File &file, const std::uint8_t * const from, const std::uint8_t * const to,
+            const std::size_t offset, const std::uint64_t userData = 0u) noexcept;
+
+    /** @brief Submit queued requests using a single system call
+     *  @note Requests that do not fit into the queue depth stay queued until the next submit
+     *  @return The number of submitted requests */
+    std::uint32_t submit(void) noexcept;
+
+
+    /** @brief Retreive available completions without blocking, then submit remaining queued requests
+     *  @return The number of completions stored into range */
+    [[nodiscard]] std::uint32_t poll(Completion * const from, Completion * const to) noexcept;
+
+    /** @brief Retreive available completions, blocking until at least one is available if any request is pending
+     *  @return The number of completions stored into range */
+    [[nodiscard]] std::uint32_t wait(Completion * const from, Completion * const to) noexcept;
+
+    /** @brief Call 'callback' for each available completion without blocking
+     *  @return The number of processed completions */
+    template<typename Callback>
+        requires std::invocable<Callback, const kF::IO::AsyncEngine::Completion &>
+    std::uint32_t dispatch(Callback &&callback) noexcept;
+
+    /** @brief Call 'callback' for each completion until every request is completed
+     *  @return The number of processed completions */
+    template<typename Callback>
+        requires std::invocable<Callback, const kF::IO::AsyncEngine::Completion &>
+    std::uint32_t dispatchAll(Callback &&callback) noexcept;
+
+
+private:
+    /** @brief Pending request, the lease keeps a pooled handle opened until completion */
+    struct Request
+    {
+        HandlePool::Lease lease {};
+        std::uint8_t *data {};
+        std::uint32_t size {};
+        Operation operation {};
+        std::size_t offset {};
+        std::uint64_t userData {};
+    };
+
+    /** @brief Request owned by the kernel, indexed by the user data of its ring entry */
+    struct Submission
+    {
+        HandlePool::Lease lease {};
+        std::uint64_t userData {};
+    };
+
+    /** @brief Memory mapped ring state */
+    struct Ring
+    {
+        std::uint8_t *submissionMapping {};
+        std::size_t submissionMappingSize {};
+        std::uint8_t *completionMapping {};
+        std::size_t completionMappingSize {};
+        void *entries {};
+        std::size_t entriesSize {};
+        std::uint32_t *submissionTail {};
+        std::uint32_t *submissionArray {};
+        std::uint32_t submissionMask {};
+        std::uint32_t *completionHead {};
+        std::uint32_t *completionTail {};
+        std::uint32_t completionMask {};
+        void *completions {};
+    };
+
+
+    /** @brief Try to create the io_uring instance */
+    void createRing(const std::uint32_t queueDepth) noexcept;
+
+    /** @brief Destroy the io_uring instance */
+    void destroyRing(void) noexcept;
+
+    /** @brief Move kernel completions into the completion queue */
+    void reap(void) noexcept;
+
+    /** @brief Block until at least one completion is available */
+    void waitCompletion(void) noexcept;
+
+    /** @brief Execute a request synchronously */
+    [[nodiscard]] Completion execute(const Request &request) const noexcept;
+
+    /** @brief Pop completions into range */
+    [[nodiscard]] std::uint32_t popCompletions(Completion * const from, Completion * const to) noexcept;
+
+
+    int _ring { -1 };
+    std::uint32_t _queueDepth {};
+    std::uint32_t _inFlight {};
+    Ring _state {};
+    Core::Vector<Request, IOAllocator> _queued {};
+    Core::Vector<Submission, IOAllocator> _submissions {};
+    Core::Vector<std::uint32_t, IOAllocator> _freeSubmissions {};
+    Core::Vector<Completion, IOAllocator> _completions {};
+};
+
+#include "AsyncEngine.ipp"
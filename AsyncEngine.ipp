@@ -0,0 +1,43 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO AsyncEngine
+ */
+
+#pragma once
+
+#include "AsyncEngine.hpp"
+
+template<typename Callback>
+    requires std::invocable<Callback, const kF::IO::AsyncEngine::Completion &>
+inline std::uint32_t kF::IO::AsyncEngine::dispatch(Callback &&callback) noexcept
+{
+    constexpr std::uint32_t BatchSize = 32;
+
+    Completion completions[BatchSize];
+    std::uint32_t total {};
+    while (true) {
+        const auto count = poll(std::begin(completions), std::end(completions));
+        for (auto i = 0u; i != count; ++i)
+            callback(completions[i]);
+        total += count;
+        if (count != BatchSize)
+            return total;
+    }
+}
+
+template<typename Callback>
+    requires std::invocable<Callback, const kF::IO::AsyncEngine::Completion &>
+inline std::uint32_t kF::IO::AsyncEngine::dispatchAll(Callback &&callback) noexcept
+{
+    constexpr std::uint32_t BatchSize = 32;
+
+    Completion completions[BatchSize];
+    std::uint32_t total {};
+    while (!idle()) {
+        const auto count = wait(std::begin(completions), std::end(completions));
+        for (auto i = 0u; i != count; ++i)
+            callback(completions[i]);
+        total += count;
+    }
+    return total;
+}
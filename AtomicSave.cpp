@@ -0,0 +1,129 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO AtomicSave
+ */
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+
+#if defined(_WIN32)
+# include <process.h>
+#else
+# include <unistd.h>
+#endif
+
+#include "AtomicSave.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Make a temporary path next to 'path', unique across threads and processes */
+    [[nodiscard]] Core::SmallString<IO::IOAllocator> MakeTemporaryPath(const std::string_view &path) noexcept
+    {
+        static std::atomic<std::uint32_t> Counter {};
+
+#if defined(_WIN32)
+        const auto processId = ::_getpid();
+#else
+        const auto processId = ::getpid();
+#endif
+        std::string temporary(path);
+        temporary += '.';
+        temporary += std::to_string(processId);
+        temporary += '-';
+        temporary += std::to_string(Counter.fetch_add(1u, std::memory_order_relaxed));
+        temporary += ".tmp";
+        return Core::SmallString<IO::IOAllocator>(std::string_view(temporary));
+    }
+}
+
+bool IO::SaveAtomically(const std::string_view &path, const std::uint8_t * const from, const std::uint8_t * const to) noexcept
+{
+    GroupCommit group;
+    return group.save(path, from, to) && group.commit();
+}
+
+IO::GroupCommit::~GroupCommit(void) noexcept
+{
+    commit();
+}
+
+bool IO::GroupCommit::save(const std::string_view &path, const std::uint8_t * const from, const std::uint8_t * const to) noexcept
+{
+    if (const auto it = _pending.find([&path](const Pending &pending) { return pending.target.toView() == path; }); it != _pending.end()) {
+        it->file = File(it->file.path(), File::Mode::None);
+        static_cast<void>(it->file.remove());
+        _pending.erase(it);
+    }
+
+    File file(MakeTemporaryPath(path).toView(), File::Mode::WriteBinary);
+    if (!file.tryOpen()) [[unlikely]]
+        return false;
+    else if (!file.write(from, to, 0u)) [[unlikely]] {
+        static_cast<void>(file.remove());
+        return false;
+    }
+    // Data reaches the device while the next saves are written
+    Native::StartSync(file.nativeHandle());
+    _pending.push(Pending {
+        .file = std::move(file),
+        .target = Core::SmallString<IOAllocator>(path)
+    });
+    return true;
+}
+
+bool IO::GroupCommit::commit(void) noexcept
+{
+    bool success = true;
+
+    // Wait for the data of every temporary file at once, most of it is already written back by 'StartSync'
+    Core::Vector<Native::Handle, IOAllocator> handles {};
+    for (const auto &pending : _pending)
+        handles.push(pending.file.nativeHandle());
+    const bool synced = Native::SyncAll(handles.begin(), handles.end());
+
+    // On failure, sync each file again to find which saves must be dropped
+    for (auto it = _pending.begin(); it != _pending.end();) {
+        if (synced || it->file.sync(true)) [[likely]] {
+            it->file = File(it->file.path(), File::Mode::None); // Close the handle before renaming
+            ++it;
+        } else {
+            static_cast<void>(it->file.remove());
+            _pending.erase(it);
+            success = false;
+        }
+    }
+
+    // Replace targets, then make the renames durable once per directory
+    Core::Vector<std::string_view, IOAllocator> directories;
+    for (auto &pending : _pending) {
+        // A replaced file keeps its permissions instead of getting the default ones of the temporary file
+        std::error_code code;
+        if (const auto status = std::filesystem::status(std::filesystem::path(pending.target.toView()), code); std::filesystem::exists(status))
+            std::filesystem::permissions(std::filesystem::path(pending.file.path()), status.permissions(), code);
+        if (!Native::Rename(pending.file.path(), pending.target.toView())) [[unlikely]] {
+            static_cast<void>(pending.file.remove());
+            success = false;
+            continue;
+        }
+        const auto directory = Path::DirectoryOf(pending.target.toView());
+        if (directories.find(directory) == directories.end())
+            directories.push(directory);
+    }
+    for (const auto &directory : directories)
+        success &= Native::SyncDirectory(directory);
+
+    _pending.clear();
+    return success;
+}
+
+void IO::GroupCommit::discard(void) noexcept
+{
+    for (auto &pending : _pending) {
+        pending.file = File(pending.file.path(), File::Mode::None);
+        static_cast<void>(pending.file.remove());
+    }
+    _pending.clear();
+}
@@ -0,0 +1,87 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO AtomicSave
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "File.hpp"
+
+namespace kF::IO
+{
+    class GroupCommit;
+
+    /** @brief Atomically and durably replace the file at 'path' with 'from, to'
+     *  @note Data is written to a temporary file of the same directory which is synced then renamed over 'path'
+     *  @return False on failure, in which case 'path' is left untouched */
+    [[nodiscard]] bool SaveAtomically(const std::string_view &path, const std::uint8_t * const from, const std::uint8_t * const to) noexcept;
+
+    /** @brief Atomically and durably replace the file at 'path' with the content of 'container' */
+    template<kF::IO::Internal::WritableContainer Container>
+    [[nodiscard]] inline bool SaveAtomically(const std::string_view &path, const Container &container) noexcept
+    {
+        const auto from = reinterpret_cast<const std::uint8_t *>(std::data(container));
+        return SaveAtomically(path, from, from + std::size(container));
+    }
+}
+
+/** @brief Batch of atomic saves sharing their synchronization cost
+ *
+ *  Each save is written to its temporary file right away and its write-back is started in the background.
+ *  'commit' then waits for all the data at once (a single sync per file system on Linux), renames every
+ *  temporary file over its target and syncs each parent directory a single time, whatever the number of files it holds.
+ *  @note Saving the same path twice before a commit only keeps the last save
+ *  @note This class is not thread-safe */
+class kF::IO::GroupCommit
+{
+public:
+    /** @brief Destructor, commits pending saves */
+    ~GroupCommit(void) noexcept;
+
+    /** @brief Default constructor */
+    GroupCommit(void) noexcept = default;
+
+    /** @brief Deleted copy constructor */
+    GroupCommit(const GroupCommit &other) noexcept = delete;
+
+    /** @brief Deleted copy assignment */
+    GroupCommit &operator=(const GroupCommit &other) noexcept = delete;
+
+
+    /** @brief Get the number of saves waiting for commit */
+    [[nodiscard]] inline std::uint32_t pendingCount(void) const noexcept { return _pending.size(); }
+
+
+    /** @brief Write 'from, to' into a temporary file which will replace 'path' on commit
+     *  @return False if the temporary file couldn't be written */
+    [[nodiscard]] bool save(const std::string_view &path, const std::uint8_t * const from, const std::uint8_t * const to) noexcept;
+
+    /** @brief Write 'container' into a temporary file which will replace 'path' on commit */
+    template<kF::IO::Internal::WritableContainer Container>
+    [[nodiscard]] inline bool save(const std::string_view &path, const Container &container) noexcept
+    {
+        const auto from = reinterpret_cast<const std::uint8_t *>(std::data(container));
+        return save(path, from, from + std::size(container));
+    }
+
+
+    /** @brief Make every pending save durable and replace their targets
+     *  @return False if any save failed, failed targets are left untouched */
+    bool commit(void) noexcept;
+
+    /** @brief Drop every pending save, targets are left untouched */
+    void discard(void) noexcept;
+
+
+private:
+    /** @brief A save waiting for commit */
+    struct Pending
+    {
+        File file {};
+        Core::SmallString<IOAllocator> target {};
+    };
+
+    Core::Vector<Pending, IOAllocator> _pending {};
+};
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Kube/Core/StaticSafeAllocator.hpp>
+#include <Kube/Core/Hash.hpp>
 
 namespace kF::IO
 {
@@ -22,4 +23,33 @@ namespace kF::IO
 
     /** @brief View of a resource */
     using ResourceView = Core::IteratorRange<const std::uint8_t *>;
+
+    /** @brief View of a mutable buffer */
+    using BufferView = Core::IteratorRange<std::uint8_t *>;
+
+
+    /** @brief Precomputed handle of a resource */
+    struct ResourceHandle
+    {
+        Core::HashedName environment {};
+        Core::HashedName path {};
+
+        /** @brief Comparison operator */
+        [[nodiscard]] constexpr bool operator==(const ResourceHandle &other) const noexcept = default;
+    };
+
+    /** @brief Make a resource handle from a full resource path (':/Environment/path'), usable at compile time
+     *  @note Returns an empty handle if 'path' is not a resource path */
+    [[nodiscard]] constexpr ResourceHandle MakeResourceHandle(const std::string_view &path) noexcept
+    {
+        if (!path.starts_with(ResourcePrefix))
+            return ResourceHandle {};
+        const auto to = path.find('/', EnvironmentBeginIndex);
+        if (to == std::string_view::npos)
+            return ResourceHandle { .environment = Core::Hash(path.substr(EnvironmentBeginIndex)) };
+        return ResourceHandle {
+            .environment = Core::Hash(path.substr(EnvironmentBeginIndex, to - EnvironmentBeginIndex)),
+            .path = Core::Hash(path.substr(to + 1))
+        };
+    }
 }
\ No newline at end of file
@@ -0,0 +1,371 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of File
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/IO/AtomicSave.hpp>
+#include <Kube/IO/BufferedWriter.hpp>
+#include <Kube/IO/ContentCache.hpp>
+#include <Kube/IO/Direct.hpp>
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/HandlePool.hpp>
+#include <Kube/IO/LogFile.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Temporary directory holding every fixture, removed with its content when the benchmarks exit */
+    struct FixtureDirectory
+    {
+        std::filesystem::path path { std::filesystem::temp_directory_path() / "IOBenchmarks_File" };
+
+        FixtureDirectory(void) { std::filesystem::create_directories(path); }
+        ~FixtureDirectory(void) { std::error_code error; std::filesystem::remove_all(path, error); }
+    };
+
+    /** @brief Get the path of a temporary fixture */
+    std::string FixturePath(const std::string_view &name)
+    {
+        static const FixtureDirectory Directory;
+        return (Directory.path / name).string();
+    }
+
+    /** @brief Create (once) a fixture of 'size' bytes and get its path */
+    std::string MakeFixture(const std::size_t size)
+    {
+        const auto path = FixturePath("Fixture" + std::to_string(size) + ".bin");
+        if (!std::filesystem::exists(path) || std::filesystem::file_size(path) != size) {
+            std::string data(size, '\0');
+            for (auto i = 0ul; i != size; ++i)
+                data[i] = static_cast<char>(i * 31);
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << data;
+        }
+        return path;
+    }
+}
+
+static void IO_File_Construct(benchmark::State &state)
+{
+    const auto path = FixturePath("Construct.bin");
+    for (auto _ : state) {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        benchmark::DoNotOptimize(file);
+    }
+}
+BENCHMARK(IO_File_Construct);
+
+static void IO_File_ConstructResource(benchmark::State &state)
+{
+    for (auto _ : state) {
+        IO::File file(":/Environment/Directory/Resource.bin");
+        benchmark::DoNotOptimize(file);
+    }
+}
+BENCHMARK(IO_File_ConstructResource);
+
+static void IO_File_PathAccessors(benchmark::State &state)
+{
+    const IO::File file("/usr/share/kube/assets/textures/environment/skybox_front.png");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(file.filenameWithExtension());
+        benchmark::DoNotOptimize(file.filename());
+        benchmark::DoNotOptimize(file.directoryPath());
+    }
+}
+BENCHMARK(IO_File_PathAccessors);
+
+static void IO_File_Read(benchmark::State &state)
+{
+    constexpr std::size_t FileSize = 16 * 1024 * 1024;
+    const auto chunkSize = static_cast<std::size_t>(state.range(0));
+    IO::File file(MakeFixture(FileSize), IO::File::Mode::ReadBinary);
+    std::string buffer(chunkSize, '\0');
+    const auto from = reinterpret_cast<std::uint8_t *>(buffer.data());
+    std::size_t offset {};
+    for (auto _ : state) {
+        if (offset + chunkSize > FileSize)
+            offset = 0;
+        benchmark::DoNotOptimize(file.read(from, from + chunkSize, offset));
+        offset += chunkSize;
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(chunkSize));
+}
+BENCHMARK(IO_File_Read)->Arg(64)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void IO_File_ReadDirect(benchmark::State &state)
+{
+    constexpr std::size_t FileSize = 16 * 1024 * 1024;
+    const auto chunkSize = static_cast<std::size_t>(state.range(0));
+    IO::File file(MakeFixture(FileSize), IO::File::Mode::ReadDirect);
+    const auto from = reinterpret_cast<std::uint8_t *>(IO::Direct::Allocator::Allocate(chunkSize, IO::Direct::Alignment));
+    std::size_t offset {};
+    for (auto _ : state) {
+        if (offset + chunkSize > FileSize)
+            offset = 0;
+        benchmark::DoNotOptimize(file.read(from, from + chunkSize, offset));
+        offset += chunkSize;
+    }
+    IO::Direct::Allocator::Deallocate(from, chunkSize, IO::Direct::Alignment);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(chunkSize));
+}
+BENCHMARK(IO_File_ReadDirect)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void IO_File_ReadRandomCold(benchmark::State &state)
+{
+    constexpr std::size_t FileSize = 64 * 1024 * 1024;
+    constexpr std::size_t ChunkSize = 4 * 1024;
+    IO::File file(MakeFixture(FileSize), IO::File::Mode::ReadBinary);
+    file.advise(static_cast<IO::File::AccessHint>(state.range(0)));
+    std::uint8_t buffer[ChunkSize];
+    std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (auto _ : state) {
+        state.PauseTiming();
+        file.advise(IO::File::AccessHint::DontNeed);
+        state.ResumeTiming();
+        for (auto i = 0u; i != 64u; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            const auto offset = (seed >> 33) % (FileSize / ChunkSize) * ChunkSize;
+            benchmark::DoNotOptimize(file.read(std::begin(buffer), std::end(buffer), offset));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(64 * ChunkSize));
+}
+BENCHMARK(IO_File_ReadRandomCold)
+    ->Arg(static_cast<std::int64_t>(IO::File::AccessHint::Normal))
+    ->Arg(static_cast<std::int64_t>(IO::File::AccessHint::Random));
+
+static void IO_File_ReadAll(benchmark::State &state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    IO::File file(MakeFixture(size), IO::File::Mode::ReadBinary);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(file.readAll<std::string>());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_File_ReadAll)->Arg(4 * 1024)->Arg(1024 * 1024)->Arg(16 * 1024 * 1024);
+
+static void IO_File_ReadAllReopened(benchmark::State &state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto path = MakeFixture(size);
+    for (auto _ : state) {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        benchmark::DoNotOptimize(file.readAll<std::string>());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_File_ReadAllReopened)->Arg(4 * 1024)->Arg(64 * 1024);
+
+static void IO_ContentCache_Load(benchmark::State &state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto path = MakeFixture(size);
+    IO::ContentCache cache;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cache.load(path));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_ContentCache_Load)->Arg(4 * 1024)->Arg(64 * 1024);
+
+static void IO_File_ReadReopened(benchmark::State &state)
+{
+    const auto path = MakeFixture(4 * 1024);
+    std::uint8_t buffer[64] {};
+    for (auto _ : state) {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        benchmark::DoNotOptimize(file.read(std::begin(buffer), std::end(buffer), 0));
+    }
+}
+BENCHMARK(IO_File_ReadReopened);
+
+static void IO_File_ReadPooled(benchmark::State &state)
+{
+    const auto path = MakeFixture(4 * 1024);
+    IO::HandlePool pool;
+    std::uint8_t buffer[64] {};
+    for (auto _ : state) {
+        IO::File file(path, IO::File::Mode::ReadBinary, pool);
+        benchmark::DoNotOptimize(file.read(std::begin(buffer), std::end(buffer), 0));
+    }
+}
+BENCHMARK(IO_File_ReadPooled);
+
+static void IO_File_Write(benchmark::State &state)
+{
+    constexpr std::size_t FileLimit = 64 * 1024 * 1024;
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const std::string payload(size, 'K');
+    const auto from = reinterpret_cast<const std::uint8_t *>(payload.data());
+    IO::File file(FixturePath("Write.bin"), IO::File::Mode::WriteBinary);
+    for (auto _ : state) {
+        if (file.offset() + size > FileLimit)
+            file.setOffset(0);
+        benchmark::DoNotOptimize(file.write(from, from + size));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_File_Write)->Arg(16)->Arg(4 * 1024)->Arg(1024 * 1024);
+
+static void IO_File_WriteVectored(benchmark::State &state)
+{
+    // Header, payload and footer written with one call per piece, concatenated, or gathered by a single vectored call
+    const auto method = state.range(0);
+    IO::File file(FixturePath("WriteVectored.bin"), IO::File::Mode::WriteBinary);
+    const std::string header(16, 'h'), payload(4 * 1024, 'p'), footer(16, 'f');
+    const auto View = [](const std::string &data) {
+        const auto from = reinterpret_cast<const std::uint8_t *>(data.data());
+        return IO::ResourceView { .from = from, .to = from + data.size() };
+    };
+    const IO::ResourceView pieces[] { View(header), View(payload), View(footer) };
+    std::string concatenated;
+    for (auto _ : state) {
+        if (method == 0) {
+            auto offset = 0ul;
+            for (const auto &piece : pieces) {
+                benchmark::DoNotOptimize(file.write(piece.from, piece.to, offset));
+                offset += piece.size();
+            }
+        } else if (method == 1) {
+            concatenated.clear();
+            concatenated.append(header).append(payload).append(footer);
+            benchmark::DoNotOptimize(file.writeAll(concatenated));
+            file.setOffset(0);
+        } else
+            benchmark::DoNotOptimize(file.writeVectored(Core::IteratorRange<const IO::ResourceView *> { .from = std::begin(pieces), .to = std::end(pieces) }, 0));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(header.size() + payload.size() + footer.size()));
+}
+BENCHMARK(IO_File_WriteVectored)->Arg(0)->Arg(1)->Arg(2);
+
+static void IO_LogFile_Append(benchmark::State &state)
+{
+    // 16 MiB of 256 bytes records written at a tracked offset, appended without reservation, or appended with extents reserved
+    const auto method = state.range(0);
+    constexpr auto RecordCount = 64 * 1024ul;
+    const auto path = FixturePath("Append.log");
+    const std::string record(255, 'r');
+    const auto from = reinterpret_cast<const std::uint8_t *>(record.data());
+    const auto to = from + record.size() + 1;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::filesystem::remove(path);
+        state.ResumeTiming();
+        if (method == 0) {
+            IO::File file(path, IO::File::Mode::WriteBinary);
+            for (auto i = 0ul; i != RecordCount; ++i)
+                benchmark::DoNotOptimize(file.write(from, to));
+        } else {
+            IO::LogFile log(path, method == 1 ? 0 : IO::LogFile::DefaultExtentSize);
+            for (auto i = 0ul; i != RecordCount; ++i)
+                benchmark::DoNotOptimize(log.append(from, to));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(RecordCount * (record.size() + 1)));
+}
+BENCHMARK(IO_LogFile_Append)->Arg(0)->Arg(1)->Arg(2);
+
+static void IO_File_WriteAll(benchmark::State &state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const std::string payload(size, 'K');
+    const auto path = FixturePath("WriteAll.bin");
+    for (auto _ : state) {
+        IO::File file(path, IO::File::Mode::WriteBinary);
+        benchmark::DoNotOptimize(file.writeAll(payload));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_File_WriteAll)->Arg(16)->Arg(1024 * 1024);
+
+static void IO_BufferedWriter_Write(benchmark::State &state)
+{
+    constexpr std::size_t FileLimit = 64 * 1024 * 1024;
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const std::string payload(size, 'K');
+    const auto from = reinterpret_cast<const std::uint8_t *>(payload.data());
+    IO::File file(FixturePath("BufferedWrite.bin"), IO::File::Mode::WriteBinary);
+    IO::BufferedWriter writer(file);
+    for (auto _ : state) {
+        if (writer.offset() + size > FileLimit)
+            benchmark::DoNotOptimize(writer.write(from, from + size, 0));
+        else
+            benchmark::DoNotOptimize(writer.write(from, from + size));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_BufferedWriter_Write)->Arg(4)->Arg(16)->Arg(4 * 1024);
+
+static void IO_File_Copy(benchmark::State &state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const IO::File file(MakeFixture(size));
+    const auto destination = FixturePath("Copy.bin");
+    for (auto _ : state) {
+        std::filesystem::remove(destination);
+        benchmark::DoNotOptimize(file.copy(destination));
+    }
+    std::filesystem::remove(destination);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+BENCHMARK(IO_File_Copy)->Arg(4 * 1024)->Arg(16 * 1024 * 1024);
+
+static void IO_File_Move(benchmark::State &state)
+{
+    const auto first = FixturePath("MoveFirst.bin");
+    const auto second = FixturePath("MoveSecond.bin");
+    std::ofstream(first) << "Kube";
+    const IO::File forward(first);
+    const IO::File backward(second);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(forward.move(second));
+        benchmark::DoNotOptimize(backward.move(first));
+    }
+    std::filesystem::remove(first);
+}
+BENCHMARK(IO_File_Move);
+
+static void IO_File_Remove(benchmark::State &state)
+{
+    const auto path = FixturePath("Remove.bin");
+    const IO::File file(path);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::ofstream(path) << "Kube";
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(file.remove());
+    }
+}
+BENCHMARK(IO_File_Remove);
+
+static void IO_SaveAtomically(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const std::string payload(256, 'K');
+    for (auto _ : state) {
+        for (auto i = 0ul; i != count; ++i)
+            benchmark::DoNotOptimize(IO::SaveAtomically(FixturePath("Save" + std::to_string(i) + ".bin"), payload));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+BENCHMARK(IO_SaveAtomically)->Arg(16)->Unit(benchmark::kMillisecond);
+
+static void IO_GroupCommit(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const std::string payload(256, 'K');
+    for (auto _ : state) {
+        IO::GroupCommit group;
+        for (auto i = 0ul; i != count; ++i)
+            benchmark::DoNotOptimize(group.save(FixturePath("Save" + std::to_string(i) + ".bin"), payload));
+        benchmark::DoNotOptimize(group.commit());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+BENCHMARK(IO_GroupCommit)->Arg(16)->Unit(benchmark::kMillisecond);
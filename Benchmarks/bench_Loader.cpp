@@ -0,0 +1,140 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of Loader
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/FileArena.hpp>
+#include <Kube/IO/Loader.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Temporary directory holding every fixture, removed with its content when the benchmarks exit */
+    struct FixtureDirectory
+    {
+        std::filesystem::path path { std::filesystem::temp_directory_path() / "IOBenchmarks_Loader" };
+
+        FixtureDirectory(void) { std::filesystem::create_directories(path); }
+        ~FixtureDirectory(void) { std::error_code error; std::filesystem::remove_all(path, error); }
+    };
+
+    /** @brief Get the path of a temporary fixture */
+    std::string FixturePath(const std::string_view &name)
+    {
+        static const FixtureDirectory Directory;
+        return (Directory.path / name).string();
+    }
+
+    constexpr std::size_t FileCount = 32;
+    constexpr std::size_t FileSize = 256 * 1024;
+
+    /** @brief Create (once) the fixtures loaded by the benchmarks and get their paths */
+    const std::vector<std::string> &GetFixtures(void)
+    {
+        static const std::vector<std::string> Fixtures = [] {
+            std::vector<std::string> paths;
+            const std::string data(FileSize, 'L');
+            for (auto i = 0u; i != FileCount; ++i) {
+                paths.push_back(FixturePath("Load" + std::to_string(i) + ".bin"));
+                std::ofstream(paths.back(), std::ios::binary | std::ios::trunc) << data;
+            }
+            return paths;
+        }();
+        return Fixtures;
+    }
+
+    constexpr std::size_t SmallFileCount = 1000;
+    constexpr std::size_t SmallFileSize = 512;
+
+    /** @brief Create (once) small fixtures such as config or script files and get their paths */
+    const std::vector<std::string> &GetSmallFixtures(void)
+    {
+        static const std::vector<std::string> Fixtures = [] {
+            std::vector<std::string> paths;
+            const std::string data(SmallFileSize, 'S');
+            for (auto i = 0u; i != SmallFileCount; ++i) {
+                paths.push_back(FixturePath("Small" + std::to_string(i) + ".txt"));
+                std::ofstream(paths.back(), std::ios::binary | std::ios::trunc) << data;
+            }
+            return paths;
+        }();
+        return Fixtures;
+    }
+}
+
+static void IO_Loader_ReadAllSequential(benchmark::State &state)
+{
+    const auto &paths = GetFixtures();
+    std::vector<std::uint8_t> destination;
+    for (auto _ : state) {
+        for (const auto &path : paths) {
+            IO::File file(path, IO::File::Mode::ReadBinary);
+            benchmark::DoNotOptimize(file.readAll(destination));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(FileCount * FileSize));
+}
+BENCHMARK(IO_Loader_ReadAllSequential);
+
+static void IO_Loader_Load(benchmark::State &state)
+{
+    const auto &paths = GetFixtures();
+    IO::Loader loader(static_cast<std::uint32_t>(state.range(0)));
+    std::vector<IO::LoadFuture> futures(paths.size());
+    // Destinations are preallocated like streaming pools would be, so page faults of fresh buffers aren't measured
+    std::vector<std::vector<std::uint8_t>> destinations(paths.size(), std::vector<std::uint8_t>(FileSize));
+    const auto allocator = [](const std::size_t, void * const userData) noexcept {
+        return reinterpret_cast<std::vector<std::uint8_t> *>(userData)->data();
+    };
+    for (auto _ : state) {
+        for (auto i = 0u; i != paths.size(); ++i) {
+            futures[i] = loader.load(IO::LoadRequest {
+                .path = paths[i],
+                .priority = static_cast<IO::LoadPriority>(i),
+                .allocator = allocator,
+                .userData = &destinations[i]
+            });
+        }
+        for (const auto &future : futures)
+            benchmark::DoNotOptimize(future.wait());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(FileCount * FileSize));
+}
+BENCHMARK(IO_Loader_Load)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+
+static void IO_File_ReadAllSmallFiles(benchmark::State &state)
+{
+    const auto &paths = GetSmallFixtures();
+    for (auto _ : state) {
+        std::vector<std::vector<std::uint8_t>> contents;
+        contents.reserve(paths.size());
+        for (const auto &path : paths) {
+            IO::File file(path, IO::File::Mode::ReadBinary);
+            contents.push_back(file.readAll<std::vector<std::uint8_t>>());
+        }
+        benchmark::DoNotOptimize(contents.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(SmallFileCount));
+}
+BENCHMARK(IO_File_ReadAllSmallFiles);
+
+static void IO_FileArena_LoadSmallFiles(benchmark::State &state)
+{
+    const auto &paths = GetSmallFixtures();
+    for (auto _ : state) {
+        IO::FileArena arena;
+        benchmark::DoNotOptimize(arena.load(paths));
+        benchmark::DoNotOptimize(arena.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(SmallFileCount));
+}
+BENCHMARK(IO_FileArena_LoadSmallFiles);
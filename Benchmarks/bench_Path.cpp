@@ -0,0 +1,63 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of Path
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/IO/Path.hpp>
+#include <Kube/IO/StandardPaths.hpp>
+
+using namespace kF;
+
+constexpr std::string_view AssetPath = "/usr/share/kube/assets/textures/environment/skybox_front.png";
+
+static void IO_Path_Construct(benchmark::State &state)
+{
+    for (auto _ : state) {
+        IO::Path path(AssetPath);
+        benchmark::DoNotOptimize(path);
+    }
+}
+BENCHMARK(IO_Path_Construct);
+
+static void IO_Path_Accessors(benchmark::State &state)
+{
+    const IO::Path path(AssetPath);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.filenameWithExtension());
+        benchmark::DoNotOptimize(path.filename());
+        benchmark::DoNotOptimize(path.extension());
+        benchmark::DoNotOptimize(path.directoryPath());
+    }
+}
+BENCHMARK(IO_Path_Accessors);
+
+static void IO_Path_Normalize(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(IO::Path::Normalize("/usr/share//kube/./assets/../assets/textures/skybox_front.png"));
+}
+BENCHMARK(IO_Path_Normalize);
+
+static void IO_Path_Join(benchmark::State &state)
+{
+    const IO::Path root("/usr/share/kube/assets");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(root / "textures/environment/skybox_front.png");
+}
+BENCHMARK(IO_Path_Join);
+
+static void IO_StandardPaths_GetCachePath(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(IO::GetCachePath<std::string_view>());
+}
+BENCHMARK(IO_StandardPaths_GetCachePath);
+
+static void IO_StandardPaths_GetExecutableDirectory(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(IO::GetExecutableDirectory<std::string_view>());
+}
+BENCHMARK(IO_StandardPaths_GetExecutableDirectory);
@@ -0,0 +1,136 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of ResourceManager
+ */
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/IO/ResourceManager.hpp>
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/Pack.hpp>
+
+using namespace kF;
+
+KF_DECLARE_RESOURCE_ENVIRONMENT(IOBenchmarks);
+
+constexpr std::string_view ResourcePath = ":/IOBenchmarks/FileTest01.txt";
+constexpr std::string_view ResourceRelativePath = "FileTest01.txt";
+
+static void IO_ResourceManager_QueryResourcePath(benchmark::State &state)
+{
+    IO::ResourceManager manager;
+    const auto environment = Core::Hash("IOBenchmarks");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(manager.queryResource(environment, ResourceRelativePath));
+}
+BENCHMARK(IO_ResourceManager_QueryResourcePath);
+
+static void IO_ResourceManager_QueryResourceHandle(benchmark::State &state)
+{
+    constexpr auto Handle = IO::MakeResourceHandle(ResourcePath);
+    IO::ResourceManager manager;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(manager.queryResource(Handle));
+}
+BENCHMARK(IO_ResourceManager_QueryResourceHandle);
+
+static void IO_ResourceManager_QueryMissing(benchmark::State &state)
+{
+    constexpr auto Handle = IO::MakeResourceHandle(":/IOBenchmarks/Missing.txt");
+    IO::ResourceManager manager;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(manager.queryResource(Handle));
+}
+BENCHMARK(IO_ResourceManager_QueryMissing);
+
+static std::optional<IO::ResourceManager> SharedManager {};
+
+static void IO_ResourceManager_QueryResourceConcurrent(benchmark::State &state)
+{
+    constexpr auto Handle = IO::MakeResourceHandle(ResourcePath);
+    if (state.thread_index() == 0)
+        SharedManager.emplace();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(SharedManager->queryResource(Handle));
+    if (state.thread_index() == 0)
+        SharedManager.reset();
+}
+BENCHMARK(IO_ResourceManager_QueryResourceConcurrent)->ThreadRange(1, 8)->UseRealTime();
+
+static void IO_File_ReadResource(benchmark::State &state)
+{
+    IO::ResourceManager manager;
+    IO::File file(ResourcePath, IO::File::Mode::Read);
+    std::uint8_t buffer[4] {};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(file.read(std::begin(buffer), std::end(buffer), 0));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(sizeof(buffer)));
+}
+BENCHMARK(IO_File_ReadResource);
+
+static void IO_File_ReadAllResource(benchmark::State &state)
+{
+    IO::ResourceManager manager;
+    IO::File file(ResourcePath, IO::File::Mode::Read);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(file.readAll<std::string>());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(file.fileSize()));
+}
+BENCHMARK(IO_File_ReadAllResource);
+
+static void IO_ResourceManager_QueryPack(benchmark::State &state)
+{
+    const auto count = static_cast<std::uint32_t>(state.range(0));
+    const auto path = (std::filesystem::temp_directory_path() / ("IOBenchmarks_Pack" + std::to_string(count) + ".kfp")).string();
+    const std::uint8_t data[64] {};
+    IO::Pack::Builder builder;
+    for (auto i = 0u; i != count; ++i)
+        builder.add("Directory/Resource" + std::to_string(i), IO::ResourceView { .from = std::begin(data), .to = std::end(data) });
+    if (!builder.write(path)) {
+        state.SkipWithError("Couldn't write pack");
+        return;
+    }
+
+    IO::ResourceManager manager;
+    if (!manager.mountPack(Core::Hash("Pack"), path)) {
+        state.SkipWithError("Couldn't mount pack");
+        return;
+    }
+    Core::Vector<IO::ResourceHandle> handles;
+    for (auto i = 0u; i != count; ++i)
+        handles.push(IO::MakeResourceHandle(":/Pack/Directory/Resource" + std::to_string(i)));
+    std::uint32_t index {};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.queryResource(handles[index]));
+        index = (index + 1u) % count;
+    }
+    static_cast<void>(manager.unmountPack(Core::Hash("Pack")));
+    std::filesystem::remove(path);
+}
+BENCHMARK(IO_ResourceManager_QueryPack)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void IO_ResourceManager_MountPack(benchmark::State &state)
+{
+    const auto count = static_cast<std::uint32_t>(state.range(0));
+    const auto path = (std::filesystem::temp_directory_path() / ("IOBenchmarks_Mount" + std::to_string(count) + ".kfp")).string();
+    const std::uint8_t data[64] {};
+    IO::Pack::Builder builder;
+    for (auto i = 0u; i != count; ++i)
+        builder.add("Resource" + std::to_string(i), IO::ResourceView { .from = std::begin(data), .to = std::end(data) });
+    if (!builder.write(path)) {
+        state.SkipWithError("Couldn't write pack");
+        return;
+    }
+
+    IO::ResourceManager manager;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.mountPack(Core::Hash("Pack"), path));
+        benchmark::DoNotOptimize(manager.unmountPack(Core::Hash("Pack")));
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(IO_ResourceManager_MountPack)->Arg(16)->Arg(65536);
@@ -0,0 +1,84 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO BufferedWriter
+ */
+
+#include <Kube/Core/Abort.hpp>
+
+#include "BufferedWriter.hpp"
+
+using namespace kF;
+
+IO::BufferedWriter::~BufferedWriter(void) noexcept
+{
+    flush();
+    IOAllocator::Deallocate(_data, _capacity, BlockSize);
+}
+
+IO::BufferedWriter::BufferedWriter(File &file, const std::size_t capacity) noexcept
+    : _file(&file)
+    , _data(reinterpret_cast<std::uint8_t *>(IOAllocator::Allocate(capacity, BlockSize)))
+    , _capacity(capacity)
+    , _bufferOffset(file.offset())
+{
+    kFEnsure(!file.isResource(), "IO::BufferedWriter: Cannot write into resource file");
+    kFEnsure(Core::HasFlags(file.mode(), File::Mode::Write), "IO::BufferedWriter: File not opened for writing");
+    kFEnsure(capacity, "IO::BufferedWriter: Capacity must be greater than zero");
+}
+
+bool IO::BufferedWriter::write(const std::uint8_t * const from, const std::uint8_t * const to, const std::size_t offset) noexcept
+{
+    if (offset == this->offset()) [[likely]]
+        return write(from, to);
+    const auto flushed = flush();
+    _bufferOffset = offset;
+    return write(from, to) & flushed;
+}
+
+bool IO::BufferedWriter::flush(void) noexcept
+{
+    if (!_size)
+        return true;
+    const auto success = _file->write(_data, _data + _size, _bufferOffset);
+    _bufferOffset += _size;
+    _size = 0;
+    return success;
+}
+
+bool IO::BufferedWriter::writeSlow(const std::uint8_t *from, std::size_t count) noexcept
+{
+    // Ranges as large as the buffer are written directly after pending data
+    if (count >= _capacity) {
+        const auto flushed = flush();
+        const auto success = _file->write(from, from + count, _bufferOffset);
+        _bufferOffset += count;
+        return success & flushed;
+    }
+
+    bool success = true;
+    while (count) {
+        const auto chunk = std::min(_capacity - _size, count);
+        std::copy(from, from + chunk, _data + _size);
+        _size += chunk;
+        from += chunk;
+        count -= chunk;
+        if (_size == _capacity)
+            success &= flushAligned();
+    }
+    return success;
+}
+
+bool IO::BufferedWriter::flushAligned(void) noexcept
+{
+    const auto alignedEnd = (_bufferOffset + _size) & ~(BlockSize - 1);
+    if (alignedEnd <= _bufferOffset)
+        return flush();
+
+    // Write every complete block and keep the unaligned tail for the next flush
+    const auto count = alignedEnd - _bufferOffset;
+    const auto success = _file->write(_data, _data + count, _bufferOffset);
+    std::copy(_data + count, _data + _size, _data);
+    _size -= count;
+    _bufferOffset = alignedEnd;
+    return success;
+}
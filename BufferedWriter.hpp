@@ -0,0 +1,93 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO BufferedWriter
+ */
+
+#pragma once
+
+#include "File.hpp"
+
+namespace kF::IO
+{
+    class BufferedWriter;
+}
+
+/** @brief Write-behind buffer over a File
+ *  @note Contiguous writes are coalesced into a single buffer which is flushed by blocks aligned on the file offset
+ *  @note The buffer is flushed when full, on 'flush' and at destruction */
+class kF::IO::BufferedWriter
+{
+public:
+    /** @brief Default buffer capacity */
+    static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+    /** @brief Size of a block, flushes end on a block boundary whenever possible */
+    static constexpr std::size_t BlockSize = 4096;
+
+
+    /** @brief Destructor, flushes remaining data */
+    ~BufferedWriter(void) noexcept;
+
+    /** @brief Constructor, starts writing at the current offset of 'file'
+     *  @note The file must outlive the writer */
+    BufferedWriter(File &file, const std::size_t capacity = DefaultCapacity) noexcept;
+
+    /** @brief Deleted copy constructor */
+    BufferedWriter(const BufferedWriter &other) noexcept = delete;
+
+    /** @brief Deleted copy assignment */
+    BufferedWriter &operator=(const BufferedWriter &other) noexcept = delete;
+
+
+    /** @brief Get underlying file */
+    [[nodiscard]] inline File &file(void) const noexcept { return *_file; }
+
+    /** @brief Get buffer capacity */
+    [[nodiscard]] inline std::size_t capacity(void) const noexcept { return _capacity; }
+
+    /** @brief Get the number of bytes not flushed yet */
+    [[nodiscard]] inline std::size_t bufferedSize(void) const noexcept { return _size; }
+
+    /** @brief Get the file offset of the next write */
+    [[nodiscard]] inline std::size_t offset(void) const noexcept { return _bufferOffset + _size; }
+
+
+    /** @brief Write data range after the last write
+     *  @return False if a flush failed */
+    [[nodiscard]] inline bool write(const std::uint8_t * const from, const std::uint8_t * const to) noexcept;
+
+    /** @brief Write data range at 'offset', pending data is flushed if 'offset' is not contiguous
+     *  @return False if a flush failed */
+    [[nodiscard]] bool write(const std::uint8_t * const from, const std::uint8_t * const to, const std::size_t offset) noexcept;
+
+    /** @brief Write a container after the last write */
+    template<kF::IO::Internal::WritableContainer Container>
+    [[nodiscard]] inline bool writeAll(const Container &container) noexcept;
+
+    /** @brief Write a trivially copyable value after the last write */
+    template<typename Type>
+        requires std::is_trivially_copyable_v<Type>
+    [[nodiscard]] inline bool writeValue(const Type &value) noexcept;
+
+
+    /** @brief Flush all pending data to the file
+     *  @return False if the write failed */
+    bool flush(void) noexcept;
+
+
+private:
+    /** @brief Write path when the buffer cannot hold the range */
+    [[nodiscard]] bool writeSlow(const std::uint8_t *from, std::size_t count) noexcept;
+
+    /** @brief Flush pending data up to the last block boundary */
+    [[nodiscard]] bool flushAligned(void) noexcept;
+
+
+    File *_file {};
+    std::uint8_t *_data {};
+    std::size_t _capacity {};
+    std::size_t _size {};
+    std::size_t _bufferOffset {};
+};
+
+#include "BufferedWriter.ipp"
@@ -0,0 +1,35 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO BufferedWriter
+ */
+
+#pragma once
+
+#include "BufferedWriter.hpp"
+
+inline bool kF::IO::BufferedWriter::write(const std::uint8_t * const from, const std::uint8_t * const to) noexcept
+{
+    const auto count = static_cast<std::size_t>(std::distance(from, to));
+
+    if (_capacity - _size >= count) [[likely]] {
+        std::copy(from, to, _data + _size);
+        _size += count;
+        return true;
+    } else
+        return writeSlow(from, count);
+}
+
+template<kF::IO::Internal::WritableContainer Container>
+inline bool kF::IO::BufferedWriter::writeAll(const Container &container) noexcept
+{
+    const auto from = reinterpret_cast<const std::uint8_t *>(&*std::begin(container));
+    return write(from, from + container.size());
+}
+
+template<typename Type>
+    requires std::is_trivially_copyable_v<Type>
+inline bool kF::IO::BufferedWriter::writeValue(const Type &value) noexcept
+{
+    const auto from = reinterpret_cast<const std::uint8_t *>(&value);
+    return write(from, from + sizeof(Type));
+}
@@ -0,0 +1,251 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Compression
+ */
+
+#include <cstring>
+
+#include "Compression.hpp"
+
+using namespace kF;
+
+namespace
+{
+    constexpr std::size_t MinMatch = 4;
+    constexpr std::size_t LastLiterals = 5;
+    constexpr std::size_t MatchFindLimit = 12;
+    constexpr std::size_t MaxOffset = 65535;
+    constexpr std::uint32_t HashLog = 12;
+
+    template<typename Type>
+    [[nodiscard]] inline Type Load(const std::uint8_t * const data) noexcept
+    {
+        Type value;
+        std::memcpy(&value, data, sizeof(Type));
+        return value;
+    }
+
+    template<typename Type>
+    inline void Store(std::uint8_t * const data, const Type value) noexcept
+        { std::memcpy(data, &value, sizeof(Type)); }
+
+    [[nodiscard]] inline std::uint32_t HashSequence(const std::uint32_t sequence) noexcept
+        { return (sequence * 2654435761u) >> (32 - HashLog); }
+
+    /** @brief Write an extended length (sequence of 255 terminated by a smaller byte) */
+    [[nodiscard]] inline bool WriteLength(std::uint8_t *&output, const std::uint8_t * const end, std::size_t length) noexcept
+    {
+        for (; length >= 255; length -= 255) {
+            if (output == end) [[unlikely]]
+                return false;
+            *output++ = 255;
+        }
+        if (output == end) [[unlikely]]
+            return false;
+        *output++ = static_cast<std::uint8_t>(length);
+        return true;
+    }
+
+    /** @brief Read an extended length */
+    [[nodiscard]] inline bool ReadLength(const std::uint8_t *&input, const std::uint8_t * const end, std::size_t &length) noexcept
+    {
+        std::uint8_t byte;
+        do {
+            if (input == end) [[unlikely]]
+                return false;
+            byte = *input++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    /** @brief Write a sequence of literals followed by an optional match */
+    [[nodiscard]] bool WriteSequence(std::uint8_t *&output, const std::uint8_t * const end,
+            const std::uint8_t * const literals, const std::size_t literalCount,
+            const std::size_t offset, const std::size_t matchLength) noexcept
+    {
+        if (output == end) [[unlikely]]
+            return false;
+        auto &token = *output++;
+        token = static_cast<std::uint8_t>(std::min<std::size_t>(literalCount, 15) << 4);
+        if (literalCount >= 15 && !WriteLength(output, end, literalCount - 15)) [[unlikely]]
+            return false;
+        if (static_cast<std::size_t>(end - output) < literalCount) [[unlikely]]
+            return false;
+        output = std::copy(literals, literals + literalCount, output);
+        if (!matchLength)
+            return true;
+        if (end - output < 2) [[unlikely]]
+            return false;
+        Store(output, static_cast<std::uint16_t>(offset));
+        output += 2;
+        const auto length = matchLength - MinMatch;
+        token |= static_cast<std::uint8_t>(std::min<std::size_t>(length, 15));
+        return length < 15 || WriteLength(output, end, length - 15);
+    }
+
+    /** @brief Get the offset table of a container */
+    [[nodiscard]] inline const std::uint8_t *BlockOffsets(const IO::ResourceView &container) noexcept
+        { return container.begin() + sizeof(IO::Compression::Header); }
+}
+
+std::size_t IO::Compression::CompressBlock(const std::uint8_t * const from, const std::size_t size,
+        std::uint8_t * const output, const std::size_t capacity) noexcept
+{
+    std::uint32_t table[1 << HashLog] {};
+    auto out = output;
+    const auto outEnd = output + capacity;
+    std::size_t anchor {};
+
+    if (size > MatchFindLimit) {
+        const auto limit = size - MatchFindLimit;
+        const auto matchLimit = size - LastLiterals;
+        for (std::size_t index = 0; index < limit;) {
+            const auto sequence = Load<std::uint32_t>(from + index);
+            auto &slot = table[HashSequence(sequence)];
+            const auto reference = static_cast<std::size_t>(slot);
+            slot = static_cast<std::uint32_t>(index + 1);
+            if (!reference || index + 1 - reference > MaxOffset || Load<std::uint32_t>(from + reference - 1) != sequence) {
+                ++index;
+                continue;
+            }
+            auto length = MinMatch;
+            while (index + length < matchLimit && from[reference - 1 + length] == from[index + length])
+                ++length;
+            if (!WriteSequence(out, outEnd, from + anchor, index - anchor, index + 1 - reference, length)) [[unlikely]]
+                return 0u;
+            index += length;
+            anchor = index;
+        }
+    }
+    if (!WriteSequence(out, outEnd, from + anchor, size - anchor, 0u, 0u)) [[unlikely]]
+        return 0u;
+    return static_cast<std::size_t>(out - output);
+}
+
+bool IO::Compression::DecompressBlock(const std::uint8_t * const from, const std::size_t size,
+        std::uint8_t * const output, const std::size_t outputSize) noexcept
+{
+    auto in = from;
+    const auto inEnd = from + size;
+    std::size_t out {};
+
+    while (in != inEnd) {
+        const auto token = *in++;
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !ReadLength(in, inEnd, literals)) [[unlikely]]
+            return false;
+        if (static_cast<std::size_t>(inEnd - in) < literals || outputSize - out < literals) [[unlikely]]
+            return false;
+        std::copy(in, in + literals, output + out);
+        in += literals;
+        out += literals;
+        if (in == inEnd) // Last literals
+            break;
+        if (inEnd - in < 2) [[unlikely]]
+            return false;
+        const auto offset = static_cast<std::size_t>(Load<std::uint16_t>(in));
+        in += 2;
+        std::size_t length = token & 15u;
+        if (length == 15 && !ReadLength(in, inEnd, length)) [[unlikely]]
+            return false;
+        length += MinMatch;
+        if (!offset || offset > out || outputSize - out < length) [[unlikely]]
+            return false;
+        // Matches may overlap their own output, copy byte per byte
+        for (const auto end = out + length; out != end; ++out)
+            output[out] = output[out - offset];
+    }
+    return out == outputSize;
+}
+
+void IO::Compression::Compress(const ResourceView &input, Core::Vector<std::uint8_t, IOAllocator, std::size_t> &output,
+        const std::uint32_t blockSize) noexcept
+{
+    const auto blockCount = static_cast<std::uint32_t>((input.size() + blockSize - 1) / blockSize);
+    const auto dataBegin = sizeof(Header) + (blockCount + 1) * sizeof(std::uint32_t);
+
+    output.resize(dataBegin);
+    Store(output.data(), Header {
+        .magic = Magic,
+        .blockSize = blockSize,
+        .size = input.size(),
+        .blockCount = blockCount
+    });
+
+    std::size_t dataSize {};
+    for (auto block = 0u; block != blockCount; ++block) {
+        const auto from = input.begin() + std::size_t(block) * blockSize;
+        const auto size = std::min<std::size_t>(blockSize, static_cast<std::size_t>(input.end() - from));
+        Store(output.data() + sizeof(Header) + block * sizeof(std::uint32_t), static_cast<std::uint32_t>(dataSize));
+        // A block that doesn't shrink is stored raw, its stored size equals its uncompressed size
+        output.resize(dataBegin + dataSize + size);
+        auto compressed = CompressBlock(from, size, output.data() + dataBegin + dataSize, size - 1);
+        if (!compressed) {
+            std::copy(from, from + size, output.data() + dataBegin + dataSize);
+            compressed = size;
+        }
+        dataSize += compressed;
+    }
+    Store(output.data() + sizeof(Header) + blockCount * sizeof(std::uint32_t), static_cast<std::uint32_t>(dataSize));
+    output.resize(dataBegin + dataSize);
+}
+
+bool IO::Compression::ParseHeader(const ResourceView &container, Header &header) noexcept
+{
+    if (container.size() < sizeof(Header))
+        return false;
+    header = Load<Header>(container.begin());
+    if (header.magic != Magic || !header.blockSize)
+        return false;
+    const auto tableSize = (std::size_t(header.blockCount) + 1) * sizeof(std::uint32_t);
+    if (container.size() < sizeof(Header) + tableSize
+            || (header.size + header.blockSize - 1) / header.blockSize != header.blockCount)
+        return false;
+    const auto dataSize = Load<std::uint32_t>(BlockOffsets(container) + header.blockCount * sizeof(std::uint32_t));
+    return container.size() == sizeof(Header) + tableSize + dataSize;
+}
+
+std::size_t IO::Compression::Read(const ResourceView &container, std::uint8_t * const from, std::uint8_t * const to,
+        const std::size_t offset, std::uint8_t * const scratch) noexcept
+{
+    Header header;
+    if (!ParseHeader(container, header) || offset >= header.size) [[unlikely]]
+        return 0u;
+
+    const auto count = std::min(static_cast<std::size_t>(std::distance(from, to)), static_cast<std::size_t>(header.size) - offset);
+    if (!count)
+        return 0u;
+    const auto offsets = BlockOffsets(container);
+    const auto data = offsets + (header.blockCount + 1) * sizeof(std::uint32_t);
+    const auto dataSize = static_cast<std::size_t>(std::distance(data, container.end()));
+    const auto lastBlock = (offset + count - 1) / header.blockSize;
+
+    for (auto block = offset / header.blockSize; block <= lastBlock; ++block) {
+        const auto blockBegin = block * header.blockSize;
+        const auto blockSize = std::min<std::size_t>(header.blockSize, header.size - blockBegin);
+        const auto storedBegin = Load<std::uint32_t>(offsets + block * sizeof(std::uint32_t));
+        const auto storedEnd = Load<std::uint32_t>(offsets + (block + 1) * sizeof(std::uint32_t));
+        // A corrupted block table must not make blocks point outside of the container
+        if (storedEnd < storedBegin || storedEnd > dataSize) [[unlikely]]
+            return 0u;
+        const auto storedSize = storedEnd - storedBegin;
+        const auto stored = data + storedBegin;
+
+        // Raw blocks are copied, fully covered blocks are decoded in place and partial ones through the scratch buffer
+        const auto copyBegin = std::max(offset, blockBegin) - blockBegin;
+        const auto copyEnd = std::min(offset + count, blockBegin + blockSize) - blockBegin;
+        const auto target = from + (blockBegin + copyBegin - offset);
+        if (storedSize == blockSize)
+            std::copy(stored + copyBegin, stored + copyEnd, target);
+        else if (!copyBegin && copyEnd == blockSize) {
+            if (!DecompressBlock(stored, storedSize, target, blockSize)) [[unlikely]]
+                return 0u;
+        } else {
+            if (!DecompressBlock(stored, storedSize, scratch, blockSize)) [[unlikely]]
+                return 0u;
+            std::copy(scratch + copyBegin, scratch + copyEnd, target);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,61 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Compression
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+/** @brief Block compression of resources
+ *
+ *  A compressed resource is a container made of a header, a table of block offsets and independent blocks.
+ *  Each block is compressed with a fast LZ77 codec (LZ4 block format) or stored raw when it doesn't shrink,
+ *  so any byte range can be decompressed by only decoding the blocks that cover it. */
+namespace kF::IO::Compression
+{
+    /** @brief Magic number of a compressed container ('KFZ1') */
+    constexpr std::uint32_t Magic = 0x315A464B;
+
+    /** @brief Default size of an uncompressed block */
+    constexpr std::uint32_t DefaultBlockSize = 64 * 1024;
+
+
+    /** @brief Header of a compressed container, followed by 'blockCount + 1' block offsets relative to the data section */
+    struct Header
+    {
+        std::uint32_t magic {};
+        std::uint32_t blockSize {};
+        std::uint64_t size {};
+        std::uint32_t blockCount {};
+        std::uint32_t reserved {};
+    };
+    static_assert(sizeof(Header) == 24, "IO::Compression::Header: Header must be packed");
+
+
+    /** @brief Compress a single block
+     *  @return The compressed size, 0 if the output capacity is too small */
+    [[nodiscard]] std::size_t CompressBlock(const std::uint8_t * const from, const std::size_t size,
+            std::uint8_t * const output, const std::size_t capacity) noexcept;
+
+    /** @brief Decompress a single block, the whole output must be filled
+     *  @return False if the block is corrupted */
+    [[nodiscard]] bool DecompressBlock(const std::uint8_t * const from, const std::size_t size,
+            std::uint8_t * const output, const std::size_t outputSize) noexcept;
+
+
+    /** @brief Compress 'input' into a container stored in 'output' */
+    void Compress(const ResourceView &input, Core::Vector<std::uint8_t, IOAllocator, std::size_t> &output,
+            const std::uint32_t blockSize = DefaultBlockSize) noexcept;
+
+    /** @brief Check if 'container' is a valid compressed container and retreive its header */
+    [[nodiscard]] bool ParseHeader(const ResourceView &container, Header &header) noexcept;
+
+    /** @brief Decompress a byte range of a container, only blocks covering the range are decoded
+     *  @param scratch Buffer of at least 'header.blockSize' bytes used for partially covered blocks
+     *  @return The number of bytes read, 0 if the container is corrupted */
+    [[nodiscard]] std::size_t Read(const ResourceView &container, std::uint8_t * const from, std::uint8_t * const to,
+            const std::size_t offset, std::uint8_t * const scratch) noexcept;
+}
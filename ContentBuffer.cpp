@@ -0,0 +1,31 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO ContentBuffer
+ */
+
+#include <new>
+
+#include "ContentBuffer.hpp"
+
+using namespace kF;
+
+IO::ContentBuffer IO::ContentBuffer::Allocate(const std::size_t size) noexcept
+{
+    const auto header = new (IOAllocator::Allocate(sizeof(Header) + size, alignof(Header))) Header {};
+    header->references.store(1u, std::memory_order_relaxed);
+    header->size = size;
+    header->capacity = size;
+    return ContentBuffer(header);
+}
+
+void IO::ContentBuffer::release(void) noexcept
+{
+    if (!_header)
+        return;
+    const auto header = std::exchange(_header, nullptr);
+    if (header->references.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        const auto capacity = header->capacity;
+        header->~Header();
+        IOAllocator::Deallocate(header, sizeof(Header) + capacity, alignof(Header));
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO ContentBuffer
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "Base.hpp"
+
+namespace kF::IO
+{
+    class ContentBuffer;
+    class ContentCache;
+    class ResourceManager;
+}
+
+/** @brief Shared read-only content, released once its last copy is destroyed */
+class kF::IO::ContentBuffer
+{
+public:
+    /** @brief Destructor */
+    inline ~ContentBuffer(void) noexcept { release(); }
+
+    /** @brief Default constructor */
+    ContentBuffer(void) noexcept = default;
+
+    /** @brief Copy constructor, shares the content */
+    inline ContentBuffer(const ContentBuffer &other) noexcept : _header(other._header) { acquire(); }
+
+    /** @brief Move constructor */
+    inline ContentBuffer(ContentBuffer &&other) noexcept : _header(std::exchange(other._header, nullptr)) {}
+
+    /** @brief Copy assignment, shares the content */
+    inline ContentBuffer &operator=(const ContentBuffer &other) noexcept
+    {
+        if (_header != other._header) {
+            release();
+            _header = other._header;
+            acquire();
+        }
+        return *this;
+    }
+
+    /** @brief Move assignment */
+    inline ContentBuffer &operator=(ContentBuffer &&other) noexcept
+    {
+        if (this != &other) {
+            release();
+            _header = std::exchange(other._header, nullptr);
+        }
+        return *this;
+    }
+
+
+    /** @brief Check if the buffer holds a content */
+    [[nodiscard]] inline explicit operator bool(void) const noexcept { return _header; }
+
+    /** @brief Get content data */
+    [[nodiscard]] inline const std::uint8_t *data(void) const noexcept
+        { return _header ? reinterpret_cast<const std::uint8_t *>(_header + 1) : nullptr; }
+
+    /** @brief Get content size */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _header ? _header->size : 0u; }
+
+    /** @brief Get a view over the content */
+    [[nodiscard]] inline ResourceView view(void) const noexcept { return ResourceView { .from = data(), .to = data() + size() }; }
+
+    /** @brief Get a view over the content as text */
+    [[nodiscard]] inline std::string_view toView(void) const noexcept
+        { return std::string_view(reinterpret_cast<const char *>(data()), size()); }
+
+    /** @brief Begin / end iterators */
+    [[nodiscard]] inline const std::uint8_t *begin(void) const noexcept { return data(); }
+    [[nodiscard]] inline const std::uint8_t *end(void) const noexcept { return data() + size(); }
+
+    /** @brief Get the number of copies sharing the content, including the cache one */
+    [[nodiscard]] inline std::uint32_t useCount(void) const noexcept
+        { return _header ? _header->references.load(std::memory_order_relaxed) : 0u; }
+
+
+    /** @brief Release the content */
+    void release(void) noexcept;
+
+private:
+    /** @brief Header preceding content data */
+    struct alignas(16) Header
+    {
+        std::atomic<std::uint32_t> references {};
+        std::size_t size {};
+        std::size_t capacity {};
+    };
+
+    /** @brief Allocate an uninitialized content of 'size' bytes */
+    [[nodiscard]] static ContentBuffer Allocate(const std::size_t size) noexcept;
+
+    /** @brief Construct a buffer owning a header */
+    inline explicit ContentBuffer(Header * const header) noexcept : _header(header) {}
+
+    /** @brief Get mutable content data, only before the content is shared */
+    [[nodiscard]] inline std::uint8_t *mutableData(void) const noexcept { return reinterpret_cast<std::uint8_t *>(_header + 1); }
+
+    /** @brief Take a reference on the content */
+    inline void acquire(void) noexcept { if (_header) _header->references.fetch_add(1, std::memory_order_relaxed); }
+
+    Header *_header {};
+
+    friend ContentCache;
+    friend ResourceManager;
+};
@@ -0,0 +1,506 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO ContentCache
+ */
+
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__linux__)
+# include <cerrno>
+# include <poll.h>
+# include <sys/eventfd.h>
+# include <sys/inotify.h>
+# include <unistd.h>
+#endif
+
+#include <Kube/Core/Abort.hpp>
+#include <Kube/Core/Hash.hpp>
+
+#include "ContentCache.hpp"
+#include "File.hpp"
+#include "Instrumentation.hpp"
+#include "Native.hpp"
+#include "ResourceManager.hpp"
+
+using namespace kF;
+
+std::atomic<IO::ContentCache *> IO::ContentCache::_Instance {};
+
+namespace
+{
+#if defined(__linux__)
+    /** @brief Changes of a watched directory which may invalidate its contents */
+    constexpr std::uint32_t WatchMask = IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+        | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+
+    /** @brief Get the file name of a normalized path */
+    [[nodiscard]] std::string_view FileNameOf(const std::string_view &path) noexcept
+    {
+        const auto separator = path.find_last_of('/');
+        return separator == std::string_view::npos ? path : path.substr(separator + 1);
+    }
+
+    /** @brief Get the directory of a normalized path */
+    [[nodiscard]] std::string_view DirectoryOf(const std::string_view &path) noexcept
+    {
+        const auto separator = path.find_last_of('/');
+        if (separator == std::string_view::npos)
+            return ".";
+        return separator ? path.substr(0, separator) : std::string_view("/");
+    }
+}
+
+IO::ContentCache::~ContentCache(void) noexcept
+{
+#if defined(__linux__)
+    if (_watcher.joinable()) {
+        const std::uint64_t value = 1u;
+        _notifications.store(Notifications::Stopped, std::memory_order_release);
+        _notifications.notify_one();
+        static_cast<void>(::write(_wakeup, &value, sizeof(value)));
+        _watcher.join();
+        ::close(_wakeup);
+    }
+#endif
+    clear();
+#if defined(__linux__)
+    if (_notifier >= 0)
+        ::close(_notifier);
+#endif
+    _Instance.store(nullptr, std::memory_order_release);
+}
+
+IO::ContentCache::ContentCache(const std::size_t budget) noexcept
+    : _budget(budget)
+{
+#if defined(__linux__)
+    _notifier = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_notifier >= 0) {
+        _wakeup = ::eventfd(0u, EFD_CLOEXEC);
+        if (_wakeup >= 0) [[likely]] {
+            _watcher = std::thread([this] { watchEvents(); });
+        } else {
+            // Contents fall back to stamp validation
+            ::close(_notifier);
+            _notifier = -1;
+        }
+    }
+#endif
+    ContentCache *expected {};
+    const auto initialized = _Instance.compare_exchange_strong(expected, this, std::memory_order_acq_rel);
+    kFEnsure(initialized, "IO::ContentCache: ContentCache is already initialized");
+}
+
+IO::ContentBuffer IO::ContentCache::load(const std::string_view &path) noexcept
+{
+    const bool resource = path.starts_with(ResourcePrefix);
+    std::string normalized;
+    std::string_view normalizedPath = path;
+    auto key = Core::Hash(path);
+    std::unique_lock<std::mutex> lock(_mutex);
+    processEvents();
+
+    // Lookups by the path as given cover the common case of already normalized paths
+    auto index = find(key, path);
+    if (index == NullEntry && !resource) {
+        normalized = std::filesystem::path(path).lexically_normal().generic_string();
+        if (normalized != path) {
+            normalizedPath = normalized;
+            key = Core::Hash(normalizedPath);
+            index = find(key, normalizedPath);
+        }
+    }
+    if (index != NullEntry) {
+        auto &entry = _entries[index];
+        Stamp stamp {};
+        if (entry.watch != NoWatch || (ReadStamp(entry.path.toView(), stamp) && stamp == entry.stamp)) [[likely]] {
+            ++_statistics.hits;
+            touch(index);
+            return entry.buffer;
+        }
+        ++_statistics.invalidations;
+        normalized = entry.path.toView();
+        normalizedPath = normalized;
+        erase(index);
+    }
+
+    // The directory is watched before reading so that any change made during the read is noticed
+    ++_statistics.misses;
+    const auto watch = resource ? Immutable : acquireWatch(DirectoryOf(normalizedPath));
+    const auto generation = watch >= 0 ? findWatch(watch)->generation : 0u;
+    lock.unlock();
+
+    Stamp stamp {};
+    ContentBuffer buffer;
+    if (watch != NoWatch || ReadStamp(normalizedPath, stamp))
+        buffer = ReadContent(normalizedPath, resource);
+
+    lock.lock();
+    processEvents();
+    const auto current = watch >= 0 ? findWatch(watch) : nullptr;
+    if (watch >= 0 && !current) [[unlikely]] // The directory was removed or moved during the read
+        return buffer;
+    if (!buffer || buffer.size() > _budget || (current && current->generation != generation)) {
+        if (current)
+            releaseWatch(watch);
+        return buffer;
+    }
+    if (const auto existing = find(key, normalizedPath); existing != NullEntry)
+        erase(existing);
+    evict(buffer.size());
+    insert(key, normalizedPath, buffer, stamp, watch);
+    return buffer;
+}
+
+void IO::ContentCache::invalidate(const std::string_view &path) noexcept
+{
+    const auto normalized = path.starts_with(ResourcePrefix)
+        ? std::string(path) : std::filesystem::path(path).lexically_normal().generic_string();
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (const auto index = find(Core::Hash(normalized), normalized); index != NullEntry)
+        erase(index);
+}
+
+void IO::ContentCache::clear(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    while (_leastRecent != NullEntry)
+        erase(_leastRecent);
+}
+
+std::size_t IO::ContentCache::budget(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _budget;
+}
+
+void IO::ContentCache::setBudget(const std::size_t budget) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _budget = budget;
+    evict(0u);
+}
+
+std::size_t IO::ContentCache::size(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _size;
+}
+
+std::uint32_t IO::ContentCache::count(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _count;
+}
+
+IO::ContentCache::Statistics IO::ContentCache::statistics(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _statistics;
+}
+
+void IO::ContentCache::resetStatistics(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _statistics = Statistics {};
+}
+
+bool IO::ContentCache::ReadStamp(const std::string_view &path, Stamp &stamp) noexcept
+{
+    std::error_code code {};
+    const std::filesystem::path filePath(path);
+    const auto modified = std::filesystem::last_write_time(filePath, code);
+    if (code)
+        return false;
+    const auto size = std::filesystem::file_size(filePath, code);
+    if (code)
+        return false;
+    stamp = Stamp { .size = size, .modified = static_cast<std::int64_t>(modified.time_since_epoch().count()) };
+    return true;
+}
+
+IO::ContentBuffer IO::ContentCache::ReadContent(const std::string_view &path, const bool resource) noexcept
+{
+    if (resource) {
+        if (!ResourceManager::IsInitialized())
+            return ContentBuffer();
+        const File file(path, File::Mode::Read);
+        if (!file.resourceExists())
+            return ContentBuffer();
+        auto buffer = ContentBuffer::Allocate(file.fileSize());
+        buffer._header->size = file.readAt(buffer.mutableData(), buffer.mutableData() + buffer.size(), 0);
+        return buffer;
+    }
+
+    Instrumentation::Scope scope(Instrumentation::Operation::Read, path);
+    const auto handle = Native::Open(path, true, false);
+    if (handle == Native::InvalidHandle)
+        return ContentBuffer();
+    auto buffer = ContentBuffer::Allocate(Native::Size(handle));
+    buffer._header->size = Native::ReadAt(handle, buffer.mutableData(), buffer.size(), 0);
+    Native::Close(handle);
+    scope.setBytes(buffer.size());
+    return buffer;
+}
+
+std::uint32_t IO::ContentCache::find(const Core::HashedName key, const std::string_view &path) const noexcept
+{
+    if (_buckets.empty())
+        return NullEntry;
+    auto index = _buckets[key & (_buckets.size() - 1u)];
+    while (index != NullEntry && (_entries[index].key != key || _entries[index].path.toView() != path)) [[unlikely]]
+        index = _entries[index].nextInBucket;
+    return index;
+}
+
+void IO::ContentCache::insert(const Core::HashedName key, const std::string_view &path, const ContentBuffer &buffer,
+        const Stamp &stamp, const std::int32_t watch) noexcept
+{
+    std::uint32_t index;
+    if (!_freeEntries.empty()) {
+        index = _freeEntries.back();
+        _freeEntries.pop();
+    } else {
+        index = _entries.size();
+        _entries.push(Entry {});
+        if (_entries.size() > _buckets.size())
+            rehash();
+    }
+    auto &bucket = _buckets[key & (_buckets.size() - 1u)];
+    auto &entry = _entries[index];
+    entry.path = path;
+    entry.buffer = buffer;
+    entry.stamp = stamp;
+    entry.key = key;
+    entry.name = Core::Hash(FileNameOf(path));
+    entry.watch = watch;
+    entry.nextInBucket = bucket;
+    entry.used = true;
+    bucket = index;
+    linkUse(index);
+    _size += buffer.size();
+    ++_count;
+}
+
+void IO::ContentCache::rehash(void) noexcept
+{
+    auto count = std::max(_buckets.size(), 16u);
+    while (count < _entries.size())
+        count *= 2u;
+    _buckets.clear();
+    _buckets.resize(count, NullEntry);
+    for (auto index = 0u; index != _entries.size(); ++index) {
+        auto &entry = _entries[index];
+        if (!entry.used)
+            continue;
+        auto &bucket = _buckets[entry.key & (count - 1u)];
+        entry.nextInBucket = bucket;
+        bucket = index;
+    }
+}
+
+void IO::ContentCache::touch(const std::uint32_t index) noexcept
+{
+    if (index == _mostRecent) [[likely]]
+        return;
+    unlinkUse(index);
+    linkUse(index);
+}
+
+void IO::ContentCache::linkUse(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    entry.previousUse = _mostRecent;
+    entry.nextUse = NullEntry;
+    if (_mostRecent != NullEntry)
+        _entries[_mostRecent].nextUse = index;
+    else
+        _leastRecent = index;
+    _mostRecent = index;
+}
+
+void IO::ContentCache::unlinkUse(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    if (entry.previousUse != NullEntry)
+        _entries[entry.previousUse].nextUse = entry.nextUse;
+    else
+        _leastRecent = entry.nextUse;
+    if (entry.nextUse != NullEntry)
+        _entries[entry.nextUse].previousUse = entry.previousUse;
+    else
+        _mostRecent = entry.previousUse;
+    entry.previousUse = NullEntry;
+    entry.nextUse = NullEntry;
+}
+
+void IO::ContentCache::watchEvents(void) noexcept
+{
+#if defined(__linux__)
+    while (true) {
+        pollfd descriptors[2] {
+            pollfd { .fd = _notifier, .events = POLLIN, .revents = 0 },
+            pollfd { .fd = _wakeup, .events = POLLIN, .revents = 0 }
+        };
+        if (::poll(descriptors, 2u, -1) < 0) [[unlikely]] {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        if (descriptors[1].revents)
+            return;
+        // Loaders read notifications under the cache lock, wait until they did before polling again
+        auto expected = Notifications::None;
+        if (!_notifications.compare_exchange_strong(expected, Notifications::Pending, std::memory_order_acq_rel))
+            return;
+        _notifications.wait(Notifications::Pending, std::memory_order_acquire);
+        if (_notifications.load(std::memory_order_acquire) == Notifications::Stopped)
+            return;
+    }
+#endif
+}
+
+void IO::ContentCache::processEvents(void) noexcept
+{
+#if defined(__linux__)
+    if (_notifications.load(std::memory_order_acquire) != Notifications::Pending) [[likely]]
+        return;
+    alignas(inotify_event) char events[4096];
+    while (true) {
+        const auto size = ::read(_notifier, events, sizeof(events));
+        if (size <= 0)
+            break;
+        for (auto it = events; it < events + size;) {
+            const auto &event = *reinterpret_cast<const inotify_event *>(it);
+            it += sizeof(inotify_event) + event.len;
+
+            // Changes were lost, no content can be trusted anymore
+            if (event.mask & IN_Q_OVERFLOW) {
+                for (auto &watch : _watches)
+                    ++watch.generation;
+                _statistics.invalidations += _count;
+                while (_leastRecent != NullEntry)
+                    erase(_leastRecent);
+                continue;
+            }
+            const auto watch = findWatch(event.wd);
+            if (!watch)
+                continue;
+            ++watch->generation;
+            if (event.mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                invalidateWatch(event.wd, event.mask & IN_IGNORED);
+                continue;
+            }
+            if (!event.len)
+                continue;
+            const std::string_view name(event.name);
+            const auto hash = Core::Hash(name);
+            for (auto index = 0u; index != _entries.size(); ++index) {
+                const auto &entry = _entries[index];
+                if (entry.used && entry.watch == event.wd && entry.name == hash && FileNameOf(entry.path.toView()) == name) {
+                    ++_statistics.invalidations;
+                    erase(index);
+                }
+            }
+        }
+    }
+    // Hand the notifier back to the watcher thread
+    auto expected = Notifications::Pending;
+    if (_notifications.compare_exchange_strong(expected, Notifications::None, std::memory_order_acq_rel))
+        _notifications.notify_one();
+#endif
+}
+
+std::int32_t IO::ContentCache::acquireWatch(const std::string_view &directory) noexcept
+{
+#if defined(__linux__)
+    if (_notifier < 0)
+        return NoWatch;
+    const auto it = _watches.find([&directory](const Watch &watch) { return watch.directory.toView() == directory; });
+    if (it != _watches.end()) [[likely]] {
+        ++it->references;
+        return it->descriptor;
+    }
+    Core::SmallString<IOAllocator> watched(directory);
+    const auto descriptor = ::inotify_add_watch(_notifier, watched.c_str(), WatchMask);
+    if (descriptor < 0) [[unlikely]]
+        return NoWatch;
+    // The directory may already be watched under another path
+    if (const auto watch = findWatch(descriptor); watch) {
+        ++watch->references;
+        return descriptor;
+    }
+    _watches.push(Watch { .directory = std::move(watched), .descriptor = descriptor, .references = 1u });
+    return descriptor;
+#else
+    static_cast<void>(directory);
+    return NoWatch;
+#endif
+}
+
+void IO::ContentCache::releaseWatch(const std::int32_t descriptor) noexcept
+{
+    const auto watch = findWatch(descriptor);
+    if (!watch || --watch->references)
+        return;
+#if defined(__linux__)
+    ::inotify_rm_watch(_notifier, descriptor);
+#endif
+    _watches.erase(watch);
+}
+
+IO::ContentCache::Watch *IO::ContentCache::findWatch(const std::int32_t descriptor) noexcept
+{
+    const auto it = _watches.find([descriptor](const Watch &watch) { return watch.descriptor == descriptor; });
+    return it != _watches.end() ? it : nullptr;
+}
+
+void IO::ContentCache::invalidateWatch(const std::int32_t descriptor, const bool removed) noexcept
+{
+    for (auto index = 0u; index != _entries.size(); ++index) {
+        if (!_entries[index].used || _entries[index].watch != descriptor)
+            continue;
+        _entries[index].watch = NoWatch; // The watch is forgotten below, whatever its references
+        ++_statistics.invalidations;
+        erase(index);
+    }
+#if defined(__linux__)
+    if (!removed)
+        ::inotify_rm_watch(_notifier, descriptor);
+#else
+    static_cast<void>(removed);
+#endif
+    // In-flight loads won't find the watch and won't cache their content
+    if (const auto watch = findWatch(descriptor); watch)
+        _watches.erase(watch);
+}
+
+void IO::ContentCache::evict(const std::size_t size) noexcept
+{
+    while (_size + size > _budget && _leastRecent != NullEntry) {
+        ++_statistics.evictions;
+        erase(_leastRecent);
+    }
+}
+
+void IO::ContentCache::erase(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    const auto watch = entry.watch;
+    unlinkUse(index);
+    auto *link = &_buckets[entry.key & (_buckets.size() - 1u)];
+    while (*link != index)
+        link = &_entries[*link].nextInBucket;
+    *link = entry.nextInBucket;
+    _size -= entry.buffer.size();
+    entry.path.clear();
+    entry.buffer.release();
+    entry.nextInBucket = NullEntry;
+    entry.used = false;
+    _freeEntries.push(index);
+    --_count;
+    if (watch >= 0)
+        releaseWatch(watch);
+}
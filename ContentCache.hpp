@@ -0,0 +1,224 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO ContentCache
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Core/SmallString.hpp>
+
+#include "ContentBuffer.hpp"
+
+namespace kF::IO
+{
+    class ContentCache;
+}
+
+/** @brief Process-wide cache of file contents, keyed by lexically normalized path
+ *  @note Contents are handed out as shared read-only buffers, they stay valid after being evicted or invalidated
+ *  @note The cache stays under its budget by evicting least recently used contents,
+ *      the budget only accounts buffers held by the cache, not the ones released from it but still shared
+ *  @note Disk files are invalidated once their change is notified, through inotify watches of their directory on Linux.
+ *      A watcher thread waits for notifications so that hits don't make any system call.
+ *      Without watches (other platforms, watch limit reached) their size and modification time are checked on each hit
+ *  @note Resource files are cached as well and never invalidated */
+class kF::IO::ContentCache
+{
+public:
+    /** @brief Default budget in bytes */
+    static constexpr std::size_t DefaultBudget = 32 * 1024 * 1024;
+
+    /** @brief Access statistics */
+    struct Statistics
+    {
+        std::uint64_t hits {};
+        std::uint64_t misses {};
+        std::uint64_t evictions {};
+        std::uint64_t invalidations {}; // Contents dropped because their file changed
+    };
+
+    /** @brief Check if the cache global instance is initialized */
+    [[nodiscard]] static inline bool IsInitialized(void) noexcept { return _Instance.load(std::memory_order_acquire); }
+
+    /** @brief Get cache global instance */
+    [[nodiscard]] static inline ContentCache &Get(void) noexcept { return *_Instance.load(std::memory_order_acquire); }
+
+
+    /** @brief Destructor, buffers handed out stay valid */
+    ~ContentCache(void) noexcept;
+
+    /** @brief Constructor */
+    ContentCache(const std::size_t budget = DefaultBudget) noexcept;
+
+    /** @brief ContentCache is neither copyable nor movable */
+    ContentCache(const ContentCache &other) noexcept = delete;
+    ContentCache &operator=(const ContentCache &other) noexcept = delete;
+
+
+    /** @brief Get the content of the file at 'path', reading it on miss
+     *  @note Thread safe, files are read without holding the cache lock
+     *  @note Files larger than the budget are read but never cached
+     *  @return An invalid buffer if the file couldn't be read */
+    [[nodiscard]] ContentBuffer load(const std::string_view &path) noexcept;
+
+    /** @brief Drop the cached content of 'path' */
+    void invalidate(const std::string_view &path) noexcept;
+
+    /** @brief Drop every cached content */
+    void clear(void) noexcept;
+
+
+    /** @brief Get the budget in bytes */
+    [[nodiscard]] std::size_t budget(void) const noexcept;
+
+    /** @brief Set the budget in bytes, evicting contents if required */
+    void setBudget(const std::size_t budget) noexcept;
+
+    /** @brief Get the number of bytes held by the cache */
+    [[nodiscard]] std::size_t size(void) const noexcept;
+
+    /** @brief Get the number of cached files */
+    [[nodiscard]] std::uint32_t count(void) const noexcept;
+
+    /** @brief Check if changes are detected through file system notifications */
+    [[nodiscard]] inline bool isWatching(void) const noexcept { return _notifier >= 0; }
+
+
+    /** @brief Get access statistics */
+    [[nodiscard]] Statistics statistics(void) const noexcept;
+
+    /** @brief Reset access statistics */
+    void resetStatistics(void) noexcept;
+
+private:
+    /** @brief Size and modification time of a file, used to validate unwatched contents */
+    struct Stamp
+    {
+        std::size_t size {};
+        std::int64_t modified {};
+
+        /** @brief Comparison operator */
+        [[nodiscard]] bool operator==(const Stamp &other) const noexcept = default;
+    };
+
+    /** @brief Index of no entry */
+    static constexpr std::uint32_t NullEntry = ~std::uint32_t {};
+
+    /** @brief Cached content, entries are linked from the least to the most recently used */
+    struct Entry
+    {
+        Core::SmallString<IOAllocator> path {};
+        ContentBuffer buffer {};
+        Stamp stamp {};
+        Core::HashedName key {}; // Hash of the normalized path
+        Core::HashedName name {}; // Hash of the file name inside its directory
+        std::int32_t watch {};
+        std::uint32_t nextInBucket { NullEntry };
+        std::uint32_t previousUse { NullEntry };
+        std::uint32_t nextUse { NullEntry };
+        bool used {};
+    };
+
+    /** @brief State of pending notifications, shared with the watcher thread */
+    enum class Notifications : std::uint32_t
+    {
+        None,
+        Pending,
+        Stopped
+    };
+
+    /** @brief Watched directory */
+    struct Watch
+    {
+        Core::SmallString<IOAllocator> directory {};
+        std::int32_t descriptor {};
+        std::uint32_t references {}; // Entries and in-flight loads
+        std::uint64_t generation {}; // Incremented on every change inside the directory
+    };
+
+    /** @brief Watch of unwatched disk contents, validated by their stamp */
+    static constexpr std::int32_t NoWatch = -1;
+
+    /** @brief Watch of resource contents, never invalidated */
+    static constexpr std::int32_t Immutable = -2;
+
+
+    /** @brief Read the stamp of a disk file
+     *  @return False if the file doesn't exist */
+    [[nodiscard]] static bool ReadStamp(const std::string_view &path, Stamp &stamp) noexcept;
+
+    /** @brief Read the whole content of a file
+     *  @return An invalid buffer if the file couldn't be read */
+    [[nodiscard]] static ContentBuffer ReadContent(const std::string_view &path, const bool resource) noexcept;
+
+    /** @brief Find a cached content, the lock must be held
+     *  @return The index of the entry or 'NullEntry' on miss */
+    [[nodiscard]] std::uint32_t find(const Core::HashedName key, const std::string_view &path) const noexcept;
+
+    /** @brief Cache a content as the most recently used, the lock must be held */
+    void insert(const Core::HashedName key, const std::string_view &path, const ContentBuffer &buffer,
+            const Stamp &stamp, const std::int32_t watch) noexcept;
+
+    /** @brief Rebuild buckets after entries grew, the lock must be held */
+    void rehash(void) noexcept;
+
+    /** @brief Mark an entry as the most recently used, the lock must be held */
+    void touch(const std::uint32_t index) noexcept;
+
+    /** @brief Link an entry as the most recently used, the lock must be held */
+    void linkUse(const std::uint32_t index) noexcept;
+
+    /** @brief Unlink an entry from the use list, the lock must be held */
+    void unlinkUse(const std::uint32_t index) noexcept;
+
+    /** @brief Wait for notifications and flag them to loaders, body of the watcher thread */
+    void watchEvents(void) noexcept;
+
+    /** @brief Read flagged notifications and invalidate changed contents, the lock must be held */
+    void processEvents(void) noexcept;
+
+    /** @brief Watch the directory of a file and take a reference on it, the lock must be held
+     *  @return The watch descriptor or 'NoWatch' if the directory can't be watched */
+    [[nodiscard]] std::int32_t acquireWatch(const std::string_view &directory) noexcept;
+
+    /** @brief Release a reference on a watch, removing it once unused, the lock must be held */
+    void releaseWatch(const std::int32_t descriptor) noexcept;
+
+    /** @brief Find a watch by descriptor, the lock must be held */
+    [[nodiscard]] Watch *findWatch(const std::int32_t descriptor) noexcept;
+
+    /** @brief Drop every content of a watch and forget the watch, the lock must be held
+     *  @param removed True if the kernel already removed the watch */
+    void invalidateWatch(const std::int32_t descriptor, const bool removed) noexcept;
+
+    /** @brief Evict least recently used contents until 'size' more bytes fit into the budget, the lock must be held */
+    void evict(const std::size_t size) noexcept;
+
+    /** @brief Drop a cached content, the lock must be held */
+    void erase(const std::uint32_t index) noexcept;
+
+
+    /** @brief Global instance */
+    static std::atomic<ContentCache *> _Instance;
+
+    Core::Vector<std::uint32_t, IOAllocator> _buckets {}; // Heads of entry chains, indexed by key
+    Core::Vector<Entry, IOAllocator> _entries {};
+    Core::Vector<std::uint32_t, IOAllocator> _freeEntries {};
+    Core::Vector<Watch, IOAllocator> _watches {};
+    std::uint32_t _leastRecent { NullEntry };
+    std::uint32_t _mostRecent { NullEntry };
+    std::uint32_t _count {};
+    std::size_t _size {};
+    std::size_t _budget {};
+    Statistics _statistics {};
+    std::int32_t _notifier { -1 };
+    std::int32_t _wakeup { -1 }; // Stops the watcher thread
+    std::atomic<Notifications> _notifications { Notifications::None };
+    std::thread _watcher {};
+    mutable std::mutex _mutex {};
+};
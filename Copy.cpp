@@ -0,0 +1,206 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Copy
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Copy.hpp"
+#include "File.hpp"
+#include "Native.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Alignment of copy buffers */
+    constexpr std::size_t BufferAlignment = 4096;
+
+    /** @brief State shared by copy workers */
+    struct CopyContext
+    {
+        const IO::CopyOptions &options;
+        std::size_t total {};
+        std::size_t chunkCount {};
+        std::atomic<std::size_t> nextChunk {};
+        std::atomic<std::size_t> copied {};
+        std::atomic<bool> stop {};
+        std::atomic<bool> failed {};
+        std::atomic<bool> cancelled {};
+        std::mutex progressMutex {};
+    };
+
+    /** @brief Distribute the chunks of a copy between workers, 'copyChunk(offset, count, buffer)' returns false on failure
+     *  @note 'buffer' is a null pointer that workers can allocate for a chunk, it is released when the worker ends */
+    template<typename CopyChunk>
+    void RunChunks(CopyContext &context, const std::uint32_t workerCount, CopyChunk &&copyChunk) noexcept
+    {
+        const auto chunkSize = context.options.chunkSize;
+        const auto work = [&context, &copyChunk, chunkSize] {
+            std::uint8_t *buffer {};
+            while (!context.stop.load(std::memory_order_relaxed)) {
+                const auto index = context.nextChunk.fetch_add(1u, std::memory_order_relaxed);
+                if (index >= context.chunkCount)
+                    break;
+                const auto offset = index * chunkSize;
+                const auto count = std::min(chunkSize, context.total - offset);
+                if (!copyChunk(offset, count, buffer)) [[unlikely]] {
+                    context.failed.store(true, std::memory_order_relaxed);
+                    context.stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                const auto copied = context.copied.fetch_add(count, std::memory_order_relaxed) + count;
+                if (context.options.progress) {
+                    std::lock_guard<std::mutex> guard(context.progressMutex);
+                    if (!context.options.progress(copied, context.total, context.options.userData)) {
+                        context.cancelled.store(true, std::memory_order_relaxed);
+                        context.stop.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (buffer)
+                IO::IOAllocator::Deallocate(buffer, chunkSize, BufferAlignment);
+        };
+
+        Core::Vector<std::thread, IO::IOAllocator> threads {};
+        for (auto i = 1u; i < workerCount; ++i)
+            threads.push(work);
+        work();
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    /** @brief Get the number of workers of a copy */
+    [[nodiscard]] std::uint32_t GetWorkerCount(const CopyContext &context) noexcept
+    {
+        const auto threadCount = context.options.threadCount ? context.options.threadCount : std::thread::hardware_concurrency();
+        return static_cast<std::uint32_t>(std::max<std::size_t>(1u, std::min<std::size_t>(threadCount, context.chunkCount)));
+    }
+
+    /** @brief Get the status of a finished copy */
+    [[nodiscard]] IO::CopyStatus GetStatus(const CopyContext &context) noexcept
+    {
+        if (context.failed.load(std::memory_order_relaxed))
+            return IO::CopyStatus::Failed;
+        else if (context.cancelled.load(std::memory_order_relaxed))
+            return IO::CopyStatus::Cancelled;
+        return IO::CopyStatus::Success;
+    }
+
+    /** @brief Copy the bytes of a resource */
+    [[nodiscard]] IO::CopyResult CopyResource(const IO::ResourceView &view, const IO::Native::Handle destination, CopyContext &context) noexcept
+    {
+        context.total = view.size();
+        context.chunkCount = (context.total + context.options.chunkSize - 1u) / context.options.chunkSize;
+        static_cast<void>(IO::Native::Resize(destination, context.total));
+        RunChunks(context, GetWorkerCount(context), [&view, destination](const std::size_t offset, const std::size_t count, std::uint8_t *&) {
+            return IO::Native::WriteAt(destination, view.from + offset, count, offset) == count;
+        });
+        return IO::CopyResult {
+            .status = GetStatus(context),
+            .method = IO::CopyMethod::Resource,
+            .copied = context.copied.load(std::memory_order_relaxed)
+        };
+    }
+
+    /** @brief Copy the content of a disk file */
+    [[nodiscard]] IO::CopyResult CopyDisk(const IO::Native::Handle source, const IO::Native::Handle destination, CopyContext &context) noexcept
+    {
+        context.total = IO::Native::Size(source);
+        if (context.options.allowClone && IO::Native::Clone(source, destination)) {
+            context.copied = context.total;
+            if (context.options.progress)
+                context.options.progress(context.total, context.total, context.options.userData);
+            return IO::CopyResult { .status = IO::CopyStatus::Success, .method = IO::CopyMethod::Clone, .copied = context.total };
+        }
+
+        context.chunkCount = (context.total + context.options.chunkSize - 1u) / context.options.chunkSize;
+        static_cast<void>(IO::Native::Resize(destination, context.total));
+        const auto workerCount = GetWorkerCount(context);
+        const auto chunkSize = context.options.chunkSize;
+        std::atomic<bool> kernelCopy { true };
+        std::atomic<bool> sendFile { workerCount == 1u }; // sendfile moves the destination position
+        std::atomic<bool> buffered { false };
+
+        RunChunks(context, workerCount, [&, source, destination](std::size_t offset, std::size_t count, std::uint8_t *&buffer) {
+            if (kernelCopy.load(std::memory_order_relaxed)) {
+                const auto copied = IO::Native::CopyRange(source, destination, count, offset);
+                if (!copied)
+                    kernelCopy.store(false, std::memory_order_relaxed);
+                offset += copied;
+                count -= copied;
+            }
+            if (count && sendFile.load(std::memory_order_relaxed)) {
+                const auto copied = IO::Native::SendFile(source, destination, count, offset);
+                if (!copied)
+                    sendFile.store(false, std::memory_order_relaxed);
+                offset += copied;
+                count -= copied;
+            }
+            if (!count)
+                return true;
+
+            buffered.store(true, std::memory_order_relaxed);
+            if (!buffer)
+                buffer = reinterpret_cast<std::uint8_t *>(IO::IOAllocator::Allocate(chunkSize, BufferAlignment));
+            return IO::Native::ReadAt(source, buffer, count, offset) == count
+                && IO::Native::WriteAt(destination, buffer, count, offset) == count;
+        });
+
+        return IO::CopyResult {
+            .status = GetStatus(context),
+            .method = buffered.load(std::memory_order_relaxed) ? IO::CopyMethod::Buffered : IO::CopyMethod::Kernel,
+            .copied = context.copied.load(std::memory_order_relaxed)
+        };
+    }
+}
+
+IO::CopyResult IO::CopyFile(const std::string_view &source, const std::string_view &destination, const CopyOptions &options) noexcept
+{
+    const std::filesystem::path destinationPath(destination);
+    std::error_code code {};
+    if (!options.chunkSize || (!options.overwrite && std::filesystem::exists(destinationPath, code))) [[unlikely]]
+        return CopyResult { .status = CopyStatus::Failed };
+
+    // Resolve the source before the destination is truncated
+    const bool isResource = source.starts_with(ResourcePrefix);
+    Native::Handle sourceHandle = Native::InvalidHandle;
+    ResourceData resource {};
+    if (isResource) {
+        const File file(source, File::Mode::Read);
+        if (!file.exists()) [[unlikely]]
+            return CopyResult { .status = CopyStatus::Failed };
+        resource = file.queryResource();
+    } else {
+        sourceHandle = Native::Open(source, true, false);
+        if (sourceHandle == Native::InvalidHandle) [[unlikely]]
+            return CopyResult { .status = CopyStatus::Failed };
+    }
+    const auto destinationHandle = Native::Open(destination, false, true);
+    if (destinationHandle == Native::InvalidHandle) [[unlikely]] {
+        if (sourceHandle != Native::InvalidHandle)
+            Native::Close(sourceHandle);
+        return CopyResult { .status = CopyStatus::Failed };
+    }
+
+    CopyContext context { .options = options };
+    const auto result = isResource
+        ? CopyResource(resource.view(), destinationHandle, context)
+        : CopyDisk(sourceHandle, destinationHandle, context);
+
+    Native::Close(destinationHandle);
+    if (sourceHandle != Native::InvalidHandle) {
+        Native::Close(sourceHandle);
+        if (result.status == CopyStatus::Success)
+            std::filesystem::permissions(destinationPath, std::filesystem::status(std::filesystem::path(source), code).permissions(), code);
+    }
+    if (result.status != CopyStatus::Success)
+        std::filesystem::remove(destinationPath, code);
+    return result;
+}
@@ -0,0 +1,64 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Copy
+ */
+
+#pragma once
+
+#include "Base.hpp"
+
+namespace kF::IO
+{
+    /** @brief Default size of the chunks distributed between copy workers */
+    constexpr std::size_t DefaultCopyChunkSize = 8 * 1024 * 1024;
+
+    /** @brief Status of a copy */
+    enum class CopyStatus : std::uint32_t
+    {
+        Success,
+        Failed,
+        Cancelled
+    };
+
+    /** @brief Method used to copy data */
+    enum class CopyMethod : std::uint32_t
+    {
+        None,
+        Clone,      // Extents shared with the source (reflink)
+        Kernel,     // Copied inside the kernel (copy_file_range, sendfile)
+        Buffered,   // Copied through userspace buffers
+        Resource    // Written from the embedded resource bytes
+    };
+
+    /** @brief Result of a copy */
+    struct CopyResult
+    {
+        CopyStatus status {};
+        CopyMethod method {};
+        std::size_t copied {};
+    };
+
+    /** @brief Progress callback, called after each copied chunk, return false to cancel the copy
+     *  @note Calls are serialized but may come from any copy worker */
+    using CopyProgressCallback = bool(*)(const std::size_t copied, const std::size_t total, void * const userData) noexcept;
+
+    /** @brief Options of a copy */
+    struct CopyOptions
+    {
+        std::size_t chunkSize { DefaultCopyChunkSize };
+        std::uint32_t threadCount {}; // 0 uses the hardware concurrency, limited by the number of chunks
+        bool overwrite { false };
+        bool allowClone { true };
+        CopyProgressCallback progress {};
+        void *userData {};
+    };
+
+
+    /** @brief Copy a disk or resource file to 'destination'
+     *
+     *  Disk files are cloned when the file system supports it, otherwise chunks are distributed between workers
+     *  which copy inside the kernel and fall back to userspace buffers. Resources are written straight from their bytes.
+     *  @note A failed or cancelled copy removes the destination */
+    [[nodiscard]] CopyResult CopyFile(const std::string_view &source, const std::string_view &destination,
+            const CopyOptions &options = CopyOptions {}) noexcept;
+}
@@ -0,0 +1,206 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Direct
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+#include "Direct.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Aligned bounce buffer of unaligned transfers */
+    class BounceBuffer
+    {
+    public:
+        /** @brief Allocate a buffer covering up to 'size' bytes, limited to 'BounceSize' */
+        BounceBuffer(const std::size_t size) noexcept
+            : _size(std::min(IO::Direct::AlignUp(size), IO::Direct::BounceSize))
+            , _data(reinterpret_cast<std::uint8_t *>(IO::Direct::Allocator::Allocate(_size, IO::Direct::Alignment))) {}
+
+        /** @brief Release the buffer */
+        ~BounceBuffer(void) noexcept { IO::Direct::Allocator::Deallocate(_data, _size, IO::Direct::Alignment); }
+
+        /** @brief Get buffer data */
+        [[nodiscard]] std::uint8_t *data(void) const noexcept { return _data; }
+
+        /** @brief Get buffer size */
+        [[nodiscard]] std::size_t size(void) const noexcept { return _size; }
+
+    private:
+        std::size_t _size {};
+        std::uint8_t *_data {};
+    };
+
+    /** @brief Read the block at 'offset' into 'data', zeroing what lies past the end of file */
+    void ReadBlock(const IO::Native::Handle handle, std::uint8_t * const data, const std::size_t offset) noexcept
+    {
+        const auto count = IO::Native::ReadAt(handle, data, IO::Direct::Alignment, offset);
+        std::memset(data + count, 0, IO::Direct::Alignment - count);
+    }
+}
+
+std::size_t IO::Direct::Read(const Native::Handle handle, std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    std::optional<BounceBuffer> buffer;
+
+    while (total < size) {
+        const auto position = offset + total;
+        const auto remaining = size - total;
+        const auto to = data + total;
+
+        // Aligned body, straight into the caller buffer
+        if (IsAligned(position) && IsAligned(to) && remaining >= Alignment) {
+            const auto count = AlignDown(remaining);
+            const auto readCount = Native::ReadAt(handle, to, count, position);
+            total += readCount;
+            if (readCount != count)
+                break;
+            continue;
+        }
+
+        // Unaligned part, through the bounce buffer
+        if (!buffer)
+            buffer.emplace(remaining + 2 * Alignment);
+        const auto bounce = buffer->data();
+        const auto blockFrom = AlignDown(position);
+        const auto head = position - blockFrom;
+        const auto span = std::min(buffer->size(), AlignUp(head + remaining));
+        const auto readCount = Native::ReadAt(handle, bounce, span, blockFrom);
+        if (readCount <= head)
+            break;
+        const auto count = std::min(remaining, readCount - head);
+        std::memcpy(to, bounce + head, count);
+        total += count;
+        if (readCount != span)
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Direct::Write(const Native::Handle handle, const std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    const auto fileSize = Native::Size(handle);
+    std::size_t total {};
+    std::size_t paddedEnd {};
+    std::optional<BounceBuffer> buffer;
+
+    while (total < size) {
+        const auto position = offset + total;
+        const auto remaining = size - total;
+        const auto from = data + total;
+
+        // Aligned body, straight from the caller buffer
+        if (IsAligned(position) && IsAligned(from) && remaining >= Alignment) {
+            const auto count = AlignDown(remaining);
+            const auto writeCount = Native::WriteAt(handle, from, count, position);
+            total += writeCount;
+            if (writeCount != count)
+                break;
+            continue;
+        }
+
+        // Unaligned part, blocks partially covered are patched in the bounce buffer
+        if (!buffer)
+            buffer.emplace(remaining + 2 * Alignment);
+        const auto bounce = buffer->data();
+        const auto blockFrom = AlignDown(position);
+        const auto head = position - blockFrom;
+        const auto count = std::min(remaining, buffer->size() - head);
+        const auto span = AlignUp(head + count);
+        if (head)
+            ReadBlock(handle, bounce, blockFrom);
+        if (const auto tail = head + count; !IsAligned(tail) && (!head || span != Alignment))
+            ReadBlock(handle, bounce + span - Alignment, blockFrom + span - Alignment);
+        std::memcpy(bounce + head, from, count);
+        if (Native::WriteAt(handle, bounce, span, blockFrom) != span)
+            break;
+        total += count;
+        paddedEnd = std::max(paddedEnd, blockFrom + span);
+    }
+
+    // Padding of the last block may have grown the file past the written range
+    if (const auto end = std::max(fileSize, offset + total); paddedEnd > end)
+        static_cast<void>(Native::Resize(handle, end));
+    return total;
+}
+
+std::size_t IO::Direct::WriteVector(const Native::Handle handle, const ResourceView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept
+{
+    const auto fileSize = Native::Size(handle);
+    std::size_t size {};
+    for (const auto &view : Core::IteratorRange<const ResourceView *> { buffers, buffers + count })
+        size += view.size();
+    std::size_t total {};
+    std::size_t paddedEnd {};
+    std::optional<BounceBuffer> buffer;
+    auto index = 0u;
+    std::size_t consumed {}; // Bytes of the current buffer already written
+
+    while (total < size) {
+        while (consumed == buffers[index].size()) {
+            ++index;
+            consumed = 0u;
+        }
+        const auto position = offset + total;
+        const auto from = buffers[index].from + consumed;
+        const auto available = buffers[index].size() - consumed;
+
+        // Aligned body of a buffer, straight from the caller buffer
+        if (IsAligned(position) && IsAligned(from) && available >= Alignment) {
+            const auto chunk = AlignDown(available);
+            const auto writeCount = Native::WriteAt(handle, from, chunk, position);
+            total += writeCount;
+            consumed += writeCount;
+            if (writeCount != chunk)
+                break;
+            continue;
+        }
+
+        // Unaligned pieces are gathered until the bounce buffer is full or an aligned body starts on a block boundary
+        if (!buffer)
+            buffer.emplace(size - total + 2 * Alignment);
+        const auto bounce = buffer->data();
+        const auto blockFrom = AlignDown(position);
+        const auto head = position - blockFrom;
+        const auto capacity = buffer->size() - head;
+        std::size_t gathered {};
+        for (auto piece = index; total + gathered < size && gathered < capacity; ++piece) {
+            const auto pieceFrom = buffers[piece].from + (piece == index ? consumed : 0u);
+            const auto pieceSize = static_cast<std::size_t>(std::distance(pieceFrom, buffers[piece].to));
+            if (gathered && IsAligned(position + gathered) && IsAligned(pieceFrom) && pieceSize >= Alignment)
+                break;
+            gathered += std::min(pieceSize, capacity - gathered);
+        }
+        const auto span = AlignUp(head + gathered);
+        if (head)
+            ReadBlock(handle, bounce, blockFrom);
+        if (const auto tail = head + gathered; !IsAligned(tail) && (!head || span != Alignment))
+            ReadBlock(handle, bounce + span - Alignment, blockFrom + span - Alignment);
+        for (std::size_t copied {}; copied != gathered;) {
+            if (consumed == buffers[index].size()) {
+                ++index;
+                consumed = 0u;
+                continue;
+            }
+            const auto chunk = std::min(buffers[index].size() - consumed, gathered - copied);
+            std::memcpy(bounce + head + copied, buffers[index].from + consumed, chunk);
+            copied += chunk;
+            consumed += chunk;
+        }
+        if (Native::WriteAt(handle, bounce, span, blockFrom) != span)
+            break;
+        total += gathered;
+        paddedEnd = std::max(paddedEnd, blockFrom + span);
+    }
+
+    // Padding of the last block may have grown the file past the written range
+    if (const auto end = std::max(fileSize, offset + total); paddedEnd > end)
+        static_cast<void>(Native::Resize(handle, end));
+    return total;
+}
@@ -0,0 +1,65 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Direct
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include "Native.hpp"
+
+/** @brief Unbuffered transfers, which require aligned buffers, offsets and sizes
+ *
+ *  Aligned parts of a transfer go straight between the caller buffer and the device,
+ *  unaligned heads and tails go through an aligned bounce buffer. */
+namespace kF::IO::Direct
+{
+    /** @brief Alignment of buffers, offsets and sizes of unbuffered transfers (covers 512 and 4096 bytes logical blocks) */
+    constexpr std::size_t Alignment = 4096;
+
+    /** @brief Maximum size of the bounce buffer of unaligned transfers */
+    constexpr std::size_t BounceSize = 1024 * 1024;
+
+
+    /** @brief Align 'value' down to 'Alignment' */
+    [[nodiscard]] constexpr std::size_t AlignDown(const std::size_t value) noexcept { return value & ~(Alignment - 1); }
+
+    /** @brief Align 'value' up to 'Alignment' */
+    [[nodiscard]] constexpr std::size_t AlignUp(const std::size_t value) noexcept { return AlignDown(value + Alignment - 1); }
+
+    /** @brief Check if 'value' is aligned to 'Alignment' */
+    [[nodiscard]] constexpr bool IsAligned(const std::size_t value) noexcept { return !(value & (Alignment - 1)); }
+
+    /** @brief Check if 'data' is aligned to 'Alignment' */
+    [[nodiscard]] inline bool IsAligned(const void * const data) noexcept { return IsAligned(reinterpret_cast<std::uintptr_t>(data)); }
+
+
+    /** @brief Static allocator of buffers suited to unbuffered transfers, built on IOAllocator
+     *  @note Allocations are aligned and padded to 'Alignment' */
+    struct Allocator
+    {
+        /** @brief Allocate 'size' bytes */
+        [[nodiscard]] static inline void *Allocate(const std::size_t size, const std::size_t alignment) noexcept
+            { return IOAllocator::Allocate(AlignUp(size), std::max(alignment, Alignment)); }
+
+        /** @brief Deallocate a buffer */
+        static inline void Deallocate(void * const data, const std::size_t size, const std::size_t alignment) noexcept
+            { IOAllocator::Deallocate(data, AlignUp(size), std::max(alignment, Alignment)); }
+    };
+
+
+    /** @brief Read up to 'size' bytes at 'offset' from an unbuffered handle
+     *  @return The number of bytes read */
+    [[nodiscard]] std::size_t Read(const Native::Handle handle, std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept;
+
+    /** @brief Write 'size' bytes at 'offset' into an unbuffered handle
+     *  @note Partially covered blocks are read, patched and written back, concurrent writes to a same block must be serialized
+     *  @return The number of bytes written */
+    [[nodiscard]] std::size_t Write(const Native::Handle handle, const std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept;
+
+    /** @brief Write 'count' buffers back to back at 'offset' into an unbuffered handle
+     *  @note Neighbouring unaligned buffers are gathered in a single bounce region, so each partially covered block is patched once
+     *  @return The number of bytes written */
+    [[nodiscard]] std::size_t WriteVector(const Native::Handle handle, const ResourceView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept;
+}
@@ -0,0 +1,244 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Directory
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+# include <filesystem>
+#else
+# include <dirent.h>
+# include <fcntl.h>
+# include <sys/stat.h>
+#endif
+
+#include "Directory.hpp"
+#include "Pack.hpp"
+#include "ResourceManager.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Call 'callback(name, type)' for each entry of a disk directory */
+    template<typename Callback>
+    bool ListDisk(const std::string &path, Callback &&callback) noexcept
+    {
+#if defined(_WIN32)
+        std::error_code code {};
+        std::filesystem::directory_iterator it(std::filesystem::path(path), code);
+        if (code)
+            return false;
+        for (const auto &entry : it) {
+            const auto name = entry.path().filename().string();
+            callback(std::string_view(name),
+                entry.is_regular_file(code) ? IO::EntryType::File
+                    : entry.is_directory(code) ? IO::EntryType::Directory : IO::EntryType::Other);
+        }
+        return true;
+#else
+        const auto directory = ::opendir(path.c_str());
+        if (!directory)
+            return false;
+        while (const auto entry = ::readdir(directory)) {
+            const std::string_view name(entry->d_name);
+            if (name == "." || name == "..")
+                continue;
+            auto type = entry->d_type;
+            // Some filesystems do not report the entry type
+            if (type == DT_UNKNOWN) {
+                struct stat status {};
+                if (!::fstatat(::dirfd(directory), entry->d_name, &status, AT_SYMLINK_NOFOLLOW))
+                    type = S_ISREG(status.st_mode) ? DT_REG : S_ISDIR(status.st_mode) ? DT_DIR : DT_UNKNOWN;
+            }
+            callback(name, type == DT_REG ? IO::EntryType::File : type == DT_DIR ? IO::EntryType::Directory : IO::EntryType::Other);
+        }
+        ::closedir(directory);
+        return true;
+#endif
+    }
+
+    /** @brief Get the environment and the directory of a resource path */
+    [[nodiscard]] std::pair<Core::HashedName, std::string> SplitResourcePath(const std::string_view &path) noexcept
+    {
+        const auto to = std::min(path.find('/', IO::EnvironmentBeginIndex), path.size());
+        auto directory = std::string(path.substr(std::min(to + 1, path.size())));
+        while (!directory.empty() && directory.back() == '/')
+            directory.pop_back();
+        return { Core::Hash(path.substr(IO::EnvironmentBeginIndex, to - IO::EnvironmentBeginIndex)), std::move(directory) };
+    }
+
+    /** @brief List a directory of a mounted pack, recursively if requested
+     *  @note Every directory leading to a file has its own entry, the index is walked once without deduplicating paths */
+    bool ListPack(const IO::ResourceView &pack, const std::string_view &path, const std::string &directory,
+            IO::DirectoryListing &listing, const bool recursive) noexcept
+    {
+        std::string parent(path);
+        while (parent.size() > IO::EnvironmentBeginIndex && parent.back() == '/')
+            parent.pop_back();
+        const auto prefix = directory.empty() ? std::string() : directory + '/';
+        bool found = directory.empty();
+        for (const auto &entry : IO::Pack::GetIndex(pack)) {
+            if (!Core::HasFlags(entry.flags, IO::Pack::EntryFlags::Used))
+                continue;
+            const auto name = IO::Pack::GetName(pack, entry);
+            const auto isDirectory = Core::HasFlags(entry.flags, IO::Pack::EntryFlags::Directory);
+            if (!name.starts_with(prefix)) {
+                found |= isDirectory && name == directory;
+                continue;
+            }
+            found = true;
+            const auto relative = name.substr(prefix.size());
+            const auto split = relative.find_last_of('/');
+            if (!recursive && split != std::string_view::npos)
+                continue;
+            listing.push(split == std::string_view::npos ? parent : parent + '/' + std::string(relative.substr(0, split)),
+                relative.substr(split + 1), isDirectory ? IO::EntryType::Directory : IO::EntryType::File);
+        }
+        return found;
+    }
+
+    /** @brief List a resource directory, recursively if requested */
+    bool ListResource(const std::string_view &path, IO::DirectoryListing &listing, const bool recursive) noexcept
+    {
+        const auto [environmentName, directory] = SplitResourcePath(path);
+        auto &manager = IO::ResourceManager::Get();
+        if (!manager.environmentExists(environmentName))
+            return false;
+        else if (manager.isPack(environmentName))
+            return ListPack(manager.getPack(environmentName), path, directory, listing, recursive);
+        const auto environment = manager.getEnvironment(environmentName);
+        if (!environment.is_directory(directory))
+            return false;
+
+        std::string parent(path);
+        while (parent.size() > IO::EnvironmentBeginIndex && parent.back() == '/')
+            parent.pop_back();
+        const auto listDirectory = [&environment, &listing, recursive](const auto &self, const std::string &directory, const std::string &parent) -> void {
+            for (const auto &entry : environment.iterate_directory(directory)) {
+                const auto &name = entry.filename();
+                const auto type = entry.is_directory() ? IO::EntryType::Directory : IO::EntryType::File;
+                listing.push(parent, name, type);
+                if (recursive && type == IO::EntryType::Directory)
+                    self(self, directory.empty() ? name : directory + '/' + name, parent + '/' + name);
+            }
+        };
+        listDirectory(listDirectory, directory, parent);
+        return true;
+    }
+}
+
+void IO::DirectoryListing::push(const std::string_view &directory, const std::string_view &name, const EntryType type) noexcept
+{
+    const auto offset = _arena.size();
+    const bool separator = !directory.empty() && directory.back() != '/' && directory.back() != '\\';
+    const auto size = directory.size() + separator + name.size();
+    _arena.resize(offset + size);
+    auto it = std::copy(directory.begin(), directory.end(), _arena.begin() + offset);
+    if (separator)
+        *it++ = '/';
+    std::copy(name.begin(), name.end(), it);
+    _records.push(Record { .offset = offset, .size = static_cast<std::uint32_t>(size), .type = type });
+}
+
+void IO::DirectoryListing::append(const DirectoryListing &other) noexcept
+{
+    const auto base = _arena.size();
+    _arena.insert(_arena.end(), other._arena.begin(), other._arena.end());
+    for (const auto &record : other._records)
+        _records.push(Record { .offset = base + record.offset, .size = record.size, .type = record.type });
+}
+
+void IO::DirectoryListing::sort(void) noexcept
+{
+    std::sort(_records.begin(), _records.end(), [this](const Record &lhs, const Record &rhs) {
+        return std::string_view(_arena.data() + lhs.offset, lhs.size) < std::string_view(_arena.data() + rhs.offset, rhs.size);
+    });
+}
+
+void IO::DirectoryListing::clear(void) noexcept
+{
+    _arena.clear();
+    _records.clear();
+}
+
+bool IO::ListDirectory(const std::string_view &path, DirectoryListing &listing) noexcept
+{
+    if (path.starts_with(ResourcePrefix))
+        return ListResource(path, listing, false);
+    return ListDisk(std::string(path), [&listing, &path](const std::string_view &name, const EntryType type) {
+        listing.push(path, name, type);
+    });
+}
+
+bool IO::WalkDirectory(const std::string_view &path, DirectoryListing &listing, const std::uint32_t threadCount) noexcept
+{
+    if (path.starts_with(ResourcePrefix))
+        return ListResource(path, listing, true);
+
+    // Shared queue of directories to visit, each worker fills its own listing
+    struct Shared
+    {
+        std::mutex mutex {};
+        std::condition_variable condition {};
+        Core::Vector<std::string, IOAllocator> queue {};
+        std::uint32_t activeCount {};
+    } shared;
+
+    if (!ListDisk(std::string(path), [&listing, &path, &shared](const std::string_view &name, const EntryType type) {
+        listing.push(path, name, type);
+        if (type == EntryType::Directory)
+            shared.queue.push(std::string(listing[listing.size() - 1].path));
+    })) {
+        return false;
+    }
+
+    if (shared.queue.empty())
+        return true;
+
+    // The queue grows while walking, so every worker is started even if there are fewer directories yet
+    const auto workerCount = std::max(1u, threadCount ? threadCount : std::thread::hardware_concurrency());
+    Core::Vector<DirectoryListing, IOAllocator> listings {};
+    listings.resize(workerCount);
+    const auto work = [&shared](DirectoryListing &local) {
+        Core::Vector<std::string, IOAllocator> found {};
+        std::unique_lock lock(shared.mutex);
+        while (true) {
+            shared.condition.wait(lock, [&shared] { return !shared.queue.empty() || !shared.activeCount; });
+            if (shared.queue.empty())
+                return;
+            auto directory = std::move(shared.queue.back());
+            shared.queue.pop();
+            ++shared.activeCount;
+            lock.unlock();
+
+            ListDisk(directory, [&local, &directory, &found](const std::string_view &name, const EntryType type) {
+                local.push(directory, name, type);
+                if (type == EntryType::Directory)
+                    found.push(std::string(local[local.size() - 1].path));
+            });
+
+            lock.lock();
+            --shared.activeCount;
+            for (auto &child : found)
+                shared.queue.push(std::move(child));
+            found.clear();
+            shared.condition.notify_all();
+        }
+    };
+
+    Core::Vector<std::thread, IOAllocator> threads {};
+    for (auto i = 1u; i < workerCount; ++i)
+        threads.push(work, std::ref(listings[i]));
+    work(listings[0]);
+    for (auto &thread : threads)
+        thread.join();
+    for (const auto &local : listings)
+        listing.append(local);
+    return true;
+}
@@ -0,0 +1,127 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Directory
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::IO
+{
+    class DirectoryListing;
+
+    /** @brief Type of a directory entry */
+    enum class EntryType : std::uint32_t
+    {
+        File,
+        Directory,
+        Other
+    };
+
+
+    /** @brief List the entries of a directory (disk or resource) and append them to 'listing'
+     *  @return False if the directory couldn't be opened */
+    bool ListDirectory(const std::string_view &path, DirectoryListing &listing) noexcept;
+
+    /** @brief Recursively list a directory (disk or resource) and append every entry to 'listing'
+     *  @param threadCount Number of worker threads used for disk directories, 0 uses the hardware concurrency
+     *  @note Entries are not ordered, use 'DirectoryListing::sort' if required
+     *  @return False if the root directory couldn't be opened */
+    bool WalkDirectory(const std::string_view &path, DirectoryListing &listing, const std::uint32_t threadCount = 0u) noexcept;
+}
+
+/** @brief Compact list of directory entries, every path is stored in a single arena */
+class kF::IO::DirectoryListing
+{
+public:
+    /** @brief Directory entry */
+    struct Entry
+    {
+        std::string_view path {};
+        EntryType type {};
+
+        /** @brief Get the entry name (path without its directory) */
+        [[nodiscard]] inline std::string_view name(void) const noexcept
+            { return path.substr(path.find_last_of("/\\") + 1); }
+    };
+
+    /** @brief Entry iterator */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Entry;
+
+        /** @brief Constructor */
+        Iterator(const DirectoryListing * const listing = nullptr, const std::uint32_t index = 0u) noexcept
+            : _listing(listing), _index(index) {}
+
+        /** @brief Get current entry */
+        [[nodiscard]] inline Entry operator*(void) const noexcept { return (*_listing)[_index]; }
+
+        /** @brief Advance to the next entry */
+        inline Iterator &operator++(void) noexcept { ++_index; return *this; }
+
+        /** @brief Advance to the next entry (postfix) */
+        inline Iterator operator++(int) noexcept { auto copy = *this; ++_index; return copy; }
+
+        /** @brief Comparison operator */
+        [[nodiscard]] inline bool operator==(const Iterator &other) const noexcept = default;
+
+    private:
+        const DirectoryListing *_listing {};
+        std::uint32_t _index {};
+    };
+
+
+    /** @brief Get the number of entries */
+    [[nodiscard]] inline std::uint32_t size(void) const noexcept { return _records.size(); }
+
+    /** @brief Check if the listing is empty */
+    [[nodiscard]] inline bool empty(void) const noexcept { return _records.empty(); }
+
+    /** @brief Get an entry */
+    [[nodiscard]] inline Entry operator[](const std::uint32_t index) const noexcept
+    {
+        const auto &record = _records[index];
+        return Entry { .path = std::string_view(_arena.data() + record.offset, record.size), .type = record.type };
+    }
+
+    /** @brief Begin iterator */
+    [[nodiscard]] inline Iterator begin(void) const noexcept { return Iterator(this, 0u); }
+
+    /** @brief End iterator */
+    [[nodiscard]] inline Iterator end(void) const noexcept { return Iterator(this, size()); }
+
+
+    /** @brief Append an entry made of 'directory' and 'name' */
+    void push(const std::string_view &directory, const std::string_view &name, const EntryType type) noexcept;
+
+    /** @brief Append every entry of another listing */
+    void append(const DirectoryListing &other) noexcept;
+
+    /** @brief Sort entries by path */
+    void sort(void) noexcept;
+
+    /** @brief Remove all entries */
+    void clear(void) noexcept;
+
+
+private:
+    /** @brief Entry record, its path lives in the arena */
+    struct Record
+    {
+        std::size_t offset {};
+        std::uint32_t size {};
+        EntryType type {};
+    };
+
+    Core::Vector<char, IOAllocator, std::size_t> _arena {};
+    Core::Vector<Record, IOAllocator> _records {};
+};
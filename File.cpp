@@ -3,40 +3,110 @@
  * @ Description: IO File
  */
 
+#include "Copy.hpp"
+#include "Direct.hpp"
 #include "File.hpp"
+#include "Instrumentation.hpp"
 #include "ResourceManager.hpp"
 
 #include <Kube/Core/Abort.hpp>
 #include <Kube/Core/Assert.hpp>
 
+#include <algorithm>
 #include <filesystem>
+#include <new>
+#include <utility>
 
 using namespace kF;
 
+namespace
+{
+    /** @brief Advise 'size' bytes at 'offset' of a memory view, a null 'size' extends the range to the end of the view */
+    void AdviseView(const IO::ResourceView &view, const IO::File::AccessHint hint, const std::size_t offset, const std::size_t size) noexcept
+    {
+        if (offset >= view.size())
+            return;
+        const auto count = size ? std::min(size, view.size() - offset) : view.size() - offset;
+        IO::Native::AdviseMapping(IO::ResourceView { .from = view.from + offset, .to = view.from + offset + count }, hint);
+    }
+}
+
 IO::File::File(const std::string_view &path, const Mode mode) noexcept
     : _path(path), _mode(mode)
 {
-    if (path.starts_with(ResourcePrefix)) {
-        const auto to = static_cast<std::uint32_t>(path.find('/', EnvironmentBeginIndex));
-        _environmentTo = to;
-        _environmentHash = Core::Hash(path.substr(EnvironmentBeginIndex, to - EnvironmentBeginIndex));
+    if (_path.isResource()) {
+        _environmentHash = Core::Hash(environment());
+        _resourcePathHash = Core::Hash(resourcePath());
+        if (ResourceManager::IsInitialized())
+            resolveResource();
     }
 }
 
+IO::File::File(const std::string_view &path, const Mode mode, HandlePool &pool) noexcept
+    : File(path, mode)
+{
+    if (!isResource() && !IsDirect(mode) && !IsAppend(mode))
+        _pool = &pool;
+}
+
+IO::File::~File(void) noexcept
+{
+    release();
+    disableStatistics();
+}
+
+IO::File::File(File &&other) noexcept
+    : _path(std::move(other._path))
+    , _environmentHash(other._environmentHash)
+    , _resourcePathHash(other._resourcePathHash)
+    , _mode(other._mode)
+    , _accessPattern(other._accessPattern)
+    , _offset(other._offset)
+    , _view(std::exchange(other._view, ResourceView {}))
+    , _content(std::move(other._content))
+    , _handle(other._handle.exchange(Native::InvalidHandle, std::memory_order_relaxed))
+    , _pool(std::exchange(other._pool, nullptr))
+    , _created(other._created.load(std::memory_order_relaxed))
+    , _direct(other._direct.exchange(false, std::memory_order_relaxed))
+    , _counters(std::exchange(other._counters, nullptr))
+{
+}
+
+IO::File &IO::File::operator=(File &&other) noexcept
+{
+    release();
+    _path = std::move(other._path);
+    _environmentHash = other._environmentHash;
+    _resourcePathHash = other._resourcePathHash;
+    _mode = other._mode;
+    _accessPattern = other._accessPattern;
+    _offset = other._offset;
+    _view = std::exchange(other._view, ResourceView {});
+    _content = std::move(other._content);
+    _handle.store(other._handle.exchange(Native::InvalidHandle, std::memory_order_relaxed), std::memory_order_relaxed);
+    _pool = std::exchange(other._pool, nullptr);
+    _created.store(other._created.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _direct.store(other._direct.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+    disableStatistics();
+    _counters = std::exchange(other._counters, nullptr);
+    return *this;
+}
+
 bool IO::File::resourceExists(void) const noexcept
 {
+    if (_view.from) [[likely]]
+        return true;
     return ResourceManager::Get().resourceExists(
         _environmentHash,
         resourcePath()
     );
 }
 
-IO::ResourceView IO::File::queryResource(void) const noexcept
+IO::ResourceData IO::File::queryResource(void) const noexcept
 {
-    return ResourceManager::Get().queryResource(
-        _environmentHash,
-        resourcePath()
-    );
+    if (_view.from) [[likely]]
+        return _content ? ResourceData(ContentBuffer(_content)) : ResourceData(_view);
+    return ResourceManager::Get().queryResource(resourceHandle(), resourcePath());
 }
 
 bool IO::File::exists(void) const noexcept
@@ -44,86 +114,290 @@ bool IO::File::exists(void) const noexcept
     if (isResource())
         return resourceExists();
     else
-        return std::filesystem::exists(std::filesystem::path(_path.toView()));
+        return std::filesystem::exists(std::filesystem::path(_path.view()));
 }
 
 std::size_t IO::File::fileSize(void) const noexcept
 {
     if (isResource())
-        return queryResource().size();
-    else if (_stream.is_open())
-        return _fileSize;
+        return _view.from ? _view.size() : ResourceManager::Get().resourceSize(resourceHandle(), resourcePath());
+    else if (const auto handle = _handle.load(std::memory_order_acquire); handle != Native::InvalidHandle)
+        return Native::Size(handle);
     else
-        return std::filesystem::file_size(_path.toView());
+        return std::filesystem::file_size(_path.view());
 }
 
 void IO::File::setOffset(const std::size_t offset) noexcept
 {
-    if (_offset != offset) {
-        _offset = offset;
-        if (!isResource())
-            _stream.seekg(static_cast<std::streamoff>(offset));
+    _offset = offset;
+}
+
+IO::ResourceView IO::File::map(void) noexcept
+{
+    if (isResource()) {
+        resolveResource();
+        // The file shares the decompressed content of compressed resources so the mapping outlives cache evictions
+        if (!_view.from) {
+            const auto data = ResourceManager::Get().queryResource(resourceHandle(), resourcePath());
+            _view = data.view();
+            _content = data.content();
+        }
+        return _view;
+    }
+    kFEnsure(IsMapped(_mode), "IO::File::map: File not opened for mapping");
+    Instrumentation::Scope scope(Instrumentation::Operation::Map, _path.view(), _counters);
+    const auto lease = ensureHandle();
+    const auto size = Native::Size(lease.handle());
+    if (size != _view.size()) {
+        _view = _view.from ? Native::Remap(lease.handle(), _view, size) : Native::Map(lease.handle(), size);
+        if (_accessPattern != AccessHint::Normal)
+            Native::AdviseMapping(_view, _accessPattern);
+    }
+    scope.setBytes(_view.size());
+    return _view;
+}
+
+void IO::File::unmap(void) noexcept
+{
+    if (isMapped()) {
+        Native::Unmap(_view);
+        _view = ResourceView {};
     }
 }
 
+void IO::File::advise(const AccessHint hint, const std::size_t offset, const std::size_t size) noexcept
+{
+    if (hint != AccessHint::WillNeed && hint != AccessHint::DontNeed)
+        _accessPattern = hint;
+    if (isResource()) {
+        resolveResource();
+        // Decompressed contents are heap memory shared with the decompression cache, discarding their pages would zero them
+        if (!_content)
+            AdviseView(_view, hint, offset, size);
+    } else if (isMapped())
+        AdviseView(_view, hint, offset, size);
+    // A hint is never worth aborting, missing files are ignored
+    else if (const auto lease = openHandle(); lease) [[likely]]
+        Native::Advise(lease.handle(), hint, offset, size);
+}
+
 std::size_t IO::File::read(std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) noexcept
 {
-    kFEnsure(Core::HasFlags(_mode, Mode::Read), "IO::File::write: File not opened for reading");
+    if (isResource())
+        resolveResource();
+    // Only query the file size when reading past the current mapping
+    else if (IsMapped(_mode) && offset + static_cast<std::size_t>(std::distance(from, to)) > _view.size())
+        static_cast<void>(map());
+    const auto readCount = readAt(from, to, offset);
+    _offset = offset + readCount;
+    return readCount;
+}
+
+std::size_t IO::File::readAt(std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept
+{
+    kFEnsure(Core::HasFlags(_mode, Mode::Read), "IO::File::readAt: File not opened for reading");
 
-    constexpr auto GetReadSize = [](const std::size_t offset, const std::size_t desired, const std::size_t size) {
-        if (offset < size) [[likely]]
-            return std::min(size - offset, desired);
-        else [[unlikely]]
+    constexpr auto CopyRange = [](const ResourceView &range, std::uint8_t * const from, const std::size_t count, const std::size_t offset) {
+        if (offset >= range.size()) [[unlikely]]
             return static_cast<std::size_t>(0ul);
+        const auto readCount = std::min(range.size() - offset, count);
+        const auto begin = range.begin() + offset;
+        std::copy(begin, begin + readCount, from);
+        return readCount;
     };
 
+    Instrumentation::Scope scope(Instrumentation::Operation::Read, _path.view(), _counters);
     const auto count = static_cast<std::size_t>(std::distance(from, to));
+    std::size_t readCount;
 
     if (isResource()) {
-        const auto range = queryResource();
-        const auto readCount = GetReadSize(offset, count, range.size());
-        if (readCount) [[likely]] {
-            const auto begin = range.begin() + offset;
-            std::copy(begin, begin + readCount, from);
-            _offset += readCount;
+        if (_view.from) [[likely]]
+            readCount = CopyRange(_view, from, count, offset);
+        // Compressed resources only decompress the blocks covering the range
+        else
+            readCount = ResourceManager::Get().readResource(resourceHandle(), resourcePath(), from, to, offset);
+    } else if (offset + count <= _view.size())
+        readCount = CopyRange(_view, from, count, offset);
+    else if (IsDirect(_mode)) {
+        const auto handle = ensureHandle().handle();
+        if (isUnbuffered()) [[likely]]
+            readCount = Direct::Read(handle, from, count, offset);
+        else {
+            readCount = Native::ReadAt(handle, from, count, offset);
+            Native::DropCache(handle, offset, readCount);
         }
-        return readCount;
-    } else {
-        ensureStream();
-        auto readCount = GetReadSize(offset, count, _fileSize);
-        if (readCount) [[likely]] {
-            setOffset(offset);
-            if (_stream.good()) {
-                _stream.read(reinterpret_cast<char *>(from), static_cast<std::streamoff>(readCount));
-                _offset += readCount;
-            } else
-                return 0u;
+    } else
+        readCount = Native::ReadAt(ensureHandle().handle(), from, count, offset);
+    scope.setBytes(readCount);
+    return readCount;
+}
+
+std::size_t IO::File::readVectored(const Core::IteratorRange<const BufferView *> &buffers, const std::size_t offset) noexcept
+{
+    if (isResource())
+        resolveResource();
+    else if (IsMapped(_mode)) {
+        std::size_t count {};
+        for (const auto &buffer : buffers)
+            count += buffer.size();
+        // Only query the file size when reading past the current mapping
+        if (offset + count > _view.size())
+            static_cast<void>(map());
+    }
+    const auto readCount = readVectoredAt(buffers, offset);
+    _offset = offset + readCount;
+    return readCount;
+}
+
+std::size_t IO::File::readVectoredAt(const Core::IteratorRange<const BufferView *> &buffers, const std::size_t offset) const noexcept
+{
+    kFEnsure(Core::HasFlags(_mode, Mode::Read), "IO::File::readVectoredAt: File not opened for reading");
+
+    // Resources and mappings are copied from memory, direct files have their own alignment rules
+    if (isResource() || _view.from || IsDirect(_mode)) {
+        std::size_t total {};
+        for (const auto &buffer : buffers) {
+            const auto readCount = readAt(buffer.from, buffer.to, offset + total);
+            total += readCount;
+            if (readCount != buffer.size())
+                break;
         }
-        return readCount;
+        return total;
     }
+
+    Instrumentation::Scope scope(Instrumentation::Operation::Read, _path.view(), _counters);
+    const auto readCount = Native::ReadVectorAt(ensureHandle().handle(), buffers.from, Core::Distance<std::uint32_t>(buffers.from, buffers.to), offset);
+    scope.setBytes(readCount);
+    return readCount;
 }
 
 bool IO::File::write(const std::uint8_t * const from, const std::uint8_t * const to, const std::size_t offset) noexcept
 {
     kFEnsure(!isResource(), "IO::File::write: Cannot write into resource file");
     kFEnsure(Core::HasFlags(_mode, Mode::Write), "IO::File::write: File not opened for writing");
-    ensureStream();
-    setOffset(offset);
-    const auto writeCount = std::distance(from, to);
-    _stream.write(reinterpret_cast<const char *>(from), writeCount);
-    _offset += std::size_t(writeCount);
-    return _stream.good();
+    if (IsAppend(_mode)) [[unlikely]]
+        return append(from, to);
+    Instrumentation::Scope scope(Instrumentation::Operation::Write, _path.view(), _counters);
+    const auto count = static_cast<std::size_t>(std::distance(from, to));
+    const auto lease = ensureHandle();
+    std::size_t writeCount;
+    if (!IsDirect(_mode)) [[likely]]
+        writeCount = Native::WriteAt(lease.handle(), from, count, offset);
+    else if (isUnbuffered())
+        writeCount = Direct::Write(lease.handle(), from, count, offset);
+    else {
+        writeCount = Native::WriteAt(lease.handle(), from, count, offset);
+        Native::StartSync(lease.handle());
+        Native::DropCache(lease.handle(), offset, writeCount);
+    }
+    scope.setBytes(writeCount);
+    _offset = offset + writeCount;
+    return writeCount == count;
+}
+
+bool IO::File::writeVectored(const Core::IteratorRange<const ResourceView *> &buffers, const std::size_t offset) noexcept
+{
+    kFEnsure(!isResource(), "IO::File::writeVectored: Cannot write into resource file");
+    kFEnsure(Core::HasFlags(_mode, Mode::Write), "IO::File::writeVectored: File not opened for writing");
+    if (IsAppend(_mode)) [[unlikely]]
+        return appendVectored(buffers);
+
+    std::size_t count {};
+    for (const auto &buffer : buffers)
+        count += buffer.size();
+    Instrumentation::Scope scope(Instrumentation::Operation::Write, _path.view(), _counters);
+    const auto lease = ensureHandle();
+    const auto bufferCount = Core::Distance<std::uint32_t>(buffers.from, buffers.to);
+    std::size_t writeCount;
+    if (!IsDirect(_mode)) [[likely]]
+        writeCount = Native::WriteVectorAt(lease.handle(), buffers.from, bufferCount, offset);
+    else if (isUnbuffered())
+        writeCount = Direct::WriteVector(lease.handle(), buffers.from, bufferCount, offset);
+    else {
+        writeCount = Native::WriteVectorAt(lease.handle(), buffers.from, bufferCount, offset);
+        Native::StartSync(lease.handle());
+        Native::DropCache(lease.handle(), offset, writeCount);
+    }
+    scope.setBytes(writeCount);
+    _offset = offset + writeCount;
+    return writeCount == count;
+}
+
+bool IO::File::append(const std::uint8_t * const from, const std::uint8_t * const to) noexcept
+{
+    kFEnsure(IsAppend(_mode), "IO::File::append: File not opened for appending");
+    Instrumentation::Scope scope(Instrumentation::Operation::Write, _path.view(), _counters);
+    const auto count = static_cast<std::size_t>(std::distance(from, to));
+    const auto writeCount = Native::Append(ensureHandle().handle(), from, count);
+    scope.setBytes(writeCount);
+    _offset += writeCount;
+    return writeCount == count;
+}
+
+bool IO::File::appendVectored(const Core::IteratorRange<const ResourceView *> &buffers) noexcept
+{
+    kFEnsure(IsAppend(_mode), "IO::File::appendVectored: File not opened for appending");
+    std::size_t count {};
+    for (const auto &buffer : buffers)
+        count += buffer.size();
+    Instrumentation::Scope scope(Instrumentation::Operation::Write, _path.view(), _counters);
+    const auto writeCount = Native::AppendVector(ensureHandle().handle(), buffers.from, Core::Distance<std::uint32_t>(buffers.from, buffers.to));
+    scope.setBytes(writeCount);
+    _offset += writeCount;
+    return writeCount == count;
+}
+
+bool IO::File::sync(const bool dataOnly) noexcept
+{
+    kFEnsure(!isResource(), "IO::File::sync: Cannot sync resource file");
+    kFEnsure(Core::HasFlags(_mode, Mode::Write), "IO::File::sync: File not opened for writing");
+    return Native::Sync(ensureHandle().handle(), dataOnly);
+}
+
+IO::Native::Handle IO::File::nativeHandle(void) const noexcept
+{
+    kFEnsure(!isResource(), "IO::File::nativeHandle: Resource files have no native handle");
+    return ensureHandle().handle();
+}
+
+IO::HandlePool::Lease IO::File::leaseHandle(void) const noexcept
+{
+    kFEnsure(!isResource(), "IO::File::leaseHandle: Resource files have no native handle");
+    return ensureHandle();
+}
+
+void IO::File::enableStatistics(void) noexcept
+{
+    if constexpr (Instrumentation::IsEnabled()) {
+        if (!_counters)
+            _counters = new (IOAllocator::Allocate(sizeof(Instrumentation::FileCounters), alignof(Instrumentation::FileCounters))) Instrumentation::FileCounters {};
+    }
+}
+
+void IO::File::disableStatistics(void) noexcept
+{
+    if (!_counters)
+        return;
+    _counters->~FileCounters();
+    IOAllocator::Deallocate(std::exchange(_counters, nullptr), sizeof(Instrumentation::FileCounters), alignof(Instrumentation::FileCounters));
+}
+
+IO::Instrumentation::Snapshot IO::File::statistics(void) const noexcept
+{
+    return _counters ? _counters->snapshot() : Instrumentation::Snapshot {};
+}
+
+void IO::File::resetStatistics(void) noexcept
+{
+    if (_counters)
+        _counters->reset();
 }
 
 bool kF::IO::File::copy(const std::string_view &destination) const noexcept
 {
     if (!exists())
         return false;
-    else if (isResource()) {
-        File copy(destination, Mode::WriteBinary);
-        return copy.writeAll(queryResource());
-    } else
-        return std::filesystem::copy_file(std::filesystem::path(_path.toView()), std::filesystem::path(destination));
+    return CopyFile(_path.view(), destination).status == CopyStatus::Success;
 }
 
 bool kF::IO::File::move(const std::string_view &destination) const noexcept
@@ -131,8 +405,10 @@ bool kF::IO::File::move(const std::string_view &destination) const noexcept
     if (isResource() || !exists()) {
         return false;
     } else {
+        if (_pool)
+            _pool->invalidate(_path.view());
         std::error_code code {};
-        std::filesystem::rename(std::filesystem::path(_path.toView()), std::filesystem::path(destination), code);
+        std::filesystem::rename(std::filesystem::path(_path.view()), std::filesystem::path(destination), code);
         return !code;
     }
 }
@@ -141,19 +417,76 @@ bool kF::IO::File::remove(void) const noexcept
 {
     if (isResource() || !exists())
         return false;
-    else
-        return std::filesystem::remove(std::filesystem::path(_path.toView()));
+    if (_pool)
+        _pool->invalidate(_path.view());
+    return std::filesystem::remove(std::filesystem::path(_path.view()));
 }
 
-void kF::IO::File::ensureStream(void) noexcept
+void kF::IO::File::resolveResource(void) noexcept
 {
-    if (!_stream.is_open()) {
-        auto mode
-            = (Core::HasFlags(_mode, Mode::Write) ? std::ios::out : std::ios::openmode())
-            | (Core::HasFlags(_mode, Mode::Read) ? std::ios::in : std::ios::openmode())
-            | (IsBinary(_mode) ? std::ios::binary : std::ios::openmode());
-        _stream.open(std::filesystem::path(_path.toView()), mode);
-        kFEnsure(_stream.good(), "UI::File::ensureStream: Stream opened with invalid file path '", _path, '\'');
-        _fileSize = std::filesystem::file_size(_path.toView());
+    // Compressed resources are only decompressed as a whole when mapped, reads decode the blocks they cover
+    if (!_view.from && !ResourceManager::Get().isCompressed(resourceHandle(), resourcePath()))
+        _view = ResourceManager::Get().queryResource(resourceHandle(), resourcePath()).view();
+}
+
+bool IO::File::tryOpen(void) const noexcept
+{
+    kFEnsure(!isResource(), "IO::File::tryOpen: Resource files have no native handle");
+    return static_cast<bool>(openHandle());
+}
+
+IO::HandlePool::Lease kF::IO::File::ensureHandle(void) const noexcept
+{
+    auto lease = openHandle();
+    kFEnsure(lease, "IO::File::ensureHandle: Handle opened with invalid file path '", _path.view(), '\'');
+    return lease;
+}
+
+IO::HandlePool::Lease kF::IO::File::openHandle(void) const noexcept
+{
+    const bool read = Core::HasFlags(_mode, Mode::Read);
+    const bool write = Core::HasFlags(_mode, Mode::Write);
+    if (_pool) {
+        // Pooled handles never truncate, write-only files are truncated once like an unpooled open would
+        if (write && !read && !_created.load(std::memory_order_acquire)) {
+            const auto handle = Native::Open(_path.view(), false, true);
+            if (handle == Native::InvalidHandle) [[unlikely]]
+                return HandlePool::Lease();
+            Native::Close(handle);
+            _created.store(true, std::memory_order_release);
+        }
+        return _pool->acquire(_path.view(), write);
     }
-}
\ No newline at end of file
+
+    auto handle = _handle.load(std::memory_order_acquire);
+    if (handle != Native::InvalidHandle) [[likely]]
+        return HandlePool::Lease(handle);
+
+    // Several threads may race to open the file, only the first one keeps its handle
+    Instrumentation::Scope scope(Instrumentation::Operation::Open, _path.view(), _counters);
+    bool direct {};
+    if (IsDirect(_mode))
+        handle = Native::OpenDirect(_path.view(), read, write, direct);
+    else if (IsAppend(_mode))
+        handle = Native::OpenAppend(_path.view());
+    else
+        handle = Native::Open(_path.view(), read, write);
+    if (handle == Native::InvalidHandle) [[unlikely]]
+        return HandlePool::Lease();
+    auto expected = Native::InvalidHandle;
+    _direct.store(direct, std::memory_order_release); // Racing opens of a same path share their file system
+    if (_handle.compare_exchange_strong(expected, handle, std::memory_order_acq_rel)) [[likely]] {
+        if (_accessPattern != AccessHint::Normal)
+            Native::Advise(handle, _accessPattern, 0, 0);
+        return HandlePool::Lease(handle);
+    }
+    Native::Close(handle);
+    return HandlePool::Lease(expected);
+}
+
+void kF::IO::File::release(void) noexcept
+{
+    unmap();
+    if (const auto handle = _handle.exchange(Native::InvalidHandle, std::memory_order_acq_rel); handle != Native::InvalidHandle)
+        Native::Close(handle);
+}
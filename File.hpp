@@ -9,8 +9,14 @@
 #include <Kube/Core/SmallString.hpp>
 
 #include "Base.hpp"
+#include "HandlePool.hpp"
+#include "Instrumentation.hpp"
+#include "Native.hpp"
+#include "Path.hpp"
+#include "ResourceData.hpp"
 
-#include <fstream>
+#include <atomic>
+#include <initializer_list>
 
 namespace kF::IO
 {
@@ -49,16 +55,37 @@ public:
         ReadAndWrite        = 0b0000011,
         ReadBinary          = 0b0000101,
         WriteBinary         = 0b0000110,
-        ReadAndWriteBinary  = 0b0000111
+        ReadAndWriteBinary  = 0b0000111,
+        ReadMapped          = 0b0001101,
+        ReadDirect          = 0b0010101,
+        WriteDirect         = 0b0010110,
+        ReadAndWriteDirect  = 0b0010111,
+        Append              = 0b0100010
     };
 
+    /** @brief Hint about how a file range will be accessed (see 'advise') */
+    using AccessHint = Native::AccessHint;
+
+
     /** @brief Check if a mode is binary */
     [[nodiscard]] static constexpr bool IsBinary(const Mode mode) noexcept
         { return Core::ToUnderlying(mode) & Core::ToUnderlying(Core::RemoveFlags(Mode::ReadAndWriteBinary, Mode::Read, Mode::Write)); }
 
+    /** @brief Check if a mode is memory mapped */
+    [[nodiscard]] static constexpr bool IsMapped(const Mode mode) noexcept
+        { return Core::ToUnderlying(mode) & Core::ToUnderlying(Core::RemoveFlags(Mode::ReadMapped, Mode::ReadBinary)); }
+
+    /** @brief Check if a mode only appends */
+    [[nodiscard]] static constexpr bool IsAppend(const Mode mode) noexcept
+        { return Core::ToUnderlying(mode) & Core::ToUnderlying(Core::RemoveFlags(Mode::Append, Mode::Write)); }
+
+    /** @brief Check if a mode bypasses the page cache */
+    [[nodiscard]] static constexpr bool IsDirect(const Mode mode) noexcept
+        { return Core::ToUnderlying(mode) & Core::ToUnderlying(Core::RemoveFlags(Mode::ReadAndWriteDirect, Mode::ReadAndWriteBinary)); }
+
 
     /** @brief Destructor */
-    ~File(void) noexcept = default;
+    ~File(void) noexcept;
 
     /** @brief Default constructor */
     File(void) noexcept = default;
@@ -67,22 +94,36 @@ public:
     File(const File &path) noexcept = delete;
 
     /** @brief Move constructor */
-    File(File &&path) noexcept = default;
+    File(File &&other) noexcept;
 
     /** @brief Set file of given 'path' */
     File(const std::string_view &path, const Mode mode = Mode::None) noexcept;
 
+    /** @brief Set file of given 'path' whose native handle is borrowed from 'pool' on each access
+     *  @note The handle may be closed by the pool between two accesses and is reopened transparently
+     *  @note Direct and append files are never pooled */
+    File(const std::string_view &path, const Mode mode, HandlePool &pool) noexcept;
+
     /** @brief Deleted copy assignment */
     File &operator=(const File &path) noexcept = delete;
 
     /** @brief Move assignment */
-    File &operator=(File &&path) noexcept = default;
+    File &operator=(File &&other) noexcept;
 
 
     /** @brief Get file path */
     template<typename StringType = std::string_view>
         requires std::constructible_from<StringType, std::string_view>
-    [[nodiscard]] StringType path(void) const noexcept { return _path; }
+    [[nodiscard]] StringType path(void) const noexcept { return StringType(_path.view()); }
+
+    /** @brief Get the path with its precomputed components */
+    [[nodiscard]] inline const Path &pathComponents(void) const noexcept { return _path; }
+
+    /** @brief Get open mode */
+    [[nodiscard]] inline Mode mode(void) const noexcept { return _mode; }
+
+    /** @brief Get the handle pool of the file, if any */
+    [[nodiscard]] inline HandlePool *handlePool(void) const noexcept { return _pool; }
 
     /** @brief Get file name with its extension */
     template<typename StringType = std::string_view>
@@ -108,7 +149,7 @@ public:
 
     /** @brief Get environment name */
     [[nodiscard]] inline std::string_view environment(void) const noexcept
-        { return _path.toView().substr(EnvironmentBeginIndex, _environmentTo - EnvironmentBeginIndex); }
+        { return _path.environment(); }
 
 
     /** @brief Check if resource exists */
@@ -116,10 +157,19 @@ public:
 
     /** @brief Get resource path */
     [[nodiscard]] inline std::string_view resourcePath(void) const noexcept
-        { return _path.toView().substr(_environmentTo + 1); }
+        { return _path.resourcePath(); }
+
+    /** @brief Get precomputed resource handle */
+    [[nodiscard]] inline ResourceHandle resourceHandle(void) const noexcept
+        { return ResourceHandle { .environment = _environmentHash, .path = _resourcePathHash }; }
 
-    /** @brief Query a resource */
-    [[nodiscard]] ResourceView queryResource(void) const noexcept;
+    /** @brief Query a resource
+     *  @note The resolved view is cached, use 'invalidateResource' if environments changed
+     *  @note Compressed resources are only cached by the file once mapped, see 'ResourceManager::queryResource' */
+    [[nodiscard]] ResourceData queryResource(void) const noexcept;
+
+    /** @brief Drop the cached resource view, the next access resolves it again */
+    inline void invalidateResource(void) noexcept { if (isResource()) { _view = ResourceView {}; _content.release(); } }
 
 
     /** @brief Check if the file exists */
@@ -129,13 +179,48 @@ public:
     [[nodiscard]] std::size_t fileSize(void) const noexcept;
 
 
-    /** @brief Get current offset */
+    /** @brief Get current offset
+     *  @note Append files only count the bytes appended through this instance */
     [[nodiscard]] std::size_t offset(void) const noexcept { return _offset; }
 
     /** @brief Set or write offset */
     void setOffset(const std::size_t offset) noexcept;
 
 
+    /** @brief Map the whole file into memory and get a zero-copy view over it
+     *  @note Resource files always return their embedded view
+     *  @note Disk files must be opened with 'Mode::ReadMapped'
+     *  @note If the file grew since the last call, the mapping is resized and previous views are invalidated */
+    [[nodiscard]] ResourceView map(void) noexcept;
+
+    /** @brief Release the memory mapping (if any)
+     *  @note Any view returned by 'map' is invalidated */
+    void unmap(void) noexcept;
+
+    /** @brief Check if the file is currently memory mapped */
+    [[nodiscard]] inline bool isMapped(void) const noexcept { return !isResource() && _view.from; }
+
+
+    /** @brief Check if the opened native handle bypasses the page cache
+     *  @note Direct files fall back to buffered transfers, dropping the cached pages after each access,
+     *      on file systems that don't support unbuffered handles */
+    [[nodiscard]] inline bool isUnbuffered(void) const noexcept { return _direct.load(std::memory_order_acquire); }
+
+
+    /** @brief Give the system a hint about how 'size' bytes at 'offset' will be accessed
+     *  @note A null 'size' extends the range to the end of the file
+     *  @note 'Normal', 'Sequential' and 'Random' set the access pattern of the whole file,
+     *      it is applied again whenever the file is reopened or remapped, except for pooled handles
+     *  @note Mapped and resource files advise their memory, compressed resources ignore hints */
+    void advise(const AccessHint hint, const std::size_t offset = 0, const std::size_t size = 0) noexcept;
+
+    /** @brief Start loading 'size' bytes at 'offset' ahead of their use, without waiting for them */
+    inline void prefetch(const std::size_t offset, const std::size_t size) noexcept { advise(AccessHint::WillNeed, offset, size); }
+
+    /** @brief Get the access pattern of the whole file */
+    [[nodiscard]] inline AccessHint accessPattern(void) const noexcept { return _accessPattern; }
+
+
     /** @brief Read data and store it into range (use internal offset) */
     [[nodiscard]] inline std::size_t read(std::uint8_t * const from, std::uint8_t * const to) noexcept
         { return read(from, to, _offset); }
@@ -144,6 +229,25 @@ public:
      *  @param offset Offset in byte from where to start reading the file */
     [[nodiscard]] std::size_t read(std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) noexcept;
 
+    /** @brief Read data at 'offset' and store it into range without using nor changing the internal offset
+     *  @note This function is thread-safe, several threads can read disjoint ranges of the same file concurrently
+     *  @note Mapped files only read from the current mapping, use 'map' to take file growth into account
+     *  @note Direct files transfer aligned ranges straight into 'from' when it is aligned (see 'Direct::Allocator') */
+    [[nodiscard]] std::size_t readAt(std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept;
+
+    /** @brief Read data scattering it into several buffers, in order (use internal offset) */
+    [[nodiscard]] inline std::size_t readVectored(const Core::IteratorRange<const BufferView *> &buffers) noexcept
+        { return readVectored(buffers, _offset); }
+
+    /** @brief Read data at 'offset' scattering it into several buffers, in order
+     *  @return The number of bytes read across all buffers */
+    [[nodiscard]] std::size_t readVectored(const Core::IteratorRange<const BufferView *> &buffers, const std::size_t offset) noexcept;
+
+    /** @brief Read data at 'offset' scattering it into several buffers without using nor changing the internal offset
+     *  @note Disk files read every buffer in a single system call (preadv), resource, mapped and direct files read them one by one
+     *  @note This function is thread-safe like 'readAt' */
+    [[nodiscard]] std::size_t readVectoredAt(const Core::IteratorRange<const BufferView *> &buffers, const std::size_t offset) const noexcept;
+
     /** @brief Read all file data and store it into custom container */
     template<kF::IO::Internal::ResizableContainer Container>
     [[nodiscard]] bool readAll(Container &container) noexcept;
@@ -160,15 +264,87 @@ public:
 
     /** @brief Write data range to file
      *  @param offset Offset in byte from where to start reading the file
-     *  @note Resource files are read-only */
+     *  @note Resource files are read-only
+     *  @note Direct files patch partially covered blocks, concurrent writes to a same block must be serialized
+     *  @note Append files ignore 'offset' and append */
     [[nodiscard]] bool write(const std::uint8_t * const from, const std::uint8_t * const to, const std::size_t offset) noexcept;
 
+    /** @brief Write several buffers one after another (use internal offset) */
+    [[nodiscard]] inline bool writeVectored(const Core::IteratorRange<const ResourceView *> &buffers) noexcept
+        { return writeVectored(buffers, _offset); }
+
+    /** @brief Write several buffers one after another */
+    [[nodiscard]] inline bool writeVectored(const std::initializer_list<ResourceView> &buffers) noexcept
+        { return writeVectored(Core::IteratorRange<const ResourceView *> { .from = buffers.begin(), .to = buffers.end() }, _offset); }
+
+    /** @brief Write several buffers one after another at 'offset'
+     *  @note Disk files write every buffer in a single system call (pwritev),
+     *      direct files gather neighbouring unaligned buffers so partially covered blocks are patched once
+     *  @note Resource files are read-only */
+    [[nodiscard]] bool writeVectored(const Core::IteratorRange<const ResourceView *> &buffers, const std::size_t offset) noexcept;
+
+    /** @brief Write several buffers one after another at 'offset' */
+    [[nodiscard]] inline bool writeVectored(const std::initializer_list<ResourceView> &buffers, const std::size_t offset) noexcept
+        { return writeVectored(Core::IteratorRange<const ResourceView *> { .from = buffers.begin(), .to = buffers.end() }, offset); }
+
     /** @brief Read all file data and store it into custom container */
     template<kF::IO::Internal::WritableContainer Container>
     [[nodiscard]] bool writeAll(const Container &container) noexcept;
 
 
-    /** @brief Copy file to another location */
+    /** @brief Append data range to the end of a file opened with 'Mode::Append', without seeking
+     *  @note Each call appends atomically with regard to other appenders of the file (O_APPEND) */
+    [[nodiscard]] bool append(const std::uint8_t * const from, const std::uint8_t * const to) noexcept;
+
+    /** @brief Append several buffers one after another in a single call (writev) */
+    [[nodiscard]] bool appendVectored(const Core::IteratorRange<const ResourceView *> &buffers) noexcept;
+
+    /** @brief Append several buffers one after another in a single call */
+    [[nodiscard]] inline bool appendVectored(const std::initializer_list<ResourceView> &buffers) noexcept
+        { return appendVectored(Core::IteratorRange<const ResourceView *> { .from = buffers.begin(), .to = buffers.end() }); }
+
+
+    /** @brief Flush written data to the storage device
+     *  @param dataOnly Skip metadata that isn't required to read the data back (e.g. modification time) */
+    [[nodiscard]] bool sync(const bool dataOnly = false) noexcept;
+
+
+    /** @brief Open the native handle of a disk file if required, without aborting on failure
+     *  @note Any other access to a file which can't be opened is fatal
+     *  @return False if the file couldn't be opened */
+    [[nodiscard]] bool tryOpen(void) const noexcept;
+
+    /** @brief Get the native handle of a disk file, opening it if required
+     *  @note Resource files have no native handle
+     *  @note The handle of a pooled file may be closed by its pool at any time, use 'leaseHandle' to keep it opened */
+    [[nodiscard]] Native::Handle nativeHandle(void) const noexcept;
+
+    /** @brief Lease the native handle of a disk file, opening it if required
+     *  @note The handle of a pooled file stays opened until the lease is released */
+    [[nodiscard]] HandlePool::Lease leaseHandle(void) const noexcept;
+
+
+    /** @brief Count the operations made through this file, on top of the per-thread instrumentation
+     *  @note Counters are shared by every thread using the file, enabling or disabling them must not race with other accesses
+     *  @note Does nothing when instrumentation is compiled out */
+    void enableStatistics(void) noexcept;
+
+    /** @brief Stop counting the operations made through this file */
+    void disableStatistics(void) noexcept;
+
+    /** @brief Check if the operations made through this file are counted */
+    [[nodiscard]] inline bool hasStatistics(void) const noexcept { return _counters; }
+
+    /** @brief Get the totals of the operations made through this file since its statistics were enabled or reset
+     *  @note System calls are only counted per thread */
+    [[nodiscard]] Instrumentation::Snapshot statistics(void) const noexcept;
+
+    /** @brief Reset the statistics of the file */
+    void resetStatistics(void) noexcept;
+
+
+    /** @brief Copy file to another location
+     *  @note Use 'CopyFile' for progress reporting and cancellation */
     bool copy(const std::string_view &destination) const noexcept;
 
     /** @brief Move file
@@ -180,16 +356,33 @@ public:
 
 
 private:
-    /** @brief Ensure that this instance has an allocated stream */
-    void ensureStream(void) noexcept;
+    /** @brief Ensure that this instance has an opened native handle (thread-safe)
+     *  @note A pooled handle stays opened until the returned lease is released */
+    HandlePool::Lease ensureHandle(void) const noexcept;
+
+    /** @brief Open the native handle if required (thread-safe)
+     *  @return An invalid lease on failure */
+    HandlePool::Lease openHandle(void) const noexcept;
+
+    /** @brief Resolve and cache the resource view if not already cached */
+    void resolveResource(void) noexcept;
+
+    /** @brief Release the mapping and the native handle */
+    void release(void) noexcept;
 
-    Core::SmallString<IOAllocator> _path {};
+    Path _path {};
     Core::HashedName _environmentHash {};
-    std::uint32_t _environmentTo {};
+    Core::HashedName _resourcePathHash {};
     Mode _mode {};
+    AccessHint _accessPattern {};
     std::size_t _offset {};
-    std::size_t _fileSize {};
-    std::fstream _stream {};
+    ResourceView _view {}; // Mapping of a disk file or cached view of a resource
+    ContentBuffer _content {}; // Decompressed content of a mapped compressed resource
+    mutable std::atomic<Native::Handle> _handle { Native::InvalidHandle }; // Unused by pooled files
+    HandlePool *_pool {};
+    mutable std::atomic<bool> _created {}; // Pooled write-only files are created and truncated on first access
+    mutable std::atomic<bool> _direct {}; // Opened handle bypasses the page cache
+    Instrumentation::FileCounters *_counters {}; // Only allocated once statistics are enabled
 };
 
 #include "File.ipp"
\ No newline at end of file
@@ -11,38 +11,21 @@ template<typename StringType>
     requires std::constructible_from<StringType, std::string_view>
 inline StringType kF::IO::File::filenameWithExtension(void) const noexcept
 {
-    if (_path.empty())
-        return StringType();
-    auto index = _path.size();
-    while (--index && ((_path[index] != '/') & (_path[index] != '\\')));
-    index = bool(index) * (index + 1); // Only increment by 1 if not zero
-    return _path.toView().substr(index);
+    return StringType(_path.filenameWithExtension());
 }
 
 template<typename StringType>
     requires std::constructible_from<StringType, std::string_view>
 inline StringType kF::IO::File::filename(void) const noexcept
 {
-    const auto file = filenameWithExtension();
-    auto index = file.size();
-    while (--index) {
-        if (file[index] == '.')
-            return file.substr(0, index);
-        else if ((file[index] == '/') | (file[index] == '\\'))
-            break;
-    }
-    return file;
+    return StringType(_path.filename());
 }
 
 template<typename StringType>
     requires std::constructible_from<StringType, std::string_view>
 inline StringType kF::IO::File::directoryPath(void) const noexcept
 {
-    if (_path.empty())
-        return StringType();
-    auto index = _path.size();
-    while (--index && ((_path[index] != '/') & (_path[index] != '\\')));
-    return _path.toView().substr(0, index);
+    return StringType(_path.directoryPath());
 }
 
 template<kF::IO::Internal::ResizableContainer Container>
@@ -50,13 +33,16 @@ inline bool kF::IO::File::readAll(Container &container) noexcept
 {
     using Range = decltype(std::declval<Container>().size());
 
-    if (!isResource())
-        ensureStream();
+    if (isResource())
+        resolveResource();
+    else
+        ensureHandle();
     const auto expectedSize = fileSize();
     container.resize(static_cast<Range>(expectedSize));
     const auto readSize = read(
         reinterpret_cast<std::uint8_t *>(container.data()),
-        reinterpret_cast<std::uint8_t *>(container.data()) + expectedSize
+        reinterpret_cast<std::uint8_t *>(container.data()) + expectedSize,
+        0u
     );
     return readSize == expectedSize;
 }
@@ -0,0 +1,40 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO FileArena
+ */
+
+#include "FileArena.hpp"
+#include "ResourceManager.hpp"
+
+using namespace kF;
+
+IO::Internal::ArenaEntry IO::Internal::StatArenaEntry(const std::string_view &path) noexcept
+{
+    if (path.starts_with(ResourcePrefix)) {
+        const auto resource = MakeResourceHandle(path);
+        const auto separator = path.find('/', EnvironmentBeginIndex);
+        if (separator == std::string_view::npos) [[unlikely]]
+            return ArenaEntry {};
+        const auto resourcePath = path.substr(separator + 1);
+        auto &manager = ResourceManager::Get();
+        if (!manager.environmentExists(resource.environment) || !manager.resourceExists(resource, resourcePath)) [[unlikely]]
+            return ArenaEntry {};
+        return ArenaEntry { .resource = resource, .size = manager.resourceSize(resource, resourcePath), .exists = true };
+    }
+    ArenaEntry entry;
+    entry.exists = Native::SizeOf(path, entry.size);
+    return entry;
+}
+
+std::size_t IO::Internal::ReadArenaEntry(const std::string_view &path, const ArenaEntry &entry, std::uint8_t * const data) noexcept
+{
+    if (entry.resource.environment)
+        return ResourceManager::Get().readResource(entry.resource, path.substr(path.find('/', EnvironmentBeginIndex) + 1), data, data + entry.size, 0u);
+
+    const auto handle = Native::Open(path, true, false);
+    if (handle == Native::InvalidHandle) [[unlikely]]
+        return 0u;
+    const auto count = Native::ReadAt(handle, data, entry.size, 0u);
+    Native::Close(handle);
+    return count;
+}
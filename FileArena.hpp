@@ -0,0 +1,105 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO FileArena
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Native.hpp"
+
+namespace kF::IO
+{
+    template<typename Allocator = IOAllocator>
+    class FileArena;
+
+    namespace Internal
+    {
+        /** @brief A file of a bulk load, stated but not read yet */
+        struct ArenaEntry
+        {
+            ResourceHandle resource {};
+            std::size_t size {};
+            bool exists {};
+        };
+
+        /** @brief Stat a disk or resource file without opening it, 'exists' is false if it can't be loaded */
+        [[nodiscard]] ArenaEntry StatArenaEntry(const std::string_view &path) noexcept;
+
+        /** @brief Read a stated file into 'data' (at least 'entry.size' bytes)
+         *  @return The number of bytes read */
+        [[nodiscard]] std::size_t ReadArenaEntry(const std::string_view &path, const ArenaEntry &entry, std::uint8_t * const data) noexcept;
+    }
+}
+
+/** @brief Load many files into a single uninitialized allocation
+ *
+ *  Every file is stated first (without opening it, so any number of files can be loaded),
+ *  then one arena is allocated and each file is opened and read into its own aligned slice.
+ *  Loading N files costs a single allocation and no zero-initialization, releasing them is a single free.
+ *  @tparam Allocator Static allocator of the arena and of its views */
+template<typename Allocator>
+class kF::IO::FileArena
+{
+public:
+    /** @brief Default alignment of each file slice */
+    static constexpr std::size_t DefaultAlignment = alignof(std::max_align_t);
+
+
+    /** @brief Destructor */
+    inline ~FileArena(void) noexcept { release(); }
+
+    /** @brief Default constructor */
+    FileArena(void) noexcept = default;
+
+    /** @brief Move constructor */
+    inline FileArena(FileArena &&other) noexcept { swap(other); }
+
+    /** @brief Move assignment */
+    inline FileArena &operator=(FileArena &&other) noexcept { swap(other); return *this; }
+
+    /** @brief FileArena is not copyable */
+    FileArena(const FileArena &other) noexcept = delete;
+    FileArena &operator=(const FileArena &other) noexcept = delete;
+
+
+    /** @brief Swap two arenas */
+    void swap(FileArena &other) noexcept;
+
+
+    /** @brief Load every file of 'paths' (disk or resource) into the arena, replacing its previous content
+     *  @note The view of a file that couldn't be loaded is empty, the view of a file that shrank is truncated
+     *  @return True if every file was loaded entirely */
+    template<typename Range>
+    [[nodiscard]] bool load(const Range &paths, const std::size_t alignment = DefaultAlignment) noexcept;
+
+    /** @brief Release the arena */
+    void release(void) noexcept;
+
+
+    /** @brief Get the number of loaded files */
+    [[nodiscard]] inline std::size_t count(void) const noexcept { return _views.size(); }
+
+    /** @brief Get the view of the file at 'index' of the loaded paths */
+    [[nodiscard]] inline const ResourceView &operator[](const std::size_t index) const noexcept { return _views[index]; }
+
+    /** @brief Begin / end iterators over file views */
+    [[nodiscard]] inline const ResourceView *begin(void) const noexcept { return _views.begin(); }
+    [[nodiscard]] inline const ResourceView *end(void) const noexcept { return _views.end(); }
+
+
+    /** @brief Get the arena data */
+    [[nodiscard]] inline const std::uint8_t *data(void) const noexcept { return _data; }
+
+    /** @brief Get the arena size in bytes, including alignment padding */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _size; }
+
+private:
+    std::uint8_t *_data {};
+    std::size_t _size {};
+    std::size_t _alignment {};
+    Core::Vector<ResourceView, Allocator, std::size_t> _views {};
+};
+
+#include "FileArena.ipp"
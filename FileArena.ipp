@@ -0,0 +1,66 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO FileArena
+ */
+
+#pragma once
+
+#include <Kube/Core/Utils.hpp>
+
+#include "FileArena.hpp"
+
+template<typename Allocator>
+inline void kF::IO::FileArena<Allocator>::swap(FileArena &other) noexcept
+{
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    std::swap(_alignment, other._alignment);
+    std::swap(_views, other._views);
+}
+
+template<typename Allocator>
+template<typename Range>
+inline bool kF::IO::FileArena<Allocator>::load(const Range &paths, const std::size_t alignment) noexcept
+{
+    release();
+
+    // Stat every file first so the arena is allocated once
+    Core::Vector<Internal::ArenaEntry, Allocator, std::size_t> entries;
+    entries.reserve(static_cast<std::size_t>(std::distance(std::begin(paths), std::end(paths))));
+    std::size_t size {};
+    for (const auto &path : paths) {
+        entries.push(Internal::StatArenaEntry(std::string_view(path)));
+        size = Core::AlignPowerOf2(size, alignment) + entries.back().size;
+    }
+
+    _alignment = alignment;
+    _size = size;
+    if (size)
+        _data = reinterpret_cast<std::uint8_t *>(Allocator::Allocate(size, alignment));
+    _views.resize(entries.size());
+
+    bool success = true;
+    std::size_t offset {};
+    std::size_t index {};
+    for (const auto &path : paths) {
+        const auto &entry = entries[index];
+        offset = Core::AlignPowerOf2(offset, alignment);
+        const auto data = _data + offset;
+        const auto count = entry.exists ? Internal::ReadArenaEntry(std::string_view(path), entry, data) : 0ul;
+        _views[index] = ResourceView { .from = data, .to = data + count };
+        success &= entry.exists && count == entry.size;
+        offset += entry.size;
+        ++index;
+    }
+    return success;
+}
+
+template<typename Allocator>
+inline void kF::IO::FileArena<Allocator>::release(void) noexcept
+{
+    if (_data)
+        Allocator::Deallocate(_data, _size, _alignment);
+    _data = nullptr;
+    _size = 0u;
+    _views.clear();
+}
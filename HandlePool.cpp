@@ -0,0 +1,234 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO HandlePool
+ */
+
+#include <algorithm>
+
+#include <Kube/Core/Abort.hpp>
+#include <Kube/Core/Hash.hpp>
+
+#include "HandlePool.hpp"
+#include "Instrumentation.hpp"
+
+using namespace kF;
+
+IO::HandlePool::~HandlePool(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    for (auto slot = 0u; slot != _slots.size(); ++slot) {
+        if (_slots[slot].key == FreeKey)
+            continue;
+        kFEnsure(!_slots[slot].pins,
+            "IO::HandlePool: Pool destroyed while a handle is leased");
+        close(slot);
+    }
+}
+
+IO::HandlePool::HandlePool(const std::uint32_t capacity) noexcept
+    : _capacity(std::max(capacity, 1u))
+{
+}
+
+IO::HandlePool::Lease IO::HandlePool::acquire(const std::string_view &path, const bool write) noexcept
+{
+    const auto key = MakeKey(Core::Hash(path), write);
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (const auto slot = find(key, path); slot != NullSlot) {
+            ++_statistics.hits;
+            pin(slot);
+            return Lease(this, slot, _slots[slot].handle);
+        }
+        ++_statistics.misses;
+    }
+
+    // Opening may block on slow file systems, other files keep being served meanwhile
+    Native::Handle handle;
+    {
+        Instrumentation::Scope scope(Instrumentation::Operation::Open, path);
+        handle = Native::Open(path, true, write);
+    }
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (handle == Native::InvalidHandle) [[unlikely]] {
+        ++_statistics.failures;
+        return Lease();
+    }
+    // Another thread may have opened the same file in the meantime
+    if (const auto slot = find(key, path); slot != NullSlot) [[unlikely]] {
+        Native::Close(handle);
+        pin(slot);
+        return Lease(this, slot, _slots[slot].handle);
+    }
+    evict(1u);
+    const auto slot = insert(key, path, handle);
+    return Lease(this, slot, handle);
+}
+
+void IO::HandlePool::invalidate(const std::string_view &path) noexcept
+{
+    const auto hash = Core::Hash(path);
+    std::lock_guard<std::mutex> guard(_mutex);
+    for (const auto write : { false, true }) {
+        if (const auto slot = find(MakeKey(hash, write), path); slot != NullSlot && !_slots[slot].pins)
+            close(slot);
+    }
+}
+
+void IO::HandlePool::clear(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    while (_unusedHead != NullSlot)
+        close(_unusedHead);
+}
+
+std::uint32_t IO::HandlePool::capacity(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _capacity;
+}
+
+void IO::HandlePool::setCapacity(const std::uint32_t capacity) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _capacity = std::max(capacity, 1u);
+    evict(0u);
+}
+
+std::uint32_t IO::HandlePool::size(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _size;
+}
+
+IO::HandlePool::Statistics IO::HandlePool::statistics(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _statistics;
+}
+
+void IO::HandlePool::resetStatistics(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _statistics = Statistics {};
+}
+
+std::uint32_t IO::HandlePool::find(const std::uint64_t key, const std::string_view &path) const noexcept
+{
+    if (_buckets.empty())
+        return NullSlot;
+    auto slot = _buckets[static_cast<std::uint32_t>(key) & (_buckets.size() - 1u)];
+    while (slot != NullSlot && (_slots[slot].key != key || _slots[slot].path.toView() != path)) [[unlikely]]
+        slot = _slots[slot].nextInBucket;
+    return slot;
+}
+
+std::uint32_t IO::HandlePool::insert(const std::uint64_t key, const std::string_view &path, const Native::Handle handle) noexcept
+{
+    std::uint32_t slot;
+    if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop();
+    } else {
+        slot = _slots.size();
+        _slots.push(Slot {});
+        if (_slots.size() > _buckets.size())
+            rehash();
+    }
+    auto &bucket = _buckets[static_cast<std::uint32_t>(key) & (_buckets.size() - 1u)];
+    auto &entry = _slots[slot];
+    entry.path = path;
+    entry.handle = handle;
+    entry.key = key;
+    entry.nextInBucket = bucket;
+    entry.pins = 1u;
+    bucket = slot;
+    ++_size;
+    return slot;
+}
+
+void IO::HandlePool::rehash(void) noexcept
+{
+    auto count = std::max(_buckets.size(), 16u);
+    while (count < _slots.size())
+        count *= 2u;
+    _buckets.clear();
+    _buckets.resize(count, NullSlot);
+    for (auto slot = 0u; slot != _slots.size(); ++slot) {
+        auto &entry = _slots[slot];
+        if (entry.key == FreeKey)
+            continue;
+        auto &bucket = _buckets[static_cast<std::uint32_t>(entry.key) & (count - 1u)];
+        entry.nextInBucket = bucket;
+        bucket = slot;
+    }
+}
+
+void IO::HandlePool::pin(const std::uint32_t slot) noexcept
+{
+    if (!_slots[slot].pins++)
+        unlinkUnused(slot);
+}
+
+void IO::HandlePool::unpin(const std::uint32_t slot) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (!--_slots[slot].pins)
+        linkUnused(slot);
+    // The pool may have grown past its capacity while every handle was leased
+    evict(0u);
+}
+
+void IO::HandlePool::linkUnused(const std::uint32_t slot) noexcept
+{
+    auto &entry = _slots[slot];
+    entry.previousUnused = _unusedTail;
+    entry.nextUnused = NullSlot;
+    if (_unusedTail != NullSlot)
+        _slots[_unusedTail].nextUnused = slot;
+    else
+        _unusedHead = slot;
+    _unusedTail = slot;
+}
+
+void IO::HandlePool::unlinkUnused(const std::uint32_t slot) noexcept
+{
+    auto &entry = _slots[slot];
+    if (entry.previousUnused != NullSlot)
+        _slots[entry.previousUnused].nextUnused = entry.nextUnused;
+    else
+        _unusedHead = entry.nextUnused;
+    if (entry.nextUnused != NullSlot)
+        _slots[entry.nextUnused].previousUnused = entry.previousUnused;
+    else
+        _unusedTail = entry.previousUnused;
+    entry.previousUnused = NullSlot;
+    entry.nextUnused = NullSlot;
+}
+
+void IO::HandlePool::evict(const std::uint32_t count) noexcept
+{
+    // Stops early when every handle is leased
+    while (_size + count > _capacity && _unusedHead != NullSlot) {
+        close(_unusedHead);
+        ++_statistics.evictions;
+    }
+}
+
+void IO::HandlePool::close(const std::uint32_t slot) noexcept
+{
+    auto &entry = _slots[slot];
+    unlinkUnused(slot);
+    auto *link = &_buckets[static_cast<std::uint32_t>(entry.key) & (_buckets.size() - 1u)];
+    while (*link != slot)
+        link = &_slots[*link].nextInBucket;
+    *link = entry.nextInBucket;
+    Native::Close(entry.handle);
+    entry.handle = Native::InvalidHandle;
+    entry.path.clear();
+    entry.key = FreeKey;
+    entry.nextInBucket = NullSlot;
+    _freeSlots.push(slot);
+    --_size;
+}
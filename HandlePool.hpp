@@ -0,0 +1,203 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO HandlePool
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Core/SmallString.hpp>
+
+#include "Native.hpp"
+
+namespace kF::IO
+{
+    class HandlePool;
+}
+
+/** @brief Bounded pool of native handles shared between files, keyed by path and access
+ *  @note Unused handles are closed in least recently used order once the pool exceeds its capacity,
+ *      files reopen them transparently on their next access
+ *  @note Handles are pinned while leased, a pool may temporarily exceed its capacity when every handle is leased */
+class kF::IO::HandlePool
+{
+public:
+    /** @brief Default number of handles kept opened */
+    static constexpr std::uint32_t DefaultCapacity = 256;
+
+    /** @brief Access statistics */
+    struct Statistics
+    {
+        std::uint64_t hits {};
+        std::uint64_t misses {};
+        std::uint64_t evictions {};
+        std::uint64_t failures {}; // Misses whose open failed
+    };
+
+    class Lease;
+
+
+    /** @brief Destructor, every lease must be released */
+    ~HandlePool(void) noexcept;
+
+    /** @brief Constructor */
+    HandlePool(const std::uint32_t capacity = DefaultCapacity) noexcept;
+
+    /** @brief HandlePool is neither copyable nor movable, files and leases refer to it */
+    HandlePool(const HandlePool &other) noexcept = delete;
+    HandlePool &operator=(const HandlePool &other) noexcept = delete;
+
+
+    /** @brief Lease a handle over 'path', opening it if not pooled
+     *  @note Pooled handles are always readable, write handles never create nor truncate the file
+     *  @note Files are opened outside of the pool lock, other threads keep acquiring meanwhile
+     *  @return An invalid lease if the file couldn't be opened */
+    [[nodiscard]] Lease acquire(const std::string_view &path, const bool write) noexcept;
+
+    /** @brief Close every unleased handle over 'path' (e.g. before moving or removing it) */
+    void invalidate(const std::string_view &path) noexcept;
+
+    /** @brief Close every unleased handle */
+    void clear(void) noexcept;
+
+
+    /** @brief Get the capacity */
+    [[nodiscard]] std::uint32_t capacity(void) const noexcept;
+
+    /** @brief Set the capacity, closing least recently used handles if required */
+    void setCapacity(const std::uint32_t capacity) noexcept;
+
+    /** @brief Get the number of opened handles */
+    [[nodiscard]] std::uint32_t size(void) const noexcept;
+
+
+    /** @brief Get access statistics */
+    [[nodiscard]] Statistics statistics(void) const noexcept;
+
+    /** @brief Reset access statistics */
+    void resetStatistics(void) noexcept;
+
+private:
+    /** @brief Index of no slot */
+    static constexpr std::uint32_t NullSlot = ~std::uint32_t {};
+
+    /** @brief Key of a free slot */
+    static constexpr std::uint64_t FreeKey = ~std::uint64_t {};
+
+    /** @brief Pooled handle, unleased handles are linked in least recently used order */
+    struct Slot
+    {
+        Core::SmallString<IOAllocator> path {};
+        Native::Handle handle { Native::InvalidHandle };
+        std::uint64_t key { FreeKey };
+        std::uint32_t nextInBucket { NullSlot };
+        std::uint32_t previousUnused { NullSlot };
+        std::uint32_t nextUnused { NullSlot };
+        std::uint32_t pins {};
+    };
+
+
+    /** @brief Make the key of a path */
+    [[nodiscard]] static constexpr std::uint64_t MakeKey(const Core::HashedName path, const bool write) noexcept
+        { return (static_cast<std::uint64_t>(path) << 1) | write; }
+
+
+    /** @brief Find the slot of an opened handle, the lock must be held */
+    [[nodiscard]] std::uint32_t find(const std::uint64_t key, const std::string_view &path) const noexcept;
+
+    /** @brief Store an opened handle into a free slot, the lock must be held */
+    [[nodiscard]] std::uint32_t insert(const std::uint64_t key, const std::string_view &path, const Native::Handle handle) noexcept;
+
+    /** @brief Rebuild buckets after slots grew, the lock must be held */
+    void rehash(void) noexcept;
+
+    /** @brief Pin a slot, removing it from the unused list if required, the lock must be held */
+    void pin(const std::uint32_t slot) noexcept;
+
+    /** @brief Unpin a leased slot */
+    void unpin(const std::uint32_t slot) noexcept;
+
+    /** @brief Link an unleased slot at the most recently used end, the lock must be held */
+    void linkUnused(const std::uint32_t slot) noexcept;
+
+    /** @brief Unlink an unleased slot, the lock must be held */
+    void unlinkUnused(const std::uint32_t slot) noexcept;
+
+    /** @brief Close least recently used unleased handles until 'count' more fit into the capacity, the lock must be held */
+    void evict(const std::uint32_t count) noexcept;
+
+    /** @brief Close the unleased handle of a slot and free it, the lock must be held */
+    void close(const std::uint32_t slot) noexcept;
+
+
+    Core::Vector<std::uint32_t, IOAllocator> _buckets {}; // Heads of slot chains, indexed by key
+    Core::Vector<Slot, IOAllocator> _slots {};
+    Core::Vector<std::uint32_t, IOAllocator> _freeSlots {};
+    std::uint32_t _unusedHead { NullSlot }; // Least recently used unleased slot
+    std::uint32_t _unusedTail { NullSlot }; // Most recently used unleased slot
+    std::uint32_t _capacity {};
+    std::uint32_t _size {};
+    Statistics _statistics {};
+    mutable std::mutex _mutex {};
+};
+
+/** @brief Handle borrowed from a pool, the handle can't be closed while leased */
+class kF::IO::HandlePool::Lease
+{
+public:
+    /** @brief Destructor */
+    inline ~Lease(void) noexcept { release(); }
+
+    /** @brief Default constructor */
+    Lease(void) noexcept = default;
+
+    /** @brief Construct a lease over a handle which doesn't belong to any pool */
+    inline explicit Lease(const Native::Handle handle) noexcept : _handle(handle) {}
+
+    /** @brief Move constructor */
+    inline Lease(Lease &&other) noexcept
+        : _pool(std::exchange(other._pool, nullptr)), _slot(other._slot), _handle(std::exchange(other._handle, Native::InvalidHandle)) {}
+
+    /** @brief Move assignment */
+    inline Lease &operator=(Lease &&other) noexcept
+    {
+        release();
+        _pool = std::exchange(other._pool, nullptr);
+        _slot = other._slot;
+        _handle = std::exchange(other._handle, Native::InvalidHandle);
+        return *this;
+    }
+
+    /** @brief Lease is not copyable */
+    Lease(const Lease &other) noexcept = delete;
+    Lease &operator=(const Lease &other) noexcept = delete;
+
+
+    /** @brief Check if the lease holds a handle */
+    [[nodiscard]] inline explicit operator bool(void) const noexcept { return _handle != Native::InvalidHandle; }
+
+    /** @brief Get the leased handle */
+    [[nodiscard]] inline Native::Handle handle(void) const noexcept { return _handle; }
+
+
+    /** @brief Give the handle back to its pool */
+    inline void release(void) noexcept
+    {
+        if (_pool)
+            std::exchange(_pool, nullptr)->unpin(_slot);
+        _handle = Native::InvalidHandle;
+    }
+
+private:
+    /** @brief Construct a lease over a pinned slot */
+    inline Lease(HandlePool * const pool, const std::uint32_t slot, const Native::Handle handle) noexcept
+        : _pool(pool), _slot(slot), _handle(handle) {}
+
+    HandlePool *_pool {};
+    std::uint32_t _slot {};
+    Native::Handle _handle { Native::InvalidHandle };
+
+    friend HandlePool;
+};
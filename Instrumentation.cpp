@@ -0,0 +1,217 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Instrumentation
+ */
+
+#include <atomic>
+#include <mutex>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Instrumentation.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Counters of a single operation, only written by their owning thread */
+    struct OperationCounters
+    {
+        std::atomic<std::uint64_t> count {};
+        std::atomic<std::uint64_t> bytes {};
+        std::atomic<std::uint64_t> nanoseconds {};
+        std::array<std::atomic<std::uint64_t>, IO::Instrumentation::HistogramBucketCount> histogram {};
+    };
+
+    /** @brief Counters of a thread */
+    struct ThreadCounters
+    {
+        std::array<OperationCounters, IO::Instrumentation::OperationCount> operations {};
+        std::atomic<std::uint64_t> syscalls {};
+    };
+
+    /** @brief Global registry of thread counters */
+    struct Registry
+    {
+        std::mutex mutex {};
+        Core::Vector<ThreadCounters *, IO::IOAllocator> threads {};
+        IO::Instrumentation::Snapshot retired {};
+        std::atomic<IO::Instrumentation::TraceCallback> traceCallback {};
+        std::atomic<void *> traceUserData {};
+    };
+
+    [[nodiscard]] Registry &GetRegistry(void) noexcept
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /** @brief Increment a counter owned by the calling thread, a plain load / store is enough as there is a single writer */
+    inline void Increment(std::atomic<std::uint64_t> &counter, const std::uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /** @brief Accumulate thread counters into a snapshot */
+    void Accumulate(IO::Instrumentation::Snapshot &snapshot, const ThreadCounters &counters) noexcept
+    {
+        for (auto i = 0ul; i != IO::Instrumentation::OperationCount; ++i) {
+            auto &stats = snapshot.operations[i];
+            const auto &source = counters.operations[i];
+            stats.count += source.count.load(std::memory_order_relaxed);
+            stats.bytes += source.bytes.load(std::memory_order_relaxed);
+            stats.nanoseconds += source.nanoseconds.load(std::memory_order_relaxed);
+            for (auto bucket = 0ul; bucket != IO::Instrumentation::HistogramBucketCount; ++bucket)
+                stats.histogram[bucket] += source.histogram[bucket].load(std::memory_order_relaxed);
+        }
+        snapshot.syscalls += counters.syscalls.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Counters of the calling thread, registered on first use and folded into the retired totals on exit */
+    struct ThreadSlot
+    {
+        ThreadCounters counters {};
+
+        ThreadSlot(void) noexcept
+        {
+            auto &registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            registry.threads.push(&counters);
+        }
+
+        ~ThreadSlot(void) noexcept
+        {
+            auto &registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            Accumulate(registry.retired, counters);
+            registry.threads.erase(registry.threads.find(&counters));
+        }
+    };
+
+    [[nodiscard]] ThreadCounters &GetThreadCounters(void) noexcept
+    {
+        thread_local ThreadSlot slot;
+        return slot.counters;
+    }
+}
+
+std::uint64_t IO::Instrumentation::OperationStats::percentile(const double ratio) const noexcept
+{
+    const auto target = static_cast<std::uint64_t>(static_cast<double>(count) * ratio);
+    std::uint64_t total = 0u;
+    for (auto bucket = 0ul; bucket != HistogramBucketCount; ++bucket) {
+        total += histogram[bucket];
+        if (total > target || total == count)
+            return bucket ? 1ull << bucket : 0u;
+    }
+    return 0u;
+}
+
+void IO::Instrumentation::Record(const Operation operation, const std::size_t bytes, const std::uint64_t nanoseconds,
+        const std::string_view &path) noexcept
+{
+    if constexpr (IsEnabled()) {
+        auto &counters = GetThreadCounters().operations[static_cast<std::size_t>(operation)];
+        Increment(counters.count, 1u);
+        Increment(counters.bytes, bytes);
+        Increment(counters.nanoseconds, nanoseconds);
+        Increment(counters.histogram[BucketOf(nanoseconds)], 1u);
+
+        auto &registry = GetRegistry();
+        if (const auto callback = registry.traceCallback.load(std::memory_order_acquire); callback) [[unlikely]] {
+            callback(
+                Event {
+                    .operation = operation,
+                    .bytes = bytes,
+                    .nanoseconds = nanoseconds,
+                    .path = path
+                },
+                registry.traceUserData.load(std::memory_order_relaxed)
+            );
+        }
+    }
+}
+
+void IO::Instrumentation::RecordSyscall(void) noexcept
+{
+    if constexpr (IsEnabled())
+        Increment(GetThreadCounters().syscalls, 1u);
+}
+
+void IO::Instrumentation::FileCounters::record(const Operation operation, const std::size_t bytes, const std::uint64_t nanoseconds) noexcept
+{
+    // Several threads may use the same file, unlike thread counters these need read-modify-write instructions
+    auto &counters = operations[static_cast<std::size_t>(operation)];
+    counters.count.fetch_add(1u, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.histogram[BucketOf(nanoseconds)].fetch_add(1u, std::memory_order_relaxed);
+}
+
+IO::Instrumentation::Snapshot IO::Instrumentation::FileCounters::snapshot(void) const noexcept
+{
+    Snapshot snapshot {};
+    for (auto i = 0ul; i != OperationCount; ++i) {
+        auto &stats = snapshot.operations[i];
+        const auto &source = operations[i];
+        stats.count = source.count.load(std::memory_order_relaxed);
+        stats.bytes = source.bytes.load(std::memory_order_relaxed);
+        stats.nanoseconds = source.nanoseconds.load(std::memory_order_relaxed);
+        for (auto bucket = 0ul; bucket != HistogramBucketCount; ++bucket)
+            stats.histogram[bucket] = source.histogram[bucket].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void IO::Instrumentation::FileCounters::reset(void) noexcept
+{
+    for (auto &operation : operations) {
+        operation.count.store(0u, std::memory_order_relaxed);
+        operation.bytes.store(0u, std::memory_order_relaxed);
+        operation.nanoseconds.store(0u, std::memory_order_relaxed);
+        for (auto &bucket : operation.histogram)
+            bucket.store(0u, std::memory_order_relaxed);
+    }
+}
+
+IO::Instrumentation::Snapshot IO::Instrumentation::TakeSnapshot(void) noexcept
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    Snapshot snapshot = registry.retired;
+    for (const auto *counters : registry.threads)
+        Accumulate(snapshot, *counters);
+    return snapshot;
+}
+
+IO::Instrumentation::Snapshot IO::Instrumentation::TakeThreadSnapshot(void) noexcept
+{
+    Snapshot snapshot {};
+    if constexpr (IsEnabled())
+        Accumulate(snapshot, GetThreadCounters());
+    return snapshot;
+}
+
+void IO::Instrumentation::Reset(void) noexcept
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.retired = Snapshot {};
+    for (auto *counters : registry.threads) {
+        for (auto &operation : counters->operations) {
+            operation.count.store(0u, std::memory_order_relaxed);
+            operation.bytes.store(0u, std::memory_order_relaxed);
+            operation.nanoseconds.store(0u, std::memory_order_relaxed);
+            for (auto &bucket : operation.histogram)
+                bucket.store(0u, std::memory_order_relaxed);
+        }
+        counters->syscalls.store(0u, std::memory_order_relaxed);
+    }
+}
+
+void IO::Instrumentation::SetTraceCallback(const TraceCallback callback, void * const userData) noexcept
+{
+    auto &registry = GetRegistry();
+    registry.traceUserData.store(userData, std::memory_order_relaxed);
+    registry.traceCallback.store(callback, std::memory_order_release);
+}
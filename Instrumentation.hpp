@@ -0,0 +1,184 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Instrumentation
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "Base.hpp"
+
+/** @brief Instrumentation is enabled unless the library is compiled with 'KUBE_IO_INSTRUMENTATION=0' */
+#ifndef KUBE_IO_INSTRUMENTATION
+# define KUBE_IO_INSTRUMENTATION 1
+#endif
+
+/** @brief Low overhead I/O instrumentation
+ *
+ *  Every thread owns its counters, recording an operation never takes a lock nor a read-modify-write instruction.
+ *  A snapshot sums the counters of all live threads with the totals of the threads that already exited. */
+namespace kF::IO::Instrumentation
+{
+    /** @brief Instrumented operations */
+    enum class Operation : std::uint8_t
+    {
+        Read,
+        Write,
+        Open,
+        Map,
+        ResourceQuery,
+        Count
+    };
+
+    /** @brief Number of instrumented operations */
+    constexpr std::size_t OperationCount = static_cast<std::size_t>(Operation::Count);
+
+    /** @brief Number of latency buckets, bucket 'i' holds durations in [2^(i-1), 2^i[ nanoseconds */
+    constexpr std::size_t HistogramBucketCount = 32;
+
+    /** @brief Check if instrumentation is compiled in */
+    [[nodiscard]] constexpr bool IsEnabled(void) noexcept { return KUBE_IO_INSTRUMENTATION; }
+
+
+    /** @brief Totals of a single operation */
+    struct OperationStats
+    {
+        std::uint64_t count {};
+        std::uint64_t bytes {};
+        std::uint64_t nanoseconds {};
+        std::array<std::uint64_t, HistogramBucketCount> histogram {};
+
+        /** @brief Get an approximation of the latency percentile 'ratio' (in [0, 1]) in nanoseconds, from the histogram */
+        [[nodiscard]] std::uint64_t percentile(const double ratio) const noexcept;
+    };
+
+    /** @brief Totals of every operation */
+    struct Snapshot
+    {
+        std::array<OperationStats, OperationCount> operations {};
+        std::uint64_t syscalls {};
+
+        /** @brief Get the totals of an operation */
+        [[nodiscard]] const OperationStats &operator[](const Operation operation) const noexcept
+            { return operations[static_cast<std::size_t>(operation)]; }
+    };
+
+    /** @brief Counters of a single file, written by every thread using it (see 'File::enableStatistics') */
+    struct FileCounters
+    {
+        /** @brief Counters of a single operation */
+        struct Counters
+        {
+            std::atomic<std::uint64_t> count {};
+            std::atomic<std::uint64_t> bytes {};
+            std::atomic<std::uint64_t> nanoseconds {};
+            std::array<std::atomic<std::uint64_t>, HistogramBucketCount> histogram {};
+        };
+
+        std::array<Counters, OperationCount> operations {};
+
+        /** @brief Record an operation */
+        void record(const Operation operation, const std::size_t bytes, const std::uint64_t nanoseconds) noexcept;
+
+        /** @brief Get the totals of every operation, system calls are only counted per thread */
+        [[nodiscard]] Snapshot snapshot(void) const noexcept;
+
+        /** @brief Reset every counter
+         *  @note Operations recorded concurrently may be partially lost */
+        void reset(void) noexcept;
+    };
+
+    /** @brief Event sent to the trace callback after each operation */
+    struct Event
+    {
+        Operation operation {};
+        std::size_t bytes {};
+        std::uint64_t nanoseconds {};
+        std::string_view path {};
+    };
+
+    /** @brief Trace callback, called from the thread that performed the operation */
+    using TraceCallback = void(*)(const Event &event, void * const userData) noexcept;
+
+
+    /** @brief Get the bucket of a duration */
+    [[nodiscard]] constexpr std::size_t BucketOf(const std::uint64_t nanoseconds) noexcept
+    {
+        std::size_t bucket = 0u;
+        for (auto value = nanoseconds; value && bucket != HistogramBucketCount - 1; value >>= 1)
+            ++bucket;
+        return bucket;
+    }
+
+    /** @brief Record an operation into the calling thread counters */
+    void Record(const Operation operation, const std::size_t bytes, const std::uint64_t nanoseconds,
+            const std::string_view &path = std::string_view()) noexcept;
+
+    /** @brief Record a system call into the calling thread counters */
+    void RecordSyscall(void) noexcept;
+
+    /** @brief Sum the counters of every thread */
+    [[nodiscard]] Snapshot TakeSnapshot(void) noexcept;
+
+    /** @brief Get the counters of the calling thread */
+    [[nodiscard]] Snapshot TakeThreadSnapshot(void) noexcept;
+
+    /** @brief Reset the counters of every thread
+     *  @note Operations recorded concurrently may be partially lost */
+    void Reset(void) noexcept;
+
+    /** @brief Set the trace callback, 'nullptr' disables tracing */
+    void SetTraceCallback(const TraceCallback callback, void * const userData = nullptr) noexcept;
+
+
+    /** @brief Measure an operation during the lifetime of the scope */
+    class Scope;
+}
+
+#if KUBE_IO_INSTRUMENTATION
+
+class kF::IO::Instrumentation::Scope
+{
+public:
+    /** @brief Start measuring 'operation', also recorded into 'counters' if not null */
+    Scope(const Operation operation, const std::string_view &path = std::string_view(), FileCounters * const counters = nullptr) noexcept
+        : _begin(std::chrono::steady_clock::now()), _path(path), _counters(counters), _operation(operation) {}
+
+    /** @brief Record the operation */
+    ~Scope(void) noexcept
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _begin);
+        Record(_operation, _bytes, static_cast<std::uint64_t>(elapsed.count()), _path);
+        if (_counters) [[unlikely]]
+            _counters->record(_operation, _bytes, static_cast<std::uint64_t>(elapsed.count()));
+    }
+
+    /** @brief Set the number of bytes transferred by the operation */
+    void setBytes(const std::size_t bytes) noexcept { _bytes = bytes; }
+
+private:
+    std::chrono::steady_clock::time_point _begin {};
+    std::string_view _path {};
+    FileCounters *_counters {};
+    std::size_t _bytes {};
+    Operation _operation {};
+};
+
+#else
+
+class kF::IO::Instrumentation::Scope
+{
+public:
+    /** @brief Start measuring 'operation' */
+    Scope(const Operation, const std::string_view & = std::string_view(), FileCounters * const = nullptr) noexcept {}
+
+    /** @brief Set the number of bytes transferred by the operation */
+    void setBytes(const std::size_t) noexcept {}
+};
+
+#endif
@@ -0,0 +1,253 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Loader
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <Kube/Core/SmallString.hpp>
+
+#include "File.hpp"
+#include "Loader.hpp"
+
+using namespace kF;
+
+struct IO::LoadFuture::State
+{
+    std::atomic<std::uint32_t> references { 1u };
+    std::atomic<LoadStatus> status { LoadStatus::Queued };
+    std::atomic<bool> cancel {};
+    LoadPriority priority {};
+    std::uint64_t sequence {};
+    Core::SmallString<IOAllocator> path {};
+    LoadAllocator allocator {};
+    LoadCallback callback {};
+    void *userData {};
+    std::uint8_t *data {};
+    std::size_t size {};
+};
+
+namespace
+{
+    using State = IO::LoadFuture::State;
+
+    /** @brief Alignment of the data owned by futures */
+    constexpr std::size_t DataAlignment = alignof(std::max_align_t);
+
+    /** @brief Heap order, the top of the heap is the highest priority then the oldest request */
+    [[nodiscard]] inline bool HasLowerPriority(const State * const lhs, const State * const rhs) noexcept
+        { return lhs->priority < rhs->priority || (lhs->priority == rhs->priority && lhs->sequence > rhs->sequence); }
+
+    /** @brief Drop a reference over a state */
+    void Release(State * const state) noexcept
+    {
+        if (!state || state->references.fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+            return;
+        if (!state->allocator && state->data)
+            IO::IOAllocator::Deallocate(state->data, state->size, DataAlignment);
+        state->~State();
+        IO::IOAllocator::Deallocate(state, sizeof(State), alignof(State));
+    }
+}
+
+IO::LoadFuture::~LoadFuture(void) noexcept
+{
+    Release(_state);
+}
+
+IO::LoadFuture::LoadFuture(State * const state) noexcept
+    : _state(state)
+{
+    _state->references.fetch_add(1u, std::memory_order_relaxed);
+}
+
+IO::LoadFuture::LoadFuture(const LoadFuture &other) noexcept
+    : _state(other._state)
+{
+    if (_state)
+        _state->references.fetch_add(1u, std::memory_order_relaxed);
+}
+
+IO::LoadFuture &IO::LoadFuture::operator=(const LoadFuture &other) noexcept
+{
+    if (other._state)
+        other._state->references.fetch_add(1u, std::memory_order_relaxed);
+    Release(_state);
+    _state = other._state;
+    return *this;
+}
+
+IO::LoadFuture &IO::LoadFuture::operator=(LoadFuture &&other) noexcept
+{
+    if (this != &other) {
+        Release(_state);
+        _state = other._state;
+        other._state = nullptr;
+    }
+    return *this;
+}
+
+IO::LoadStatus IO::LoadFuture::status(void) const noexcept
+{
+    return _state->status.load(std::memory_order_acquire);
+}
+
+IO::LoadStatus IO::LoadFuture::wait(void) const noexcept
+{
+    auto status = _state->status.load(std::memory_order_acquire);
+    while (status < LoadStatus::Completed) {
+        _state->status.wait(status, std::memory_order_acquire);
+        status = _state->status.load(std::memory_order_acquire);
+    }
+    return status;
+}
+
+IO::ResourceView IO::LoadFuture::data(void) const noexcept
+{
+    return ResourceView { .from = _state->data, .to = _state->data + _state->size };
+}
+
+IO::Loader::~Loader(void) noexcept
+{
+    Core::Vector<State *, IOAllocator> queued;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _stop = true;
+        std::swap(queued, _queue);
+    }
+    _condition.notify_all();
+    for (const auto state : queued) {
+        finish(*state, LoadStatus::Cancelled);
+        Release(state);
+    }
+    for (auto &thread : _threads)
+        thread.join();
+}
+
+IO::Loader::Loader(const std::uint32_t threadCount, const std::size_t chunkSize) noexcept
+    : _chunkSize(std::max<std::size_t>(chunkSize, 1u))
+{
+    const auto count = threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    for (auto i = 0u; i != count; ++i)
+        _threads.push([this] { work(); });
+}
+
+std::size_t IO::Loader::queuedCount(void) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _queue.size();
+}
+
+IO::LoadFuture IO::Loader::load(const LoadRequest &request) noexcept
+{
+    const auto state = new (IOAllocator::Allocate(sizeof(State), alignof(State))) State {};
+    state->priority = request.priority;
+    state->path = request.path;
+    state->allocator = request.allocator;
+    state->callback = request.callback;
+    state->userData = request.userData;
+    // The queue owns the initial reference
+    LoadFuture future(state);
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        state->sequence = _sequence++;
+        _queue.push(state);
+        std::push_heap(_queue.begin(), _queue.end(), HasLowerPriority);
+    }
+    _condition.notify_one();
+    return future;
+}
+
+bool IO::Loader::cancel(const LoadFuture &future) noexcept
+{
+    const auto state = future._state;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        const auto status = state->status.load(std::memory_order_relaxed);
+        if (status == LoadStatus::Running) {
+            state->cancel.store(true, std::memory_order_relaxed);
+            return true;
+        } else if (status != LoadStatus::Queued)
+            return false;
+        removeQueued(state);
+    }
+    finish(*state, LoadStatus::Cancelled);
+    Release(state);
+    return true;
+}
+
+bool IO::Loader::reprioritize(const LoadFuture &future, const LoadPriority priority) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    const auto state = future._state;
+    if (state->status.load(std::memory_order_relaxed) != LoadStatus::Queued)
+        return false;
+    state->priority = priority;
+    std::make_heap(_queue.begin(), _queue.end(), HasLowerPriority);
+    return true;
+}
+
+void IO::Loader::removeQueued(const State * const state) noexcept
+{
+    const auto it = _queue.find(const_cast<State *>(state));
+    if (it == _queue.end())
+        return;
+    _queue.erase(it);
+    std::make_heap(_queue.begin(), _queue.end(), HasLowerPriority);
+}
+
+void IO::Loader::work(void) noexcept
+{
+    while (true) {
+        State *state {};
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _stop || !_queue.empty(); });
+            if (_queue.empty())
+                return;
+            std::pop_heap(_queue.begin(), _queue.end(), HasLowerPriority);
+            state = _queue.back();
+            _queue.pop();
+            // Marked under the lock so 'cancel' and 'reprioritize' never see a request out of the queue as queued
+            state->status.store(LoadStatus::Running, std::memory_order_relaxed);
+        }
+        process(*state);
+        Release(state);
+    }
+}
+
+void IO::Loader::process(State &state) noexcept
+{
+    File file(state.path.toView(), File::Mode::ReadBinary);
+    if (!file.exists()) [[unlikely]]
+        return finish(state, LoadStatus::Failed);
+
+    const auto size = file.fileSize();
+    state.data = state.allocator
+        ? state.allocator(size, state.userData)
+        : reinterpret_cast<std::uint8_t *>(IOAllocator::Allocate(size, DataAlignment));
+    state.size = size;
+    if (!state.data && size) [[unlikely]]
+        return finish(state, LoadStatus::Failed);
+
+    for (std::size_t offset = 0u; offset < size;) {
+        if (state.cancel.load(std::memory_order_relaxed)) [[unlikely]]
+            return finish(state, LoadStatus::Cancelled);
+        const auto to = state.data + std::min(size, offset + _chunkSize);
+        const auto count = file.readAt(state.data + offset, to, offset);
+        if (!count) [[unlikely]]
+            return finish(state, LoadStatus::Failed);
+        offset += count;
+    }
+    finish(state, LoadStatus::Completed);
+}
+
+void IO::Loader::finish(State &state, const LoadStatus status) noexcept
+{
+    state.status.store(status, std::memory_order_release);
+    state.status.notify_all();
+    if (state.callback)
+        state.callback(LoadFuture(&state), state.userData);
+}
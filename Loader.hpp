@@ -0,0 +1,166 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Loader
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::IO
+{
+    class Loader;
+    class LoadFuture;
+
+    /** @brief Default size of the chunks read between two cancellation checks */
+    constexpr std::size_t DefaultLoadChunkSize = 1024 * 1024;
+
+    /** @brief Priority of a load request, higher priorities are loaded first */
+    using LoadPriority = std::int32_t;
+
+    /** @brief Status of a load request */
+    enum class LoadStatus : std::uint32_t
+    {
+        Queued,
+        Running,
+        Completed,
+        Failed,
+        Cancelled
+    };
+
+    /** @brief Destination allocator of a load request, must return at least 'size' writable bytes
+     *  @note Called from an I/O thread, the caller owns the returned memory whatever the status of the load */
+    using LoadAllocator = std::uint8_t *(*)(const std::size_t size, void * const userData) noexcept;
+
+    /** @brief Completion callback of a load request, called once the request is completed, failed or cancelled
+     *  @note Called from an I/O thread, or from the thread that cancelled a queued request */
+    using LoadCallback = void(*)(const LoadFuture &future, void * const userData) noexcept;
+
+    /** @brief Load request */
+    struct LoadRequest
+    {
+        std::string_view path {};
+        LoadPriority priority {};
+        LoadAllocator allocator {}; // Null loads into memory owned by the future (IOAllocator)
+        LoadCallback callback {};
+        void *userData {};
+    };
+}
+
+/** @brief Shared handle over the result of a load request */
+class kF::IO::LoadFuture
+{
+public:
+    /** @brief Shared state of a request (opaque) */
+    struct State;
+
+
+    /** @brief Destructor, the last reference releases data loaded without a custom allocator */
+    ~LoadFuture(void) noexcept;
+
+    /** @brief Default constructor */
+    LoadFuture(void) noexcept = default;
+
+    /** @brief Copy constructor */
+    LoadFuture(const LoadFuture &other) noexcept;
+
+    /** @brief Move constructor */
+    LoadFuture(LoadFuture &&other) noexcept : _state(other._state) { other._state = nullptr; }
+
+    /** @brief Copy assignment */
+    LoadFuture &operator=(const LoadFuture &other) noexcept;
+
+    /** @brief Move assignment */
+    LoadFuture &operator=(LoadFuture &&other) noexcept;
+
+
+    /** @brief Check if the future refers to a request */
+    [[nodiscard]] inline bool valid(void) const noexcept { return _state; }
+
+    /** @brief Get the current status of the request */
+    [[nodiscard]] LoadStatus status(void) const noexcept;
+
+    /** @brief Check if the request is completed, failed or cancelled */
+    [[nodiscard]] inline bool ready(void) const noexcept { return status() >= LoadStatus::Completed; }
+
+    /** @brief Block until the request is completed, failed or cancelled
+     *  @return The final status */
+    LoadStatus wait(void) const noexcept;
+
+    /** @brief Get the loaded data, only meaningful once the request is completed */
+    [[nodiscard]] ResourceView data(void) const noexcept;
+
+private:
+    /** @brief Construct over a state, taking a reference */
+    LoadFuture(State * const state) noexcept;
+
+    State *_state {};
+
+    friend Loader;
+};
+
+/** @brief Service loading whole files on a dedicated pool of I/O threads
+ *  @note Queued requests are served by priority, in submission order within a same priority */
+class kF::IO::Loader
+{
+public:
+    /** @brief Destructor, queued requests are cancelled and running ones are waited */
+    ~Loader(void) noexcept;
+
+    /** @brief Constructor
+     *  @param threadCount Number of I/O threads, 0 uses the hardware concurrency
+     *  @param chunkSize Size of the chunks read between two cancellation checks */
+    Loader(const std::uint32_t threadCount = 0u, const std::size_t chunkSize = DefaultLoadChunkSize) noexcept;
+
+    /** @brief Loader is not copyable */
+    Loader(const Loader &other) noexcept = delete;
+    Loader &operator=(const Loader &other) noexcept = delete;
+
+
+    /** @brief Get the number of I/O threads */
+    [[nodiscard]] inline std::uint32_t threadCount(void) const noexcept { return static_cast<std::uint32_t>(_threads.size()); }
+
+    /** @brief Get the number of queued requests */
+    [[nodiscard]] std::size_t queuedCount(void) const noexcept;
+
+
+    /** @brief Queue a load request */
+    [[nodiscard]] LoadFuture load(const LoadRequest &request) noexcept;
+
+    /** @brief Cancel a request
+     *  @note A running request stops at its next chunk
+     *  @return False if the request is already completed, failed or cancelled */
+    bool cancel(const LoadFuture &future) noexcept;
+
+    /** @brief Change the priority of a queued request
+     *  @return False if the request is not queued anymore */
+    bool reprioritize(const LoadFuture &future, const LoadPriority priority) noexcept;
+
+private:
+    /** @brief Run the requests of the queue until the loader stops */
+    void work(void) noexcept;
+
+    /** @brief Load a request */
+    void process(LoadFuture::State &state) noexcept;
+
+    /** @brief Publish the final status of a request and call its callback */
+    void finish(LoadFuture::State &state, const LoadStatus status) noexcept;
+
+    /** @brief Remove a request from the queue, the queue lock must be held */
+    void removeQueued(const LoadFuture::State * const state) noexcept;
+
+
+    Core::Vector<LoadFuture::State *, IOAllocator> _queue {}; // Binary heap
+    Core::Vector<std::thread, IOAllocator> _threads {};
+    std::uint64_t _sequence {};
+    std::size_t _chunkSize {};
+    bool _stop {};
+    mutable std::mutex _mutex {};
+    std::condition_variable _condition {};
+};
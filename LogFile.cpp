@@ -0,0 +1,91 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO LogFile
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+#include <Kube/Core/Abort.hpp>
+
+#include "LogFile.hpp"
+
+using namespace kF;
+
+IO::LogFile::~LogFile(void) noexcept
+{
+    close();
+}
+
+IO::LogFile::LogFile(const std::string_view &path, const std::size_t extentSize, const std::size_t rotationSize) noexcept
+    : _file(path, File::Mode::Append), _extentSize(extentSize), _rotationSize(rotationSize)
+{
+    open();
+}
+
+bool IO::LogFile::append(const std::uint8_t * const from, const std::uint8_t * const to) noexcept
+{
+    const auto count = static_cast<std::size_t>(std::distance(from, to));
+    prepare(count);
+    // Failed or short appends only count the bytes actually written
+    const auto offset = _file.offset();
+    const auto success = _file.append(from, to);
+    _size += _file.offset() - offset;
+    return success;
+}
+
+bool IO::LogFile::append(const std::initializer_list<ResourceView> &buffers) noexcept
+{
+    std::size_t count {};
+    for (const auto &buffer : buffers)
+        count += buffer.size();
+    prepare(count);
+    const auto offset = _file.offset();
+    const auto success = _file.appendVectored(buffers);
+    _size += _file.offset() - offset;
+    return success;
+}
+
+bool IO::LogFile::rotate(void) noexcept
+{
+    const auto path = _file.path<std::string>();
+    std::string rotatedPath;
+    do
+        rotatedPath = path + '.' + std::to_string(++_rotationIndex);
+    while (std::filesystem::exists(rotatedPath));
+    // The log is closed before being renamed, Windows doesn't rename opened files
+    close();
+    _file = File(path, File::Mode::Append);
+    const auto success = Native::Rename(path, rotatedPath);
+    open();
+    return success;
+}
+
+void IO::LogFile::open(void) noexcept
+{
+    kFEnsure(_file.tryOpen(), "IO::LogFile::open: Couldn't open log '", _file.path(), '\'');
+    _size = Native::Size(_file.nativeHandle());
+    _reserved = _size;
+}
+
+void IO::LogFile::close(void) noexcept
+{
+    if (_reserved > _size && _file.tryOpen()) {
+        // Other processes may have appended, the size is queried again
+        const auto handle = _file.nativeHandle();
+        static_cast<void>(Native::Resize(handle, Native::Size(handle)));
+    }
+}
+
+void IO::LogFile::prepare(const std::size_t count) noexcept
+{
+    if (_rotationSize && _size && _size + count > _rotationSize)
+        static_cast<void>(rotate());
+    if (_extentSize && _size + count > _reserved) {
+        const auto extent = std::max(_extentSize, count);
+        static_cast<void>(Native::Preallocate(_file.nativeHandle(), _reserved, extent));
+        // A failed reservation isn't retried before the next extent
+        _reserved += extent;
+    }
+}
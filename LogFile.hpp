@@ -0,0 +1,102 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO LogFile
+ */
+
+#pragma once
+
+#include "File.hpp"
+
+namespace kF::IO
+{
+    class LogFile;
+}
+
+/** @brief Append-only log over a File opened with 'File::Mode::Append'
+ *  @note Disk space is reserved by large extents ahead of the end of file, appends never grow the file block by block.
+ *      The unused reservation is released when the log is closed or rotated
+ *  @note With a rotation threshold, a log about to exceed it is renamed '<path>.<index>' and a new log is started
+ *  @note A log is not thread-safe, several processes may still append to a same log as long as only one of them rotates it */
+class kF::IO::LogFile
+{
+public:
+    /** @brief Default size of the extents reserved ahead of the end of file */
+    static constexpr std::size_t DefaultExtentSize = 8 * 1024 * 1024;
+
+
+    /** @brief Destructor, releases the unused reservation */
+    ~LogFile(void) noexcept;
+
+    /** @brief Open or create the log at 'path', appends continue after its current content
+     *  @param extentSize Size of the extents reserved ahead of the end of file, 0 disables reservation
+     *  @param rotationSize Size after which the log is rotated, 0 disables rotation */
+    LogFile(const std::string_view &path, const std::size_t extentSize = DefaultExtentSize, const std::size_t rotationSize = 0) noexcept;
+
+    /** @brief Deleted copy constructor */
+    LogFile(const LogFile &other) noexcept = delete;
+
+    /** @brief Deleted copy assignment */
+    LogFile &operator=(const LogFile &other) noexcept = delete;
+
+
+    /** @brief Get underlying file */
+    [[nodiscard]] inline const File &file(void) const noexcept { return _file; }
+
+    /** @brief Get the size of the current log, only appends made through this instance are accounted */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _size; }
+
+    /** @brief Get the number of bytes reserved by the current log, including its size */
+    [[nodiscard]] inline std::size_t reservedSize(void) const noexcept { return _reserved; }
+
+    /** @brief Get the extent size */
+    [[nodiscard]] inline std::size_t extentSize(void) const noexcept { return _extentSize; }
+
+    /** @brief Get the rotation threshold */
+    [[nodiscard]] inline std::size_t rotationSize(void) const noexcept { return _rotationSize; }
+
+    /** @brief Get the index of the last rotated log, 0 if the log was never rotated */
+    [[nodiscard]] inline std::uint32_t rotationIndex(void) const noexcept { return _rotationIndex; }
+
+
+    /** @brief Append a record
+     *  @note A record is never split across two logs
+     *  @return False if the record couldn't be entirely written */
+    [[nodiscard]] bool append(const std::uint8_t * const from, const std::uint8_t * const to) noexcept;
+
+    /** @brief Append a record gathered from several buffers in a single write */
+    [[nodiscard]] bool append(const std::initializer_list<ResourceView> &buffers) noexcept;
+
+    /** @brief Append a container as a record */
+    template<kF::IO::Internal::WritableContainer Container>
+    [[nodiscard]] inline bool appendAll(const Container &container) noexcept;
+
+
+    /** @brief Flush appended records to the storage device
+     *  @param dataOnly Skip metadata that isn't required to read the data back */
+    [[nodiscard]] inline bool sync(const bool dataOnly = true) noexcept { return _file.sync(dataOnly); }
+
+    /** @brief Rename the current log '<path>.<index>', using the first free index, and start a new one
+     *  @return False if the log couldn't be renamed */
+    [[nodiscard]] bool rotate(void) noexcept;
+
+
+private:
+    /** @brief Open the log and query its size */
+    void open(void) noexcept;
+
+    /** @brief Release the unused reservation */
+    void close(void) noexcept;
+
+    /** @brief Prepare the log to receive a record of 'count' bytes, rotating it or reserving space if required */
+    void prepare(const std::size_t count) noexcept;
+
+
+    File _file {};
+    std::size_t _size {};
+    std::size_t _reserved {};
+    std::size_t _extentSize {};
+    std::size_t _rotationSize {};
+    std::uint32_t _rotationIndex {};
+};
+
+#include "LogFile.ipp"
@@ -0,0 +1,15 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO LogFile
+ */
+
+#pragma once
+
+#include "LogFile.hpp"
+
+template<kF::IO::Internal::WritableContainer Container>
+inline bool kF::IO::LogFile::appendAll(const Container &container) noexcept
+{
+    const auto from = reinterpret_cast<const std::uint8_t *>(&*std::begin(container));
+    return append(from, from + container.size());
+}
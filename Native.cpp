@@ -0,0 +1,805 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Native
+ */
+
+#include <algorithm>
+#include <filesystem>
+
+#include <Kube/Core/Vector.hpp>
+
+#if defined(_WIN32)
+# ifndef NOMINMAX
+#  define NOMINMAX
+# endif
+# include <windows.h>
+#else
+# include <cerrno>
+# include <cstdio>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/uio.h>
+# include <unistd.h>
+# if defined(__linux__)
+#  include <linux/fs.h>
+#  include <sys/ioctl.h>
+#  include <sys/sendfile.h>
+# endif
+#endif
+
+#include "Instrumentation.hpp"
+#include "Native.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Count a system call when instrumentation is enabled */
+    inline void CountSyscall(void) noexcept
+    {
+        if constexpr (IO::Instrumentation::IsEnabled())
+            IO::Instrumentation::RecordSyscall();
+    }
+
+#if !defined(_WIN32)
+    /** @brief Maximum number of buffers given to a single vectored transfer */
+    constexpr std::uint32_t MaxVectorCount = 64;
+
+    /** @brief Transfer 'count' buffers at 'offset' using 'transfer' (preadv or pwritev), resuming partial transfers */
+    template<typename View, typename Transfer>
+    std::size_t TransferVector(const View * const buffers, const std::uint32_t count, const std::size_t offset, Transfer &&transfer) noexcept
+    {
+        iovec vectors[MaxVectorCount];
+        std::size_t total {};
+        std::uint32_t index {};
+        std::size_t consumed {}; // Bytes of 'buffers[index]' already transferred
+        while (index != count) {
+            std::uint32_t vectorCount {};
+            for (auto i = index; i != count && vectorCount != MaxVectorCount; ++i, ++vectorCount) {
+                const auto skip = i == index ? consumed : 0u;
+                vectors[vectorCount] = iovec {
+                    .iov_base = const_cast<std::uint8_t *>(buffers[i].from + skip),
+                    .iov_len = buffers[i].size() - skip
+                };
+            }
+            CountSyscall();
+            const auto result = transfer(vectors, static_cast<int>(vectorCount), static_cast<off_t>(offset + total));
+            if (result < 0 && errno == EINTR)
+                continue;
+            else if (result <= 0)
+                break;
+            total += static_cast<std::size_t>(result);
+            for (auto remaining = static_cast<std::size_t>(result); remaining;) {
+                const auto left = buffers[index].size() - consumed;
+                if (remaining < left) {
+                    consumed += remaining;
+                    break;
+                }
+                remaining -= left;
+                consumed = 0u;
+                ++index;
+            }
+        }
+        return total;
+    }
+#endif
+}
+
+#if defined(_WIN32)
+
+IO::Native::Handle IO::Native::Open(const std::string_view &path, const bool read, const bool write) noexcept
+{
+    const DWORD access = (read ? GENERIC_READ : 0u) | (write ? GENERIC_WRITE : 0u);
+    CountSyscall();
+    const auto handle = ::CreateFileW(
+        std::filesystem::path(path).c_str(),
+        access,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        write && !read ? CREATE_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    return handle == INVALID_HANDLE_VALUE ? InvalidHandle : reinterpret_cast<Handle>(handle);
+}
+
+IO::Native::Handle IO::Native::OpenDirect(const std::string_view &path, const bool read, const bool write, bool &direct) noexcept
+{
+    // Unaligned writes read back the blocks they partially cover
+    const DWORD access = GENERIC_READ | (write ? GENERIC_WRITE : 0u);
+    CountSyscall();
+    const auto handle = ::CreateFileW(
+        std::filesystem::path(path).c_str(),
+        access,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        write && !read ? CREATE_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING,
+        nullptr
+    );
+    if (handle != INVALID_HANDLE_VALUE) [[likely]] {
+        direct = true;
+        return reinterpret_cast<Handle>(handle);
+    }
+    direct = false;
+    return Open(path, read, write);
+}
+
+IO::Native::Handle IO::Native::OpenAppend(const std::string_view &path) noexcept
+{
+    // Write access is kept to reserve and trim disk space, appends explicitly target the end of file
+    CountSyscall();
+    const auto handle = ::CreateFileW(
+        std::filesystem::path(path).c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    return handle == INVALID_HANDLE_VALUE ? InvalidHandle : reinterpret_cast<Handle>(handle);
+}
+
+void IO::Native::Close(const Handle handle) noexcept
+{
+    CountSyscall();
+    ::CloseHandle(reinterpret_cast<HANDLE>(handle));
+}
+
+void IO::Native::DropCache(const Handle, const std::size_t, const std::size_t) noexcept
+{
+    // The system cache can't drop a range of a buffered handle
+}
+
+void IO::Native::Advise(const Handle, const AccessHint, const std::size_t, const std::size_t) noexcept
+{
+    // Access patterns are only given at opening (FILE_FLAG_SEQUENTIAL_SCAN, FILE_FLAG_RANDOM_ACCESS)
+}
+
+std::size_t IO::Native::Size(const Handle handle) noexcept
+{
+    LARGE_INTEGER size {};
+    CountSyscall();
+    if (!::GetFileSizeEx(reinterpret_cast<HANDLE>(handle), &size)) [[unlikely]]
+        return 0u;
+    return static_cast<std::size_t>(size.QuadPart);
+}
+
+bool IO::Native::SizeOf(const std::string_view &path, std::size_t &size) noexcept
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes {};
+    CountSyscall();
+    if (!::GetFileAttributesExW(std::filesystem::path(path).c_str(), GetFileExInfoStandard, &attributes)
+            || (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) [[unlikely]]
+        return false;
+    size = (static_cast<std::size_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    return true;
+}
+
+std::size_t IO::Native::ReadAt(const Handle handle, std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        const auto chunk = static_cast<DWORD>(std::min<std::size_t>(size - total, MAXDWORD));
+        const auto position = offset + total;
+        OVERLAPPED overlapped {};
+        overlapped.Offset = static_cast<DWORD>(position);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<std::uint64_t>(position) >> 32);
+        DWORD count {};
+        CountSyscall();
+        if (!::ReadFile(reinterpret_cast<HANDLE>(handle), data + total, chunk, &count, &overlapped) || !count)
+            break;
+        total += count;
+    }
+    return total;
+}
+
+std::size_t IO::Native::WriteAt(const Handle handle, const std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        const auto chunk = static_cast<DWORD>(std::min<std::size_t>(size - total, MAXDWORD));
+        const auto position = offset + total;
+        OVERLAPPED overlapped {};
+        overlapped.Offset = static_cast<DWORD>(position);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<std::uint64_t>(position) >> 32);
+        DWORD count {};
+        CountSyscall();
+        if (!::WriteFile(reinterpret_cast<HANDLE>(handle), data + total, chunk, &count, &overlapped) || !count)
+            break;
+        total += count;
+    }
+    return total;
+}
+
+std::size_t IO::Native::Append(const Handle handle, const std::uint8_t * const data, const std::size_t size) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        const auto chunk = static_cast<DWORD>(std::min<std::size_t>(size - total, MAXDWORD));
+        OVERLAPPED overlapped {};
+        overlapped.Offset = MAXDWORD; // Both offsets set to MAXDWORD write at the end of file
+        overlapped.OffsetHigh = MAXDWORD;
+        DWORD count {};
+        CountSyscall();
+        if (!::WriteFile(reinterpret_cast<HANDLE>(handle), data + total, chunk, &count, &overlapped) || !count)
+            break;
+        total += count;
+    }
+    return total;
+}
+
+std::size_t IO::Native::AppendVector(const Handle handle, const ResourceView * const buffers, const std::uint32_t count) noexcept
+{
+    std::size_t total {};
+    for (auto index = 0u; index != count; ++index) {
+        const auto writeCount = Append(handle, buffers[index].from, buffers[index].size());
+        total += writeCount;
+        if (writeCount != buffers[index].size())
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Native::ReadVectorAt(const Handle handle, const BufferView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept
+{
+    // Scatter reads require page sized and aligned buffers (ReadFileScatter), buffers are read one by one
+    std::size_t total {};
+    for (auto index = 0u; index != count; ++index) {
+        const auto readCount = ReadAt(handle, buffers[index].from, buffers[index].size(), offset + total);
+        total += readCount;
+        if (readCount != buffers[index].size())
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Native::WriteVectorAt(const Handle handle, const ResourceView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    for (auto index = 0u; index != count; ++index) {
+        const auto writeCount = WriteAt(handle, buffers[index].from, buffers[index].size(), offset + total);
+        total += writeCount;
+        if (writeCount != buffers[index].size())
+            break;
+    }
+    return total;
+}
+
+bool IO::Native::Preallocate(const Handle handle, const std::size_t offset, const std::size_t size) noexcept
+{
+    FILE_ALLOCATION_INFO info {};
+    info.AllocationSize.QuadPart = static_cast<LONGLONG>(offset + size);
+    CountSyscall();
+    return ::SetFileInformationByHandle(reinterpret_cast<HANDLE>(handle), FileAllocationInfo, &info, sizeof(info));
+}
+
+bool IO::Native::Resize(const Handle handle, const std::size_t size) noexcept
+{
+    FILE_END_OF_FILE_INFO info {};
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+    CountSyscall();
+    return ::SetFileInformationByHandle(reinterpret_cast<HANDLE>(handle), FileEndOfFileInfo, &info, sizeof(info));
+}
+
+bool IO::Native::Clone(const Handle, const Handle) noexcept
+{
+    return false;
+}
+
+std::size_t IO::Native::CopyRange(const Handle, const Handle, const std::size_t, const std::size_t) noexcept
+{
+    return 0u;
+}
+
+std::size_t IO::Native::SendFile(const Handle, const Handle, const std::size_t, const std::size_t) noexcept
+{
+    return 0u;
+}
+
+void IO::Native::StartSync(const Handle) noexcept
+{
+}
+
+bool IO::Native::Sync(const Handle handle, const bool) noexcept
+{
+    CountSyscall();
+    return ::FlushFileBuffers(reinterpret_cast<HANDLE>(handle));
+}
+
+bool IO::Native::SyncAll(const Handle * const from, const Handle * const to) noexcept
+{
+    bool success = true;
+    for (auto it = from; it != to; ++it)
+        success &= Sync(*it, true);
+    return success;
+}
+
+bool IO::Native::SyncDirectory(const std::string_view &) noexcept
+{
+    return true;
+}
+
+bool IO::Native::Rename(const std::string_view &from, const std::string_view &to) noexcept
+{
+    CountSyscall();
+    return ::MoveFileExW(
+        std::filesystem::path(from).c_str(),
+        std::filesystem::path(to).c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH
+    );
+}
+
+IO::ResourceView IO::Native::Map(const Handle handle, const std::size_t size) noexcept
+{
+    if (!size) [[unlikely]]
+        return ResourceView {};
+    CountSyscall();
+    const auto mapping = ::CreateFileMappingW(reinterpret_cast<HANDLE>(handle), nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) [[unlikely]]
+        return ResourceView {};
+    const auto data = reinterpret_cast<const std::uint8_t *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size));
+    ::CloseHandle(mapping); // The view keeps the mapping object alive
+    if (!data) [[unlikely]]
+        return ResourceView {};
+    return ResourceView { .from = data, .to = data + size };
+}
+
+IO::ResourceView IO::Native::Remap(const Handle handle, const ResourceView &mapping, const std::size_t size) noexcept
+{
+    Unmap(mapping);
+    return Map(handle, size);
+}
+
+void IO::Native::Unmap(const ResourceView &mapping) noexcept
+{
+    if (mapping.from) {
+        CountSyscall();
+        ::UnmapViewOfFile(mapping.from);
+    }
+}
+
+void IO::Native::AdviseMapping(const ResourceView &range, const AccessHint hint) noexcept
+{
+    if (hint != AccessHint::WillNeed || range.empty())
+        return;
+    WIN32_MEMORY_RANGE_ENTRY entry {};
+    entry.VirtualAddress = const_cast<std::uint8_t *>(range.from);
+    entry.NumberOfBytes = range.size();
+    CountSyscall();
+    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &entry, 0);
+}
+
+#else
+
+IO::Native::Handle IO::Native::Open(const std::string_view &path, const bool read, const bool write) noexcept
+{
+    const int flags = (read && write ? O_RDWR : write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY)
+        | O_CLOEXEC;
+    CountSyscall();
+    const auto descriptor = ::open(std::filesystem::path(path).c_str(), flags, 0644);
+    return descriptor < 0 ? InvalidHandle : static_cast<Handle>(descriptor);
+}
+
+IO::Native::Handle IO::Native::OpenDirect(const std::string_view &path, const bool read, const bool write, bool &direct) noexcept
+{
+    // Unaligned writes read back the blocks they partially cover
+    const int flags = (read && write ? O_RDWR : write ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY)
+        | O_CLOEXEC;
+#if defined(O_DIRECT)
+    CountSyscall();
+    const auto descriptor = ::open(std::filesystem::path(path).c_str(), flags | O_DIRECT, 0644);
+    direct = descriptor >= 0;
+    if (direct) [[likely]]
+        return static_cast<Handle>(descriptor);
+    else if (errno != EINVAL) // Any other error isn't related to unbuffered I/O
+        return InvalidHandle;
+    return Open(path, read, write);
+#else
+    const auto handle = Open(path, read, write);
+# if defined(F_NOCACHE)
+    CountSyscall();
+    direct = handle != InvalidHandle && ::fcntl(static_cast<int>(handle), F_NOCACHE, 1) == 0;
+# else
+    direct = false;
+# endif
+    return handle;
+#endif
+}
+
+IO::Native::Handle IO::Native::OpenAppend(const std::string_view &path) noexcept
+{
+    CountSyscall();
+    const auto descriptor = ::open(std::filesystem::path(path).c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    return descriptor < 0 ? InvalidHandle : static_cast<Handle>(descriptor);
+}
+
+void IO::Native::Close(const Handle handle) noexcept
+{
+    CountSyscall();
+    ::close(static_cast<int>(handle));
+}
+
+void IO::Native::DropCache(const Handle handle, const std::size_t offset, const std::size_t size) noexcept
+{
+#if defined(POSIX_FADV_DONTNEED)
+    CountSyscall();
+    ::posix_fadvise(static_cast<int>(handle), static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_DONTNEED);
+#else
+    static_cast<void>(handle);
+    static_cast<void>(offset);
+    static_cast<void>(size);
+#endif
+}
+
+void IO::Native::Advise(const Handle handle, const AccessHint hint, const std::size_t offset, const std::size_t size) noexcept
+{
+#if defined(__linux__)
+    // A null count also extends the readahead up to the end of the file
+    if (hint == AccessHint::WillNeed) {
+        CountSyscall();
+        ::readahead(static_cast<int>(handle), static_cast<off64_t>(offset), size);
+        return;
+    }
+#endif
+#if defined(POSIX_FADV_NORMAL)
+    int advice {};
+    switch (hint) {
+    case AccessHint::Normal:
+        advice = POSIX_FADV_NORMAL;
+        break;
+    case AccessHint::Sequential:
+        advice = POSIX_FADV_SEQUENTIAL;
+        break;
+    case AccessHint::Random:
+        advice = POSIX_FADV_RANDOM;
+        break;
+    case AccessHint::WillNeed:
+        advice = POSIX_FADV_WILLNEED;
+        break;
+    case AccessHint::DontNeed:
+        advice = POSIX_FADV_DONTNEED;
+        break;
+    }
+    CountSyscall();
+    ::posix_fadvise(static_cast<int>(handle), static_cast<off_t>(offset), static_cast<off_t>(size), advice);
+#else
+    static_cast<void>(handle);
+    static_cast<void>(hint);
+    static_cast<void>(offset);
+    static_cast<void>(size);
+#endif
+}
+
+std::size_t IO::Native::Size(const Handle handle) noexcept
+{
+    struct stat status {};
+    CountSyscall();
+    if (::fstat(static_cast<int>(handle), &status)) [[unlikely]]
+        return 0u;
+    return static_cast<std::size_t>(status.st_size);
+}
+
+bool IO::Native::SizeOf(const std::string_view &path, std::size_t &size) noexcept
+{
+    struct stat status {};
+    CountSyscall();
+    if (::stat(std::filesystem::path(path).c_str(), &status) || !S_ISREG(status.st_mode)) [[unlikely]]
+        return false;
+    size = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+std::size_t IO::Native::ReadAt(const Handle handle, std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        CountSyscall();
+        const auto count = ::pread(static_cast<int>(handle), data + total, size - total, static_cast<off_t>(offset + total));
+        if (count > 0) [[likely]]
+            total += static_cast<std::size_t>(count);
+        else if (count < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Native::WriteAt(const Handle handle, const std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        CountSyscall();
+        const auto count = ::pwrite(static_cast<int>(handle), data + total, size - total, static_cast<off_t>(offset + total));
+        if (count > 0) [[likely]]
+            total += static_cast<std::size_t>(count);
+        else if (count < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Native::Append(const Handle handle, const std::uint8_t * const data, const std::size_t size) noexcept
+{
+    std::size_t total {};
+    while (total != size) {
+        CountSyscall();
+        const auto count = ::write(static_cast<int>(handle), data + total, size - total);
+        if (count > 0) [[likely]]
+            total += static_cast<std::size_t>(count);
+        else if (count < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+    return total;
+}
+
+std::size_t IO::Native::AppendVector(const Handle handle, const ResourceView * const buffers, const std::uint32_t count) noexcept
+{
+    // The position is ignored, appends always go to the end of file
+    return TransferVector(buffers, count, 0u, [handle](const iovec * const vectors, const int vectorCount, const off_t) {
+        return ::writev(static_cast<int>(handle), vectors, vectorCount);
+    });
+}
+
+std::size_t IO::Native::ReadVectorAt(const Handle handle, const BufferView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept
+{
+    return TransferVector(buffers, count, offset, [handle](const iovec * const vectors, const int vectorCount, const off_t position) {
+        return ::preadv(static_cast<int>(handle), vectors, vectorCount, position);
+    });
+}
+
+std::size_t IO::Native::WriteVectorAt(const Handle handle, const ResourceView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept
+{
+    return TransferVector(buffers, count, offset, [handle](const iovec * const vectors, const int vectorCount, const off_t position) {
+        return ::pwritev(static_cast<int>(handle), vectors, vectorCount, position);
+    });
+}
+
+bool IO::Native::Preallocate(const Handle handle, const std::size_t offset, const std::size_t size) noexcept
+{
+#if defined(__linux__)
+    CountSyscall();
+    return !::fallocate(static_cast<int>(handle), FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(size));
+#elif defined(__APPLE__)
+    // Reserves 'size' bytes after the currently allocated space, 'offset' can't be chosen
+    static_cast<void>(offset);
+    fstore_t store { F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0 };
+    CountSyscall();
+    return ::fcntl(static_cast<int>(handle), F_PREALLOCATE, &store) != -1;
+#else
+    static_cast<void>(handle);
+    static_cast<void>(offset);
+    static_cast<void>(size);
+    return false;
+#endif
+}
+
+bool IO::Native::Resize(const Handle handle, const std::size_t size) noexcept
+{
+    CountSyscall();
+    return !::ftruncate(static_cast<int>(handle), static_cast<off_t>(size));
+}
+
+bool IO::Native::Clone(const Handle from, const Handle to) noexcept
+{
+#if defined(__linux__)
+    CountSyscall();
+    return !::ioctl(static_cast<int>(to), FICLONE, static_cast<int>(from));
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    return false;
+#endif
+}
+
+std::size_t IO::Native::CopyRange(const Handle from, const Handle to, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+#if defined(__linux__)
+    while (total != size) {
+        auto input = static_cast<off_t>(offset + total);
+        auto output = input;
+        CountSyscall();
+        const auto count = ::copy_file_range(static_cast<int>(from), &input, static_cast<int>(to), &output, size - total, 0u);
+        if (count > 0) [[likely]]
+            total += static_cast<std::size_t>(count);
+        else if (count < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    static_cast<void>(size);
+    static_cast<void>(offset);
+#endif
+    return total;
+}
+
+std::size_t IO::Native::SendFile(const Handle from, const Handle to, const std::size_t size, const std::size_t offset) noexcept
+{
+    std::size_t total {};
+#if defined(__linux__)
+    CountSyscall();
+    if (::lseek(static_cast<int>(to), static_cast<off_t>(offset), SEEK_SET) < 0) [[unlikely]]
+        return 0u;
+    while (total != size) {
+        auto input = static_cast<off_t>(offset + total);
+        CountSyscall();
+        const auto count = ::sendfile(static_cast<int>(to), static_cast<int>(from), &input, size - total);
+        if (count > 0) [[likely]]
+            total += static_cast<std::size_t>(count);
+        else if (count < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    static_cast<void>(size);
+    static_cast<void>(offset);
+#endif
+    return total;
+}
+
+void IO::Native::StartSync(const Handle handle) noexcept
+{
+#if defined(__linux__)
+    CountSyscall();
+    ::sync_file_range(static_cast<int>(handle), 0, 0, SYNC_FILE_RANGE_WRITE);
+#else
+    static_cast<void>(handle);
+#endif
+}
+
+bool IO::Native::Sync(const Handle handle, const bool dataOnly) noexcept
+{
+    CountSyscall();
+#if defined(__APPLE__)
+    // fsync doesn't flush the drive cache on Apple platforms
+    static_cast<void>(dataOnly);
+    return !::fcntl(static_cast<int>(handle), F_FULLFSYNC) || !::fsync(static_cast<int>(handle));
+#else
+    return !(dataOnly ? ::fdatasync(static_cast<int>(handle)) : ::fsync(static_cast<int>(handle)));
+#endif
+}
+
+bool IO::Native::SyncAll(const Handle * const from, const Handle * const to) noexcept
+{
+    bool success = true;
+#if defined(__linux__)
+    struct FileSystem
+    {
+        dev_t device {};
+        Handle handle { InvalidHandle };
+        std::uint32_t count {};
+    };
+    Core::Vector<FileSystem, IOAllocator> fileSystems {};
+    for (auto it = from; it != to; ++it) {
+        struct stat status {};
+        CountSyscall();
+        if (::fstat(static_cast<int>(*it), &status)) [[unlikely]]
+            return false;
+        const auto fileSystem = fileSystems.find([&status](const FileSystem &other) { return other.device == status.st_dev; });
+        if (fileSystem != fileSystems.end())
+            ++fileSystem->count;
+        else
+            fileSystems.push(FileSystem { .device = status.st_dev, .handle = *it, .count = 1u });
+    }
+    for (const auto &fileSystem : fileSystems) {
+        // A lone file is cheaper to sync than the whole file system
+        if (fileSystem.count == 1u)
+            success &= Sync(fileSystem.handle, true);
+        else {
+            CountSyscall();
+            success &= !::syncfs(static_cast<int>(fileSystem.handle));
+        }
+    }
+#else
+    for (auto it = from; it != to; ++it)
+        success &= Sync(*it, true);
+#endif
+    return success;
+}
+
+bool IO::Native::SyncDirectory(const std::string_view &path) noexcept
+{
+    CountSyscall();
+    const auto descriptor = ::open(std::filesystem::path(path.empty() ? std::string_view(".") : path).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (descriptor < 0) [[unlikely]]
+        return false;
+    CountSyscall();
+    const bool success = !::fsync(descriptor);
+    CountSyscall();
+    ::close(descriptor);
+    return success;
+}
+
+bool IO::Native::Rename(const std::string_view &from, const std::string_view &to) noexcept
+{
+    CountSyscall();
+    return !::rename(std::filesystem::path(from).c_str(), std::filesystem::path(to).c_str());
+}
+
+IO::ResourceView IO::Native::Map(const Handle handle, const std::size_t size) noexcept
+{
+    if (!size) [[unlikely]]
+        return ResourceView {};
+    CountSyscall();
+    const auto data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, static_cast<int>(handle), 0);
+    if (data == MAP_FAILED) [[unlikely]]
+        return ResourceView {};
+    const auto from = reinterpret_cast<const std::uint8_t *>(data);
+    return ResourceView { .from = from, .to = from + size };
+}
+
+IO::ResourceView IO::Native::Remap(const Handle handle, const ResourceView &mapping, const std::size_t size) noexcept
+{
+#if defined(__linux__)
+    if (mapping.from && size) {
+        CountSyscall();
+        const auto data = ::mremap(const_cast<std::uint8_t *>(mapping.from), mapping.size(), size, MREMAP_MAYMOVE);
+        if (data != MAP_FAILED) [[likely]] {
+            const auto from = reinterpret_cast<const std::uint8_t *>(data);
+            return ResourceView { .from = from, .to = from + size };
+        }
+    }
+#endif
+    Unmap(mapping);
+    return Map(handle, size);
+}
+
+void IO::Native::Unmap(const ResourceView &mapping) noexcept
+{
+    if (mapping.from) {
+        CountSyscall();
+        ::munmap(const_cast<std::uint8_t *>(mapping.from), mapping.size());
+    }
+}
+
+void IO::Native::AdviseMapping(const ResourceView &range, const AccessHint hint) noexcept
+{
+    static const auto PageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+
+    int advice {};
+    switch (hint) {
+    case AccessHint::Normal:
+        advice = MADV_NORMAL;
+        break;
+    case AccessHint::Sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case AccessHint::Random:
+        advice = MADV_RANDOM;
+        break;
+    case AccessHint::WillNeed:
+        advice = MADV_WILLNEED;
+        break;
+    case AccessHint::DontNeed:
+        advice = MADV_DONTNEED;
+        break;
+    }
+    // Dropping pages only partially covered by the range would discard memory lying outside of it
+    auto from = reinterpret_cast<std::uintptr_t>(range.from);
+    auto to = reinterpret_cast<std::uintptr_t>(range.to);
+    if (hint == AccessHint::DontNeed) {
+        from = (from + PageSize - 1) & ~(PageSize - 1);
+        to &= ~(PageSize - 1);
+    } else
+        from &= ~(PageSize - 1);
+    if (from >= to)
+        return;
+    CountSyscall();
+    ::madvise(reinterpret_cast<void *>(from), to - from, advice);
+}
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Native
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "Base.hpp"
+
+/** @brief Thin wrappers over the operating system file API, used by the IO library backends */
+namespace kF::IO::Native
+{
+    /** @brief Native file handle (file descriptor on POSIX, HANDLE on Windows) */
+    using Handle = std::intptr_t;
+
+    /** @brief Invalid native handle */
+    constexpr Handle InvalidHandle = -1;
+
+    /** @brief Hint about how a file range will be accessed */
+    enum class AccessHint : std::uint8_t
+    {
+        Normal,     // Default readahead
+        Sequential, // Aggressive readahead, pages may be dropped soon after being read
+        Random,     // No readahead
+        WillNeed,   // Start reading the range into the page cache
+        DontNeed    // Drop the cached pages of the range
+    };
+
+
+    /** @brief Open a file at 'path'
+     *  @note Write-only opening creates or truncates the file, read and write opening requires the file to exist
+     *  @return InvalidHandle on failure */
+    [[nodiscard]] Handle Open(const std::string_view &path, const bool read, const bool write) noexcept;
+
+    /** @brief Open a file at 'path' bypassing the page cache (O_DIRECT, F_NOCACHE, FILE_FLAG_NO_BUFFERING)
+     *  @note Falls back to a buffered handle when the file system doesn't support it (e.g. tmpfs)
+     *  @note Unbuffered write-only handles are also readable, partially written blocks must be read back
+     *  @param direct Set to true if the returned handle is unbuffered
+     *  @return InvalidHandle on failure */
+    [[nodiscard]] Handle OpenDirect(const std::string_view &path, const bool read, const bool write, bool &direct) noexcept;
+
+    /** @brief Open a file at 'path' for appending, creating it if required (O_APPEND)
+     *  @note Every write goes to the end of file, whatever its offset and other writers
+     *  @return InvalidHandle on failure */
+    [[nodiscard]] Handle OpenAppend(const std::string_view &path) noexcept;
+
+    /** @brief Close a native handle */
+    void Close(const Handle handle) noexcept;
+
+    /** @brief Drop the cached pages of a file range
+     *  @note Dirty pages are kept, start their writeback first (see 'StartSync') */
+    void DropCache(const Handle handle, const std::size_t offset, const std::size_t size) noexcept;
+
+    /** @brief Give the kernel a hint about how 'size' bytes at 'offset' of a file will be accessed (posix_fadvise, readahead)
+     *  @note A null 'size' extends the range to the end of the file
+     *  @note Does nothing on platforms without access hints */
+    void Advise(const Handle handle, const AccessHint hint, const std::size_t offset, const std::size_t size) noexcept;
+
+    /** @brief Get the size of an opened file
+     *  @return 0 on failure */
+    [[nodiscard]] std::size_t Size(const Handle handle) noexcept;
+
+    /** @brief Get the size of the regular file at 'path' without opening it
+     *  @return False if 'path' doesn't exist or isn't a regular file */
+    [[nodiscard]] bool SizeOf(const std::string_view &path, std::size_t &size) noexcept;
+
+
+    /** @brief Read up to 'size' bytes at 'offset' without changing the file position
+     *  @return The number of bytes read, less than 'size' on end of file or failure */
+    [[nodiscard]] std::size_t ReadAt(const Handle handle, std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept;
+
+    /** @brief Write 'size' bytes at 'offset' without changing the file position
+     *  @return The number of bytes written, less than 'size' on failure */
+    [[nodiscard]] std::size_t WriteAt(const Handle handle, const std::uint8_t * const data, const std::size_t size, const std::size_t offset) noexcept;
+
+    /** @brief Append 'size' bytes to a file opened with 'OpenAppend', without seeking
+     *  @return The number of bytes written, less than 'size' on failure */
+    [[nodiscard]] std::size_t Append(const Handle handle, const std::uint8_t * const data, const std::size_t size) noexcept;
+
+    /** @brief Append 'count' buffers, in order, to a file opened with 'OpenAppend' (writev)
+     *  @note Emulated with one write per buffer on platforms without vectored transfers
+     *  @return The number of bytes written, less than the total size of buffers on failure */
+    [[nodiscard]] std::size_t AppendVector(const Handle handle, const ResourceView * const buffers, const std::uint32_t count) noexcept;
+
+    /** @brief Read at 'offset' scattering data into 'count' buffers, in order, without changing the file position (preadv)
+     *  @note Emulated with one read per buffer on platforms without vectored transfers
+     *  @return The number of bytes read, less than the total size of buffers on end of file or failure */
+    [[nodiscard]] std::size_t ReadVectorAt(const Handle handle, const BufferView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept;
+
+    /** @brief Write at 'offset' gathering data from 'count' buffers, in order, without changing the file position (pwritev)
+     *  @note Emulated with one write per buffer on platforms without vectored transfers
+     *  @return The number of bytes written, less than the total size of buffers on failure */
+    [[nodiscard]] std::size_t WriteVectorAt(const Handle handle, const ResourceView * const buffers, const std::uint32_t count, const std::size_t offset) noexcept;
+
+
+    /** @brief Reserve disk space for 'size' bytes at 'offset' without changing the file size (fallocate, F_PREALLOCATE)
+     *  @note Space reserved past the end of file is released by 'Resize'
+     *  @return False if the space couldn't be reserved or if the platform can't reserve space */
+    [[nodiscard]] bool Preallocate(const Handle handle, const std::size_t offset, const std::size_t size) noexcept;
+
+    /** @brief Resize an opened file to 'size' bytes
+     *  @return False on failure */
+    [[nodiscard]] bool Resize(const Handle handle, const std::size_t size) noexcept;
+
+    /** @brief Share the extents of 'from' with 'to' (reflink, copy-on-write clone)
+     *  @return False if the file system doesn't support cloning or on failure */
+    [[nodiscard]] bool Clone(const Handle from, const Handle to) noexcept;
+
+    /** @brief Copy 'size' bytes at 'offset' from 'from' into 'to' inside the kernel (copy_file_range)
+     *  @note Several threads may copy disjoint ranges between the same handles concurrently
+     *  @return The number of bytes copied, less than 'size' if the kernel can't copy between the handles or on failure */
+    [[nodiscard]] std::size_t CopyRange(const Handle from, const Handle to, const std::size_t size, const std::size_t offset) noexcept;
+
+    /** @brief Copy 'size' bytes at 'offset' from 'from' into 'to' inside the kernel (sendfile)
+     *  @note Slower fallback of 'CopyRange' which moves the file position of 'to', it can't be used concurrently
+     *  @return The number of bytes copied, less than 'size' if the kernel can't copy between the handles or on failure */
+    [[nodiscard]] std::size_t SendFile(const Handle from, const Handle to, const std::size_t size, const std::size_t offset) noexcept;
+
+
+    /** @brief Start writing back the dirty pages of a file without waiting for them
+     *  @note Does nothing on platforms without asynchronous write-back, 'Sync' must still be called for durability */
+    void StartSync(const Handle handle) noexcept;
+
+    /** @brief Flush file data (and metadata unless 'dataOnly') to the storage device
+     *  @return False on failure */
+    [[nodiscard]] bool Sync(const Handle handle, const bool dataOnly = false) noexcept;
+
+    /** @brief Flush the data of every file of 'from, to' to the storage devices at once
+     *  @note On Linux a file system holding several of the files is synced a single time (syncfs),
+     *      committing its journal once instead of once per file. Other platforms sync the data of each file
+     *  @return False on failure, without telling which file failed */
+    [[nodiscard]] bool SyncAll(const Handle * const from, const Handle * const to) noexcept;
+
+    /** @brief Make the entries of a directory (created, renamed files) durable
+     *  @note Does nothing on Windows where renames are made durable by 'Rename' */
+    [[nodiscard]] bool SyncDirectory(const std::string_view &path) noexcept;
+
+    /** @brief Atomically rename 'from' to 'to', replacing 'to' if it exists
+     *  @return False on failure */
+    [[nodiscard]] bool Rename(const std::string_view &from, const std::string_view &to) noexcept;
+
+
+    /** @brief Map 'size' bytes of an opened file into memory (read-only)
+     *  @return An empty view on failure */
+    [[nodiscard]] ResourceView Map(const Handle handle, const std::size_t size) noexcept;
+
+    /** @brief Resize an existing mapping to 'size' bytes
+     *  @note The mapping may be moved, the previous view must not be used anymore */
+    [[nodiscard]] ResourceView Remap(const Handle handle, const ResourceView &mapping, const std::size_t size) noexcept;
+
+    /** @brief Unmap a mapping previously created by 'Map' or 'Remap' */
+    void Unmap(const ResourceView &mapping) noexcept;
+
+    /** @brief Give the kernel a hint about how a range of mapped memory will be accessed (madvise, PrefetchVirtualMemory)
+     *  @note 'DontNeed' only drops the pages lying entirely inside 'range', other hints cover every page it touches */
+    void AdviseMapping(const ResourceView &range, const AccessHint hint) noexcept;
+}
@@ -0,0 +1,191 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Pack
+ */
+
+#include <algorithm>
+#include <bit>
+
+#include <Kube/Core/Hash.hpp>
+
+#include "BufferedWriter.hpp"
+#include "Compression.hpp"
+#include "Directory.hpp"
+#include "File.hpp"
+#include "Pack.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Check if a range of a pack lies inside of it, without overflowing on corrupted offsets */
+    [[nodiscard]] constexpr bool IsInside(const std::uint64_t offset, const std::uint64_t length, const std::uint64_t size) noexcept
+        { return offset <= size && length <= size - offset; }
+}
+
+const IO::Pack::Header *IO::Pack::Validate(const ResourceView &pack) noexcept
+{
+    if (pack.size() < sizeof(Header)) [[unlikely]]
+        return nullptr;
+    const auto header = reinterpret_cast<const Header *>(pack.from);
+    const auto size = static_cast<std::uint64_t>(pack.size());
+    const auto indexSize = static_cast<std::uint64_t>(header->indexCapacity) * sizeof(Entry);
+    if (header->magic != Magic || header->version != Version
+            || !std::has_single_bit(header->indexCapacity) || header->entryCount >= header->indexCapacity
+            || header->indexOffset % alignof(Entry) || header->indexOffset < sizeof(Header)
+            || !IsInside(header->indexOffset, indexSize, size) || !IsInside(header->namesOffset, header->namesSize, size)) [[unlikely]]
+        return nullptr;
+    return header;
+}
+
+const IO::Pack::Entry *IO::Pack::Find(const ResourceView &pack, const Core::HashedName hash, const std::string_view * const path) noexcept
+{
+    const auto header = reinterpret_cast<const Header *>(pack.from);
+    const auto index = GetIndex(pack);
+    const auto mask = header->indexCapacity - 1u;
+    auto probe = ProbeIndex(hash, mask);
+    for (auto count = 0u; count != header->indexCapacity; ++count, probe = (probe + 1u) & mask) {
+        const auto &entry = index.from[probe];
+        if (!Core::HasFlags(entry.flags, EntryFlags::Used))
+            return nullptr;
+        else if (entry.path != hash)
+            continue;
+        // Entries are checked on access so mounting never walks the index
+        else if (!IsInside(entry.offset, entry.size, pack.size())
+                || static_cast<std::uint64_t>(entry.nameOffset) + entry.nameSize > header->namesSize) [[unlikely]]
+            return nullptr;
+        else if (path ? GetName(pack, entry) == *path : !Core::HasFlags(entry.flags, EntryFlags::Ambiguous))
+            return &entry;
+    }
+    return nullptr;
+}
+
+bool IO::Pack::BuildFromDirectory(const std::string_view &directory, const std::string_view &output,
+        const bool compress, const std::uint32_t alignment) noexcept
+{
+    DirectoryListing listing;
+    if (!WalkDirectory(directory, listing))
+        return false;
+    listing.sort();
+
+    Builder builder(alignment);
+    Core::Vector<std::uint8_t, IOAllocator, std::size_t> data;
+    for (const auto entry : listing) {
+        if (entry.type != EntryType::File)
+            continue;
+        File file(entry.path, File::Mode::ReadBinary);
+        if (!file.readAll(data))
+            return false;
+        std::string path(entry.path.substr(std::min(entry.path.size(), directory.size() + 1u)));
+        std::replace(path.begin(), path.end(), '\\', '/');
+        builder.add(path, ResourceView { .from = data.begin(), .to = data.end() }, compress);
+    }
+    return builder.write(output);
+}
+
+IO::Pack::Builder::Builder(const std::uint32_t alignment) noexcept
+    : _alignment(std::max(alignment, 1u))
+{
+}
+
+void IO::Pack::Builder::add(const std::string_view &path, const ResourceView &data, const bool compress) noexcept
+{
+    auto &resource = _resources.push(Resource { .path = Core::SmallString<IOAllocator>(path) });
+    if (compress) {
+        Compression::Compress(data, resource.data);
+        if (resource.data.size() < data.size()) {
+            resource.compressed = true;
+            return;
+        }
+    }
+    resource.data.resize(data.size());
+    std::copy(data.begin(), data.end(), resource.data.begin());
+}
+
+bool IO::Pack::Builder::write(const std::string_view &output) const noexcept
+{
+    const auto alignUp = [this](const std::uint64_t value) { return (value + _alignment - 1u) / _alignment * _alignment; };
+
+    // Collect every directory leading to a resource once
+    Core::Vector<std::string_view, IOAllocator> directories;
+    for (const auto &resource : _resources) {
+        const auto path = resource.path.toView();
+        for (auto separator = path.find('/'); separator != std::string_view::npos; separator = path.find('/', separator + 1))
+            directories.push(path.substr(0, separator));
+    }
+    std::sort(directories.begin(), directories.end());
+    directories.erase(std::unique(directories.begin(), directories.end()), directories.end());
+
+    const auto entryCount = _resources.size() + directories.size();
+    Header header {
+        .magic = Magic,
+        .version = Version,
+        .entryCount = entryCount,
+        .indexCapacity = std::bit_ceil(std::max(entryCount * 2u, 2u)),
+        .indexOffset = sizeof(Header),
+        .alignment = _alignment
+    };
+
+    // Place names then data, and fill the index exactly as it will be probed
+    Core::Vector<Entry, IOAllocator> index(header.indexCapacity);
+    Core::Vector<char, IOAllocator, std::size_t> names;
+    header.namesOffset = header.indexOffset + header.indexCapacity * sizeof(Entry);
+    for (const auto &resource : _resources)
+        header.namesSize += resource.path.size();
+    for (const auto &directory : directories)
+        header.namesSize += directory.size();
+    const auto mask = header.indexCapacity - 1u;
+    const auto insert = [&index, &names, mask](const std::string_view &name, Entry entry) {
+        entry.path = Core::Hash(name);
+        auto probe = ProbeIndex(entry.path, mask);
+        for (; Core::HasFlags(index[probe].flags, EntryFlags::Used); probe = (probe + 1u) & mask) {
+            auto &other = index[probe];
+            if (other.path != entry.path) [[likely]]
+                continue;
+            else if (std::string_view(names.data() + other.nameOffset, other.nameSize) == name)
+                return false;
+            other.flags = static_cast<EntryFlags>(Core::ToUnderlying(other.flags) | Core::ToUnderlying(EntryFlags::Ambiguous));
+            entry.flags = static_cast<EntryFlags>(Core::ToUnderlying(entry.flags) | Core::ToUnderlying(EntryFlags::Ambiguous));
+        }
+        entry.nameOffset = static_cast<std::uint32_t>(names.size());
+        entry.nameSize = static_cast<std::uint32_t>(name.size());
+        index[probe] = entry;
+        names.insert(names.end(), name.begin(), name.end());
+        return true;
+    };
+    auto offset = alignUp(header.namesOffset + header.namesSize);
+    for (const auto &resource : _resources) {
+        const auto inserted = insert(resource.path.toView(), Entry {
+            .flags = resource.compressed
+                ? static_cast<EntryFlags>(Core::ToUnderlying(EntryFlags::Used) | Core::ToUnderlying(EntryFlags::Compressed))
+                : EntryFlags::Used,
+            .offset = offset,
+            .size = resource.data.size()
+        });
+        if (!inserted) [[unlikely]]
+            return false;
+        offset = alignUp(offset + resource.data.size());
+    }
+    for (const auto &directory : directories) {
+        const auto flags = static_cast<EntryFlags>(Core::ToUnderlying(EntryFlags::Used) | Core::ToUnderlying(EntryFlags::Directory));
+        if (!insert(directory, Entry { .flags = flags })) [[unlikely]]
+            return false;
+    }
+
+    File file(output, File::Mode::WriteBinary);
+    if (!file.tryOpen())
+        return false;
+    BufferedWriter writer(file);
+    const Core::Vector<std::uint8_t, IOAllocator, std::size_t> padding(_alignment);
+    const auto pad = [&writer, &padding, &alignUp] {
+        const auto count = static_cast<std::size_t>(alignUp(writer.offset()) - writer.offset());
+        return writer.write(padding.begin(), padding.begin() + count);
+    };
+    bool success = writer.writeValue(header)
+        && writer.write(reinterpret_cast<const std::uint8_t *>(index.begin()), reinterpret_cast<const std::uint8_t *>(index.end()))
+        && writer.writeAll(names)
+        && pad();
+    for (auto it = _resources.begin(); success && it != _resources.end(); ++it)
+        success = writer.writeAll(it->data) && pad();
+    return writer.flush() && success;
+}
@@ -0,0 +1,141 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Pack
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Core/SmallString.hpp>
+
+#include "Base.hpp"
+
+/** @brief Disk resource pack, mounted as a resource environment by mapping it into memory
+ *
+ *  A pack is made of a header, an open-addressing index keyed by resource path hashes, a table of names and aligned data.
+ *  The index is stored ready to probe so mounting a pack only validates its header, whatever its number of resources.
+ *  Every directory holding resources has its own entry, so directories are found without walking the index. */
+namespace kF::IO::Pack
+{
+    class Builder;
+
+    /** @brief Magic number of a pack ('KFP1') */
+    constexpr std::uint32_t Magic = 0x3150464B;
+
+    /** @brief Current pack version */
+    constexpr std::uint32_t Version = 2;
+
+    /** @brief Default alignment of resource data */
+    constexpr std::uint32_t DefaultAlignment = 64;
+
+
+    /** @brief Header of a pack */
+    struct Header
+    {
+        std::uint32_t magic {};
+        std::uint32_t version {};
+        std::uint32_t entryCount {};
+        std::uint32_t indexCapacity {}; // Power of two
+        std::uint64_t indexOffset {};
+        std::uint64_t namesOffset {};
+        std::uint64_t namesSize {};
+        std::uint32_t alignment {};
+        std::uint32_t reserved {};
+    };
+    static_assert(sizeof(Header) == 48, "IO::Pack::Header: Header must be packed");
+
+    /** @brief Flags of an index entry */
+    enum class EntryFlags : std::uint32_t
+    {
+        None        = 0b0000,
+        Used        = 0b0001,
+        Compressed  = 0b0010, // Data is a compressed container (see IO::Compression)
+        Directory   = 0b0100, // Directory holding resources, without data
+        Ambiguous   = 0b1000  // Another entry shares the path hash
+    };
+
+    /** @brief Entry of the index */
+    struct Entry
+    {
+        Core::HashedName path {};
+        EntryFlags flags {};
+        std::uint64_t offset {};
+        std::uint64_t size {};
+        std::uint32_t nameOffset {};
+        std::uint32_t nameSize {};
+    };
+    static_assert(sizeof(Entry) == 32, "IO::Pack::Entry: Entry must be packed");
+
+
+    /** @brief Get the first probe index of a path hash */
+    [[nodiscard]] constexpr std::uint32_t ProbeIndex(const Core::HashedName path, const std::uint32_t mask) noexcept
+        { return (path * 0x9E3779B1u) & mask; }
+
+    /** @brief Check that 'pack' is a valid pack whose tables lie inside its bounds and get its header
+     *  @return A null pointer if the pack is invalid */
+    [[nodiscard]] const Header *Validate(const ResourceView &pack) noexcept;
+
+    /** @brief Get the index of a validated pack */
+    [[nodiscard]] inline Core::IteratorRange<const Entry *> GetIndex(const ResourceView &pack) noexcept
+    {
+        const auto header = reinterpret_cast<const Header *>(pack.from);
+        const auto from = reinterpret_cast<const Entry *>(pack.from + header->indexOffset);
+        return Core::IteratorRange<const Entry *> { .from = from, .to = from + header->indexCapacity };
+    }
+
+    /** @brief Find a resource or directory entry inside a validated pack
+     *  @param path Path of the entry, compared on every hash hit. If null, ambiguous hashes are rejected
+     *  @return A null pointer if the entry doesn't exist */
+    [[nodiscard]] const Entry *Find(const ResourceView &pack, const Core::HashedName hash, const std::string_view * const path) noexcept;
+
+    /** @brief Get the data of an entry */
+    [[nodiscard]] inline ResourceView GetData(const ResourceView &pack, const Entry &entry) noexcept
+        { return ResourceView { .from = pack.from + entry.offset, .to = pack.from + entry.offset + entry.size }; }
+
+    /** @brief Get the path of an entry inside its environment */
+    [[nodiscard]] inline std::string_view GetName(const ResourceView &pack, const Entry &entry) noexcept
+    {
+        const auto header = reinterpret_cast<const Header *>(pack.from);
+        return std::string_view(reinterpret_cast<const char *>(pack.from + header->namesOffset + entry.nameOffset), entry.nameSize);
+    }
+
+
+    /** @brief Build a pack from every file of a disk directory (recursively)
+     *  @return False if the directory couldn't be walked or the pack couldn't be written */
+    [[nodiscard]] bool BuildFromDirectory(const std::string_view &directory, const std::string_view &output,
+            const bool compress = false, const std::uint32_t alignment = DefaultAlignment) noexcept;
+}
+
+/** @brief Collect resources and write them as a pack */
+class kF::IO::Pack::Builder
+{
+public:
+    /** @brief Constructor */
+    Builder(const std::uint32_t alignment = DefaultAlignment) noexcept;
+
+
+    /** @brief Get the number of resources */
+    [[nodiscard]] inline std::uint32_t count(void) const noexcept { return _resources.size(); }
+
+
+    /** @brief Add a resource at 'path' inside the environment, its data is copied
+     *  @param compress Store the resource as a compressed container, kept raw if it doesn't shrink */
+    void add(const std::string_view &path, const ResourceView &data, const bool compress = false) noexcept;
+
+    /** @brief Write the pack
+     *  @note Resources whose path hashes collide are marked ambiguous, they stay reachable by path
+     *  @return False if two resources share a path, a resource path is also a directory or the pack couldn't be written */
+    [[nodiscard]] bool write(const std::string_view &output) const noexcept;
+
+private:
+    /** @brief A resource waiting to be written */
+    struct Resource
+    {
+        Core::SmallString<IOAllocator> path {};
+        Core::Vector<std::uint8_t, IOAllocator, std::size_t> data {};
+        bool compressed {};
+    };
+
+    Core::Vector<Resource, IOAllocator> _resources {};
+    std::uint32_t _alignment {};
+};
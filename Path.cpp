@@ -0,0 +1,191 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Path
+ */
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define KUBE_IO_PATH_SSE2 1
+#endif
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Path.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Index = IO::Path::Index;
+
+    [[nodiscard]] inline bool IsSeparator(const char character) noexcept
+        { return (character == '/') | (character == '\\'); }
+
+    /** @brief Components located by a backward scan */
+    struct ScanResult
+    {
+        Index filenameFrom {};
+        Index extensionFrom {};
+    };
+
+    /** @brief Discard dots that don't start an extension ('.hidden', '..') */
+    [[nodiscard]] inline ScanResult MakeScanResult(const std::string_view &path, const Index filenameFrom, const Index dot) noexcept
+    {
+        const auto size = static_cast<Index>(path.size());
+        if (dot == size || dot == filenameFrom || path.substr(filenameFrom) == "..")
+            return ScanResult { filenameFrom, size };
+        return ScanResult { filenameFrom, dot };
+    }
+
+    /** @brief Find the last separator and the last dot after it in a single backward pass, 16 bytes at a time when possible */
+    [[nodiscard]] ScanResult ScanBackward(const std::string_view &path) noexcept
+    {
+        const auto data = path.data();
+        const auto size = static_cast<Index>(path.size());
+        auto dot = size;
+        auto index = size;
+
+#if KUBE_IO_PATH_SSE2
+        const auto slash = _mm_set1_epi8('/');
+        const auto backslash = _mm_set1_epi8('\\');
+        const auto period = _mm_set1_epi8('.');
+        for (; index >= 16u; index -= 16u) {
+            const auto from = index - 16u;
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+            const auto separators = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(block, slash), _mm_cmpeq_epi8(block, backslash))
+            ));
+            auto dots = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, period)));
+            if (separators) {
+                const auto last = static_cast<Index>(std::bit_width(separators) - 1);
+                dots &= ~((2u << last) - 1u); // Only keep the dots after the last separator
+                if (dots && dot == size)
+                    dot = from + static_cast<Index>(std::bit_width(dots) - 1);
+                return MakeScanResult(path, from + last + 1u, dot);
+            } else if (dots && dot == size)
+                dot = from + static_cast<Index>(std::bit_width(dots) - 1);
+        }
+#endif
+
+        while (index) {
+            --index;
+            if (IsSeparator(data[index]))
+                return MakeScanResult(path, index + 1u, dot);
+            else if (data[index] == '.' && dot == size)
+                dot = index;
+        }
+        return MakeScanResult(path, 0u, dot);
+    }
+
+    /** @brief Call 'function' with a writable buffer of 'size' bytes, on the stack when it is small enough */
+    template<typename Function>
+    [[nodiscard]] inline IO::Path WithBuffer(const std::size_t size, Function &&function) noexcept
+    {
+        if (size <= IO::Path::StackCapacity) {
+            char buffer[IO::Path::StackCapacity];
+            return IO::Path(std::string_view(buffer, function(buffer)));
+        } else {
+            Core::Vector<char, IO::IOAllocator, std::size_t> buffer(size);
+            return IO::Path(std::string_view(buffer.data(), function(buffer.data())));
+        }
+    }
+}
+
+IO::Path::Index IO::Path::FindFilenameIndex(const std::string_view &path) noexcept
+{
+    return ScanBackward(path).filenameFrom;
+}
+
+std::string_view IO::Path::DirectoryOf(const std::string_view &path) noexcept
+{
+    const auto filenameFrom = FindFilenameIndex(path);
+    return path.substr(0, filenameFrom > 1 ? filenameFrom - 1 : filenameFrom);
+}
+
+IO::Path IO::Path::Normalize(const std::string_view &path) noexcept
+{
+    return WithBuffer(path.size() + 1u, [&path](char * const out) {
+        std::size_t count {};
+        std::size_t rootSize {};
+        std::size_t index {};
+
+        // The root and the environment of a resource can't be popped by '..'
+        if (path.starts_with(ResourcePrefix)) {
+            index = static_cast<std::size_t>(std::find_if(path.begin() + EnvironmentBeginIndex, path.end(), IsSeparator) - path.begin());
+            std::copy(path.begin(), path.begin() + static_cast<std::ptrdiff_t>(index), out);
+            count = rootSize = index;
+        } else if (!path.empty() && IsSeparator(path.front())) {
+            out[0] = Separator;
+            count = rootSize = 1u;
+        }
+
+        while (index < path.size()) {
+            if (IsSeparator(path[index])) {
+                ++index;
+                continue;
+            }
+            const auto end = std::find_if(path.begin() + static_cast<std::ptrdiff_t>(index), path.end(), IsSeparator) - path.begin();
+            const auto component = path.substr(index, static_cast<std::size_t>(end) - index);
+            index = static_cast<std::size_t>(end);
+
+            if (component == ".")
+                continue;
+            else if (component == "..") {
+                const auto last = std::find(std::make_reverse_iterator(out + count), std::make_reverse_iterator(out + rootSize), Separator).base();
+                const auto lastComponent = std::string_view(last, out + count);
+                if (count > rootSize && lastComponent != "..") {
+                    count = last == out + rootSize ? rootSize : static_cast<std::size_t>(last - out) - 1u;
+                    continue;
+                } else if (rootSize) // Can't go above the root
+                    continue;
+            }
+            if (count && out[count - 1] != Separator)
+                out[count++] = Separator;
+            std::copy(component.begin(), component.end(), out + count);
+            count += component.size();
+        }
+
+        if (!count)
+            out[count++] = '.';
+        return count;
+    });
+}
+
+IO::Path::Path(const std::string_view &path) noexcept
+    : _path(path)
+{
+    scan();
+}
+
+IO::Path IO::Path::join(const std::string_view &relative) const noexcept
+{
+    if (empty() || (!relative.empty() && IsSeparator(relative.front())) || relative.starts_with(ResourcePrefix))
+        return Path(relative);
+    else if (relative.empty())
+        return *this;
+    const auto left = view();
+    const bool separator = !IsSeparator(left.back());
+    return WithBuffer(left.size() + separator + relative.size(), [&left, &relative, separator](char * const out) {
+        auto it = std::copy(left.begin(), left.end(), out);
+        if (separator)
+            *it++ = Separator;
+        it = std::copy(relative.begin(), relative.end(), it);
+        return static_cast<std::size_t>(it - out);
+    });
+}
+
+void IO::Path::scan(void) noexcept
+{
+    const auto path = view();
+    const auto result = ScanBackward(path);
+    _filenameFrom = result.filenameFrom;
+    _extensionFrom = result.extensionFrom;
+    if (path.starts_with(ResourcePrefix)) {
+        const auto to = path.find(Separator, EnvironmentBeginIndex);
+        _environmentTo = to == std::string_view::npos ? size() : static_cast<Index>(to);
+    } else
+        _environmentTo = 0u;
+}
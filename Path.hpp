@@ -0,0 +1,128 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO Path
+ */
+
+#pragma once
+
+#include <Kube/Core/SmallString.hpp>
+
+#include "Base.hpp"
+
+namespace kF::IO
+{
+    class Path;
+}
+
+/** @brief Path value type which locates its filename, extension and environment once at construction
+ *  @note Both '/' and '\' are separators, normalization always produces '/' */
+class kF::IO::Path
+{
+public:
+    /** @brief Index type */
+    using Index = std::uint32_t;
+
+    /** @brief Separator produced by normalization and joins */
+    static constexpr char Separator = '/';
+
+    /** @brief Size under which normalization and joins are composed on the stack */
+    static constexpr std::size_t StackCapacity = 256;
+
+
+    /** @brief Get the index of the filename of 'path' (just after its last separator) */
+    [[nodiscard]] static Index FindFilenameIndex(const std::string_view &path) noexcept;
+
+    /** @brief Get the directory part of 'path' (without its trailing separator unless it is the root) */
+    [[nodiscard]] static std::string_view DirectoryOf(const std::string_view &path) noexcept;
+
+    /** @brief Lexically normalize 'path': duplicate separators, '.' and '..' components are removed */
+    [[nodiscard]] static Path Normalize(const std::string_view &path) noexcept;
+
+
+    /** @brief Destructor */
+    ~Path(void) noexcept = default;
+
+    /** @brief Default constructor */
+    Path(void) noexcept = default;
+
+    /** @brief Copy constructor */
+    Path(const Path &other) noexcept = default;
+
+    /** @brief Move constructor */
+    Path(Path &&other) noexcept = default;
+
+    /** @brief Construct a path and locate its components */
+    Path(const std::string_view &path) noexcept;
+
+    /** @brief Copy assignment */
+    Path &operator=(const Path &other) noexcept = default;
+
+    /** @brief Move assignment */
+    Path &operator=(Path &&other) noexcept = default;
+
+
+    /** @brief Comparison operators */
+    [[nodiscard]] inline bool operator==(const Path &other) const noexcept { return view() == other.view(); }
+    [[nodiscard]] inline bool operator==(const std::string_view &other) const noexcept { return view() == other; }
+
+
+    /** @brief Get the whole path */
+    [[nodiscard]] inline std::string_view view(void) const noexcept { return _path.toView(); }
+
+    /** @brief Get the whole path as a null terminated string */
+    [[nodiscard]] inline const char *c_str(void) const noexcept { return _path.c_str(); }
+
+    /** @brief Get the path size */
+    [[nodiscard]] inline Index size(void) const noexcept { return static_cast<Index>(_path.size()); }
+
+    /** @brief Check if the path is empty */
+    [[nodiscard]] inline bool empty(void) const noexcept { return _path.empty(); }
+
+
+    /** @brief Get file name with its extension */
+    [[nodiscard]] inline std::string_view filenameWithExtension(void) const noexcept
+        { return view().substr(_filenameFrom); }
+
+    /** @brief Get file name without its extension */
+    [[nodiscard]] inline std::string_view filename(void) const noexcept
+        { return view().substr(_filenameFrom, _extensionFrom - _filenameFrom); }
+
+    /** @brief Get file extension, including its dot */
+    [[nodiscard]] inline std::string_view extension(void) const noexcept
+        { return view().substr(_extensionFrom); }
+
+    /** @brief Get directory path */
+    [[nodiscard]] inline std::string_view directoryPath(void) const noexcept
+        { return view().substr(0, _filenameFrom > 1 ? _filenameFrom - 1 : _filenameFrom); }
+
+
+    /** @brief Check if the path targets a resource (':/Environment/path') */
+    [[nodiscard]] inline bool isResource(void) const noexcept { return _environmentTo; }
+
+    /** @brief Get environment name of a resource path */
+    [[nodiscard]] inline std::string_view environment(void) const noexcept
+        { return isResource() ? view().substr(EnvironmentBeginIndex, _environmentTo - EnvironmentBeginIndex) : std::string_view(); }
+
+    /** @brief Get the path of a resource inside its environment */
+    [[nodiscard]] inline std::string_view resourcePath(void) const noexcept
+        { return isResource() ? view().substr(std::min<Index>(_environmentTo + 1, size())) : std::string_view(); }
+
+
+    /** @brief Get a normalized copy of this path */
+    [[nodiscard]] inline Path normalized(void) const noexcept { return Normalize(view()); }
+
+    /** @brief Join a relative path to this one */
+    [[nodiscard]] Path join(const std::string_view &relative) const noexcept;
+
+    /** @brief Join operator */
+    [[nodiscard]] inline Path operator/(const std::string_view &relative) const noexcept { return join(relative); }
+
+private:
+    /** @brief Locate path components */
+    void scan(void) noexcept;
+
+    Core::SmallString<IOAllocator> _path {};
+    Index _filenameFrom {};
+    Index _extensionFrom {};
+    Index _environmentTo {};
+};
@@ -0,0 +1,56 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO ResourceData
+ */
+
+#pragma once
+
+#include "ContentBuffer.hpp"
+
+namespace kF::IO
+{
+    class ResourceData;
+}
+
+/** @brief View of a queried resource
+ *  @note The decompressed content of a compressed resource is shared with the decompression cache and stays valid
+ *      as long as a copy of the data is alive, even once evicted */
+class kF::IO::ResourceData
+{
+public:
+    /** @brief Default constructor */
+    ResourceData(void) noexcept = default;
+
+    /** @brief Construct a view of resource data stored in memory that outlives it (embedded or pack resource) */
+    inline ResourceData(const ResourceView view) noexcept : _view(view) {}
+
+    /** @brief Construct a view of decompressed content, sharing it */
+    inline ResourceData(ContentBuffer &&content) noexcept : _view(content.view()), _content(std::move(content)) {}
+
+
+    /** @brief Check if the data is valid */
+    [[nodiscard]] inline explicit operator bool(void) const noexcept { return _view.from; }
+
+    /** @brief Get the view of the data, valid as long as this instance or a copy is alive */
+    [[nodiscard]] inline const ResourceView &view(void) const noexcept { return _view; }
+
+    /** @brief Get the shared decompressed content, invalid for resources stored uncompressed */
+    [[nodiscard]] inline const ContentBuffer &content(void) const noexcept { return _content; }
+
+    /** @brief Get data pointer */
+    [[nodiscard]] inline const std::uint8_t *data(void) const noexcept { return _view.from; }
+
+    /** @brief Get data size */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _view.size(); }
+
+    /** @brief Check if the data is empty */
+    [[nodiscard]] inline bool empty(void) const noexcept { return _view.empty(); }
+
+    /** @brief Begin / end iterators */
+    [[nodiscard]] inline const std::uint8_t *begin(void) const noexcept { return _view.begin(); }
+    [[nodiscard]] inline const std::uint8_t *end(void) const noexcept { return _view.end(); }
+
+private:
+    ResourceView _view {};
+    ContentBuffer _content {};
+};
@@ -6,73 +6,667 @@
 #include <Kube/Core/TrivialDispatcher.hpp>
 #include <Kube/Core/Abort.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "Compression.hpp"
+#include "Instrumentation.hpp"
+#include "Pack.hpp"
 #include "ResourceManager.hpp"
 
 using namespace kF;
 
-IO::ResourceManager *IO::ResourceManager::_Instance {};
+std::atomic<IO::ResourceManager *> IO::ResourceManager::_Instance {};
+
+namespace
+{
+    /** @brief Serialize registrations, snapshot changes and the global instance lifetime */
+    std::mutex WriterMutex {};
+
+    Core::TrivialDispatcher<
+        void(void), Core::DefaultStaticAllocator, Core::CacheLineEighthSize * 4
+    > RegisterDispatcher {};
+
+    /** @brief Allocate and construct an object using IOAllocator */
+    template<typename Type, typename ...Args>
+    [[nodiscard]] inline Type *New(Args &&...args) noexcept
+        { return new (IO::IOAllocator::Allocate(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...); }
+
+    /** @brief Destroy and deallocate an object allocated with 'New' */
+    template<typename Type>
+    inline void Delete(const Type * const object) noexcept
+    {
+        object->~Type();
+        IO::IOAllocator::Deallocate(const_cast<Type *>(object), sizeof(Type), alignof(Type));
+    }
+}
+
+class IO::ResourceManager::ReadGuard
+{
+public:
+    /** @brief Enter a query: count it into the stripe of the thread, then load the current snapshot */
+    ReadGuard(const ResourceManager &manager) noexcept
+    {
+        static std::atomic<std::uint32_t> NextStripe {};
+        thread_local const auto stripe = NextStripe.fetch_add(1u, std::memory_order_relaxed) % ReaderStripeCount;
+        _parity = manager._epoch.load(std::memory_order_seq_cst) & 1u;
+        _count = &manager._readers[stripe].counts[_parity];
+        _count->fetch_add(1u, std::memory_order_seq_cst);
+        _snapshot = manager._snapshot.load(std::memory_order_seq_cst);
+    }
+
+    /** @brief Leave the query */
+    ~ReadGuard(void) noexcept { _count->fetch_sub(1u, std::memory_order_release); }
+
+    /** @brief Get the pinned snapshot */
+    [[nodiscard]] inline const Snapshot &snapshot(void) const noexcept { return *_snapshot; }
+
+private:
+    std::atomic<std::uint32_t> *_count {};
+    const Snapshot *_snapshot {};
+    std::uint32_t _parity {};
+};
+
+class IO::ResourceManager::DecompressionCache
+{
+public:
+    /** @brief Find the decompressed content of a compressed container and mark it as the most recently used
+     *  @return Null on miss */
+    [[nodiscard]] const ContentBuffer *find(const std::uint8_t * const container) noexcept
+    {
+        if (_buckets.empty())
+            return nullptr;
+        auto index = _buckets[Hash(container) & (_buckets.size() - 1u)];
+        while (index != NullEntry && _entries[index].container != container) [[unlikely]]
+            index = _entries[index].nextInBucket;
+        if (index == NullEntry)
+            return nullptr;
+        if (index != _mostRecent) {
+            unlinkUse(index);
+            linkUse(index);
+        }
+        return &_entries[index].content;
+    }
+
+    /** @brief Cache the decompressed content of a compressed container as the most recently used */
+    void insert(const std::uint8_t * const container, const Core::HashedName environmentName, const ContentBuffer &content) noexcept
+    {
+        std::uint32_t index;
+        if (!_freeEntries.empty()) {
+            index = _freeEntries.back();
+            _freeEntries.pop();
+        } else {
+            index = _entries.size();
+            _entries.push(Entry {});
+            if (_entries.size() > _buckets.size())
+                rehash();
+        }
+        auto &bucket = _buckets[Hash(container) & (_buckets.size() - 1u)];
+        auto &entry = _entries[index];
+        entry.container = container;
+        entry.environment = environmentName;
+        entry.content = content;
+        entry.nextInBucket = bucket;
+        entry.used = true;
+        bucket = index;
+        linkUse(index);
+        _size += content.size();
+    }
+
+    /** @brief Evict least recently used contents until 'size' more bytes fit into 'budget' */
+    void evict(const std::size_t size, const std::size_t budget) noexcept
+    {
+        while (_size + size > budget && _leastRecent != NullEntry)
+            erase(_leastRecent);
+    }
+
+    /** @brief Drop every content of an environment */
+    void release(const Core::HashedName environmentName) noexcept
+    {
+        for (auto index = 0u; index != _entries.size(); ++index) {
+            if (_entries[index].used && _entries[index].environment == environmentName)
+                erase(index);
+        }
+    }
+
+    /** @brief Drop every content */
+    void clear(void) noexcept
+    {
+        _buckets.clear();
+        _entries.clear();
+        _freeEntries.clear();
+        _leastRecent = NullEntry;
+        _mostRecent = NullEntry;
+        _size = 0u;
+    }
+
+    /** @brief Get the number of cached bytes */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _size; }
+
+private:
+    /** @brief Index of no entry */
+    static constexpr std::uint32_t NullEntry = ~std::uint32_t {};
+
+    /** @brief Decompressed content, entries are linked from the least to the most recently used */
+    struct Entry
+    {
+        const std::uint8_t *container {};
+        ContentBuffer content {};
+        Core::HashedName environment {};
+        std::uint32_t nextInBucket { NullEntry };
+        std::uint32_t previousUse { NullEntry };
+        std::uint32_t nextUse { NullEntry };
+        bool used {};
+    };
+
+    /** @brief Hash the address of a compressed container */
+    [[nodiscard]] static inline std::uint32_t Hash(const std::uint8_t * const container) noexcept
+        { return static_cast<std::uint32_t>((static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(container)) * 0x9E3779B97F4A7C15ull) >> 32); }
+
+    /** @brief Rebuild buckets after entries grew */
+    void rehash(void) noexcept
+    {
+        auto count = std::max(_buckets.size(), 16u);
+        while (count < _entries.size())
+            count *= 2u;
+        _buckets.clear();
+        _buckets.resize(count, NullEntry);
+        for (auto index = 0u; index != _entries.size(); ++index) {
+            auto &entry = _entries[index];
+            if (!entry.used)
+                continue;
+            auto &bucket = _buckets[Hash(entry.container) & (count - 1u)];
+            entry.nextInBucket = bucket;
+            bucket = index;
+        }
+    }
+
+    /** @brief Link an entry as the most recently used */
+    void linkUse(const std::uint32_t index) noexcept
+    {
+        auto &entry = _entries[index];
+        entry.previousUse = _mostRecent;
+        entry.nextUse = NullEntry;
+        if (_mostRecent != NullEntry)
+            _entries[_mostRecent].nextUse = index;
+        else
+            _leastRecent = index;
+        _mostRecent = index;
+    }
 
-static Core::TrivialDispatcher<
-    void(void), Core::DefaultStaticAllocator, Core::CacheLineEighthSize * 4
-> RegisterDispatcher {};
+    /** @brief Unlink an entry from the use list */
+    void unlinkUse(const std::uint32_t index) noexcept
+    {
+        auto &entry = _entries[index];
+        if (entry.previousUse != NullEntry)
+            _entries[entry.previousUse].nextUse = entry.nextUse;
+        else
+            _leastRecent = entry.nextUse;
+        if (entry.nextUse != NullEntry)
+            _entries[entry.nextUse].previousUse = entry.previousUse;
+        else
+            _mostRecent = entry.previousUse;
+        entry.previousUse = NullEntry;
+        entry.nextUse = NullEntry;
+    }
+
+    /** @brief Drop a cached content */
+    void erase(const std::uint32_t index) noexcept
+    {
+        auto &entry = _entries[index];
+        unlinkUse(index);
+        auto *link = &_buckets[Hash(entry.container) & (_buckets.size() - 1u)];
+        while (*link != index)
+            link = &_entries[*link].nextInBucket;
+        *link = entry.nextInBucket;
+        _size -= entry.content.size();
+        entry.content.release();
+        entry.container = nullptr;
+        entry.nextInBucket = NullEntry;
+        entry.used = false;
+        _freeEntries.push(index);
+    }
+
+    Core::Vector<std::uint32_t, IOAllocator> _buckets {}; // Heads of entry chains, indexed by container hash
+    Core::Vector<Entry, IOAllocator> _entries {};
+    Core::Vector<std::uint32_t, IOAllocator> _freeEntries {};
+    std::uint32_t _leastRecent { NullEntry };
+    std::uint32_t _mostRecent { NullEntry };
+    std::size_t _size {};
+};
 
 void IO::ResourceManager::RegisterEnvironmentLater(
-        const Core::HashedName environmentName, const Environment environment) noexcept
+        const Core::HashedName environmentName, const Environment environment, const bool compressed) noexcept
 {
-    RegisterDispatcher.add([environmentName, environment]{
-        ResourceManager::Get().registerEnvironment(environmentName, environment);
+    std::lock_guard<std::mutex> guard(WriterMutex);
+    RegisterDispatcher.add([environmentName, environment, compressed]{
+        ResourceManager::Get().registerEnvironmentLocked(environmentName, environment, compressed);
     });
+    if (const auto instance = _Instance.load(std::memory_order_relaxed); instance)
+        instance->registerEnvironmentLocked(environmentName, environment, compressed);
 }
 
 IO::ResourceManager::~ResourceManager(void) noexcept
 {
-    kFEnsure(_Instance != nullptr,
+    std::lock_guard<std::mutex> guard(WriterMutex);
+    kFEnsure(_Instance.load(std::memory_order_relaxed) != nullptr,
         "IO::ResourceManager: ResourceManager is already destroyed");
-    _Instance = nullptr;
+    Delete(_cache);
+    const auto snapshot = _snapshot.load(std::memory_order_relaxed);
+    for (const auto &pack : snapshot->packs) {
+        Native::Unmap(pack.mapping);
+        Native::Close(pack.handle);
+    }
+    Delete(snapshot->index);
+    Delete(snapshot);
+    for (auto stripe = 0u; stripe != ReaderStripeCount; ++stripe)
+        _readers[stripe].~ReaderStripe();
+    IOAllocator::Deallocate(_readers, sizeof(ReaderStripe) * ReaderStripeCount, alignof(ReaderStripe));
+    _Instance.store(nullptr, std::memory_order_release);
 }
 
 IO::ResourceManager::ResourceManager(void) noexcept
+    : _snapshot(New<Snapshot>(Snapshot { .index = New<Index>() }))
+    , _readers(reinterpret_cast<ReaderStripe *>(IOAllocator::Allocate(sizeof(ReaderStripe) * ReaderStripeCount, alignof(ReaderStripe))))
+    , _cache(New<DecompressionCache>())
 {
-    kFEnsure(_Instance == nullptr,
+    for (auto stripe = 0u; stripe != ReaderStripeCount; ++stripe)
+        new (_readers + stripe) ReaderStripe {};
+    std::lock_guard<std::mutex> guard(WriterMutex);
+    kFEnsure(_Instance.load(std::memory_order_relaxed) == nullptr,
         "IO::ResourceManager: ResourceManager is already initialized");
-    _Instance = this;
+    _Instance.store(this, std::memory_order_release);
     RegisterDispatcher.dispatch();
 }
 
-void IO::ResourceManager::registerEnvironment(const Core::HashedName environmentName, const Environment environment) noexcept
+void IO::ResourceManager::registerEnvironment(const Core::HashedName environmentName, const Environment environment, const bool compressed) noexcept
+{
+    std::lock_guard<std::mutex> guard(WriterMutex);
+    registerEnvironmentLocked(environmentName, environment, compressed);
+}
+
+void IO::ResourceManager::registerEnvironmentLocked(const Core::HashedName environmentName, const Environment environment, const bool compressed) noexcept
 {
-    kFEnsure(!environmentExists(environmentName),
+    const auto &current = currentSnapshot();
+    kFEnsure(!EnvironmentExists(current, environmentName),
         "IO::ResourceManager: Environment already registered");
-    _environmentNames.push(environmentName);
-    _environments.push(environment);
+    const auto index = New<Index>(*current.index);
+    index->environmentNames.push(environmentName);
+    index->environments.push(environment);
+    IndexDirectory(*index, environmentName, environment, std::string_view(), compressed);
+    publish(New<Snapshot>(Snapshot { .index = index, .packs = current.packs }));
+}
+
+bool IO::ResourceManager::unregisterEnvironment(const Core::HashedName environmentName) noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard(WriterMutex);
+        const auto &current = currentSnapshot();
+        const auto it = current.index->environmentNames.find(environmentName);
+        if (it == current.index->environmentNames.end())
+            return false;
+        const auto position = Core::Distance<std::uint32_t>(current.index->environmentNames.begin(), it);
+        const auto index = New<Index>();
+        for (auto i = 0u; i != current.index->environmentNames.size(); ++i) {
+            if (i == position)
+                continue;
+            index->environmentNames.push(current.index->environmentNames.at(i));
+            index->environments.push(current.index->environments.at(i));
+        }
+        for (const auto &entry : current.index->entries) {
+            if (entry.handle.environment && entry.handle.environment != environmentName)
+                InsertEntry(*index, entry.handle, GetName(*current.index, entry), entry.view, entry.compressed);
+        }
+        publish(New<Snapshot>(Snapshot { .index = index, .packs = current.packs }));
+    }
+    releaseCache(environmentName);
+    return true;
+}
+
+void IO::ResourceManager::IndexDirectory(Index &index, const Core::HashedName environmentName, const Environment &environment,
+        const std::string_view &directory, const bool compressed) noexcept
+{
+    for (const auto &entry : environment.iterate_directory(std::string(directory))) {
+        std::string path(directory);
+        if (!path.empty())
+            path.push_back('/');
+        path.append(entry.filename());
+        if (entry.is_directory()) {
+            IndexDirectory(index, environmentName, environment, path, compressed);
+        } else {
+            const auto file = environment.open(path);
+            const ResourceView view {
+                .from = reinterpret_cast<const std::uint8_t *>(file.begin()),
+                .to = reinterpret_cast<const std::uint8_t *>(file.end())
+            };
+            Compression::Header header;
+            InsertEntry(
+                index,
+                ResourceHandle { .environment = environmentName, .path = Core::Hash(path) },
+                path,
+                view,
+                compressed && Compression::ParseHeader(view, header)
+            );
+        }
+    }
+}
+
+void IO::ResourceManager::InsertEntry(Index &index, const ResourceHandle handle, const std::string_view &name,
+        const ResourceView &view, const bool compressed) noexcept
+{
+    kFEnsure(name.size() <= std::numeric_limits<std::uint16_t>::max(),
+        "IO::ResourceManager::insertEntry: Resource path is too long");
+    const auto nameOffset = index.names.size();
+    kFEnsure(nameOffset + name.size() <= std::numeric_limits<std::uint32_t>::max(),
+        "IO::ResourceManager::insertEntry: Too many resources");
+    index.names.insert(index.names.end(), name.begin(), name.end());
+    PlaceEntry(index, IndexEntry {
+        .handle = handle,
+        .view = view,
+        .nameOffset = static_cast<std::uint32_t>(nameOffset),
+        .nameSize = static_cast<std::uint16_t>(name.size()),
+        .compressed = compressed
+    });
+}
+
+void IO::ResourceManager::PlaceEntry(Index &index, IndexEntry entry) noexcept
+{
+    // Keep the load factor under 50% so probe sequences stay short
+    if ((index.count + 1) * 2 > index.entries.size()) {
+        auto previous = std::move(index.entries);
+        index.entries.clear();
+        index.entries.resize(std::max(MinIndexCapacity, previous.size() * 2));
+        index.count = 0;
+        for (const auto &placed : previous) {
+            if (placed.handle.environment)
+                PlaceEntry(index, placed);
+        }
+    }
+
+    const auto mask = index.entries.size() - 1;
+    for (auto i = ProbeIndex(entry.handle, mask); ; i = (i + 1) & mask) {
+        auto &placed = index.entries[i];
+        if (!placed.handle.environment) {
+            placed = entry;
+            ++index.count;
+            return;
+        }
+        // Both resources stay reachable by path, their handle alone can't tell them apart
+        if (placed.handle == entry.handle) [[unlikely]]
+            placed.ambiguous = entry.ambiguous = true;
+    }
+}
+
+IO::ResourceManager::IndexEntry IO::ResourceManager::FindEntry(const Snapshot &snapshot, const ResourceHandle handle, const std::string_view * const path) noexcept
+{
+    const auto &index = *snapshot.index;
+    const auto &entries = index.entries;
+    if (!entries.empty()) [[likely]] {
+        const auto mask = entries.size() - 1;
+        for (auto i = ProbeIndex(handle, mask); ; i = (i + 1) & mask) {
+            const auto &entry = entries[i];
+            if (entry.handle == handle) [[likely]] {
+                if (path ? GetName(index, entry) == *path : !entry.ambiguous) [[likely]]
+                    return entry;
+            } else if (!entry.handle.environment)
+                break;
+        }
+    }
+    if (const auto pack = FindPack(snapshot, handle.environment); pack) {
+        if (const auto entry = Pack::Find(pack->mapping, handle.path, path); entry && !Core::HasFlags(entry->flags, Pack::EntryFlags::Directory)) {
+            return IndexEntry {
+                .handle = handle,
+                .view = Pack::GetData(pack->mapping, *entry),
+                .compressed = Core::HasFlags(entry->flags, Pack::EntryFlags::Compressed)
+            };
+        }
+    }
+    return IndexEntry {};
+}
+
+IO::ResourceManager::IndexEntry IO::ResourceManager::findEntry(const ResourceHandle handle, const std::string_view * const path) const noexcept
+{
+    ReadGuard guard(*this);
+    return FindEntry(guard.snapshot(), handle, path);
+}
+
+const IO::ResourceManager::MountedPack *IO::ResourceManager::FindPack(const Snapshot &snapshot, const Core::HashedName environmentName) noexcept
+{
+    const auto it = snapshot.packs.find([environmentName](const MountedPack &pack) { return pack.environment == environmentName; });
+    return it != snapshot.packs.end() ? it : nullptr;
+}
+
+bool IO::ResourceManager::EnvironmentExists(const Snapshot &snapshot, const Core::HashedName environmentName) noexcept
+{
+    return snapshot.index->environmentNames.find(environmentName) != snapshot.index->environmentNames.end()
+        || FindPack(snapshot, environmentName);
+}
+
+void IO::ResourceManager::publish(Snapshot * const snapshot) noexcept
+{
+    const auto previous = _snapshot.exchange(snapshot, std::memory_order_seq_cst);
+    synchronize();
+    if (previous->index != snapshot->index)
+        Delete(previous->index);
+    Delete(previous);
+}
+
+void IO::ResourceManager::synchronize(void) noexcept
+{
+    // Flip the epoch parity twice: a query may have read the parity before the first flip and pinned the new snapshot
+    // after it, it is only guaranteed to be waited for by the second flip
+    for (auto flip = 0u; flip != 2u; ++flip) {
+        const auto parity = _epoch.fetch_add(1u, std::memory_order_seq_cst) & 1u;
+        for (auto stripe = 0u; stripe != ReaderStripeCount; ++stripe) {
+            while (_readers[stripe].counts[parity].load(std::memory_order_seq_cst))
+                std::this_thread::yield();
+        }
+    }
 }
 
 bool IO::ResourceManager::environmentExists(const Core::HashedName environmentName) const noexcept
 {
-    return _environmentNames.find(environmentName) != _environmentNames.end();
+    ReadGuard guard(*this);
+    return EnvironmentExists(guard.snapshot(), environmentName);
 }
 
 IO::Environment IO::ResourceManager::getEnvironment(const Core::HashedName environmentName) const noexcept
 {
-    const auto it = _environmentNames.find(environmentName);
-    kFEnsure(it != _environmentNames.end(),
+    ReadGuard guard(*this);
+    const auto &index = *guard.snapshot().index;
+    const auto it = index.environmentNames.find(environmentName);
+    kFEnsure(it != index.environmentNames.end(),
         "IO::ResourceManager::getEnvironment: Environment is not registered");
-    const auto index = Core::Distance<std::uint32_t>(_environmentNames.begin(), it);
-    return _environments.at(index);
+    return index.environments.at(Core::Distance<std::uint32_t>(index.environmentNames.begin(), it));
+}
+
+bool IO::ResourceManager::mountPack(const Core::HashedName environmentName, const std::string_view &path) noexcept
+{
+    const auto handle = Native::Open(path, true, false);
+    if (handle == Native::InvalidHandle) [[unlikely]]
+        return false;
+    const auto mapping = Native::Map(handle, Native::Size(handle));
+    if (!Pack::Validate(mapping)) [[unlikely]] {
+        Native::Unmap(mapping);
+        Native::Close(handle);
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(WriterMutex);
+    const auto &current = currentSnapshot();
+    kFEnsure(!EnvironmentExists(current, environmentName),
+        "IO::ResourceManager::mountPack: Environment already registered");
+    const auto snapshot = New<Snapshot>(Snapshot { .index = current.index, .packs = current.packs });
+    snapshot->packs.push(MountedPack { .environment = environmentName, .handle = handle, .mapping = mapping });
+    publish(snapshot);
+    return true;
+}
+
+bool IO::ResourceManager::unmountPack(const Core::HashedName environmentName) noexcept
+{
+    MountedPack pack;
+    {
+        std::lock_guard<std::mutex> guard(WriterMutex);
+        const auto &current = currentSnapshot();
+        const auto mounted = FindPack(current, environmentName);
+        if (!mounted)
+            return false;
+        pack = *mounted;
+        const auto snapshot = New<Snapshot>(Snapshot { .index = current.index, .packs = current.packs });
+        snapshot->packs.erase(snapshot->packs.begin() + (mounted - current.packs.begin()));
+        publish(snapshot);
+    }
+    // Decompressed copies of the pack resources would outlive it
+    releaseCache(environmentName);
+    Native::Unmap(pack.mapping);
+    Native::Close(pack.handle);
+    return true;
+}
+
+bool IO::ResourceManager::isPack(const Core::HashedName environmentName) const noexcept
+{
+    ReadGuard guard(*this);
+    return FindPack(guard.snapshot(), environmentName);
+}
+
+IO::ResourceView IO::ResourceManager::getPack(const Core::HashedName environmentName) const noexcept
+{
+    ReadGuard guard(*this);
+    const auto pack = FindPack(guard.snapshot(), environmentName);
+    return pack ? pack->mapping : ResourceView {};
 }
 
 bool IO::ResourceManager::resourceExists(const Core::HashedName environmentName, const std::string_view &path) const noexcept
 {
-    return getEnvironment(environmentName).exists(path);
+    ReadGuard guard(*this);
+    const auto &snapshot = guard.snapshot();
+    // Only files are indexed, directories are resolved by their environment
+    if (FindEntry(snapshot, ResourceHandle { .environment = environmentName, .path = Core::Hash(path) }, &path))
+        return true;
+    // Directories of packs have their own entries
+    else if (const auto pack = FindPack(snapshot, environmentName); pack)
+        return path.empty() || Pack::Find(pack->mapping, Core::Hash(path), &path);
+    const auto &index = *snapshot.index;
+    const auto it = index.environmentNames.find(environmentName);
+    kFEnsure(it != index.environmentNames.end(),
+        "IO::ResourceManager::resourceExists: Environment is not registered");
+    return index.environments.at(Core::Distance<std::uint32_t>(index.environmentNames.begin(), it)).exists(std::string(path));
+}
+
+IO::ResourceData IO::ResourceManager::queryEntry(const ResourceHandle handle, const std::string_view * const path) const noexcept
+{
+    Instrumentation::Scope scope(Instrumentation::Operation::ResourceQuery);
+    // Hold the query until the data is copied out, an unmounted pack is only unmapped once no query observes it
+    ReadGuard guard(*this);
+    const auto entry = FindEntry(guard.snapshot(), handle, path);
+    if (entry) [[likely]] {
+        auto data = entry.compressed ? ResourceData(decompress(entry)) : ResourceData(entry.view);
+        scope.setBytes(data.size());
+        return data;
+    }
+    kFEnsure(EnvironmentExists(guard.snapshot(), handle.environment),
+        "IO::ResourceManager::queryResource: Environment is not registered");
+    return ResourceData {};
+}
+
+std::size_t IO::ResourceManager::entrySize(const ResourceHandle handle, const std::string_view * const path) const noexcept
+{
+    ReadGuard guard(*this);
+    const auto entry = FindEntry(guard.snapshot(), handle, path);
+    if (!entry) [[unlikely]] {
+        kFEnsure(EnvironmentExists(guard.snapshot(), handle.environment),
+            "IO::ResourceManager::resourceSize: Environment is not registered");
+        return 0u;
+    } else if (entry.compressed) {
+        Compression::Header header;
+        return Compression::ParseHeader(entry.view, header) ? static_cast<std::size_t>(header.size) : 0u;
+    } else
+        return entry.view.size();
 }
 
-IO::ResourceView IO::ResourceManager::queryResource(
-    const Core::HashedName environmentName, const std::string_view &path) const noexcept
+std::size_t IO::ResourceManager::readEntry(const ResourceHandle handle, const std::string_view * const path,
+        std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept
 {
-    const auto file = getEnvironment(environmentName).open(path);
+    ReadGuard guard(*this);
+    const auto entry = FindEntry(guard.snapshot(), handle, path);
+    if (!entry) [[unlikely]] {
+        kFEnsure(EnvironmentExists(guard.snapshot(), handle.environment),
+            "IO::ResourceManager::readResource: Environment is not registered");
+        return 0u;
+    }
 
-    return ResourceView {
-        .from = reinterpret_cast<const std::uint8_t *>(file.begin()),
-        .to = reinterpret_cast<const std::uint8_t *>(file.end())
+    const auto copyRange = [from, to, offset](const ResourceView &range) {
+        if (offset >= range.size()) [[unlikely]]
+            return std::size_t {};
+        const auto count = std::min(range.size() - offset, static_cast<std::size_t>(std::distance(from, to)));
+        std::copy(range.begin() + offset, range.begin() + offset + count, from);
+        return count;
     };
-}
\ No newline at end of file
+
+    if (!entry.compressed)
+        return copyRange(entry.view);
+
+    // Use the whole decompressed resource when it is already cached
+    {
+        std::lock_guard<std::mutex> guard(_cacheMutex);
+        if (const auto content = _cache->find(entry.view.begin()); content)
+            return copyRange(content->view());
+    }
+    thread_local Core::Vector<std::uint8_t, IOAllocator> Scratch;
+    Compression::Header header;
+    if (!Compression::ParseHeader(entry.view, header)) [[unlikely]]
+        return 0u;
+    if (Scratch.size() < header.blockSize)
+        Scratch.resize(header.blockSize);
+    return Compression::Read(entry.view, from, to, offset, Scratch.data());
+}
+
+void IO::ResourceManager::setDecompressionCacheBudget(const std::size_t budget) noexcept
+{
+    std::lock_guard<std::mutex> guard(_cacheMutex);
+    _cacheBudget.store(budget, std::memory_order_relaxed);
+    _cache->evict(0u, budget);
+    _cacheSize.store(_cache->size(), std::memory_order_relaxed);
+}
+
+void IO::ResourceManager::clearDecompressionCache(void) noexcept
+{
+    std::lock_guard<std::mutex> guard(_cacheMutex);
+    _cache->clear();
+    _cacheSize.store(0u, std::memory_order_relaxed);
+}
+
+void IO::ResourceManager::releaseCache(const Core::HashedName environmentName) noexcept
+{
+    std::lock_guard<std::mutex> guard(_cacheMutex);
+    _cache->release(environmentName);
+    _cacheSize.store(_cache->size(), std::memory_order_relaxed);
+}
+
+IO::ContentBuffer IO::ResourceManager::decompress(const IndexEntry &entry) const noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard(_cacheMutex);
+        if (const auto content = _cache->find(entry.view.begin()); content)
+            return *content;
+    }
+
+    // Decompress outside of the lock, concurrent queries of the same resource keep the first cached content
+    Compression::Header header;
+    if (!Compression::ParseHeader(entry.view, header)) [[unlikely]]
+        return ContentBuffer {};
+    const auto size = static_cast<std::size_t>(header.size);
+    auto content = ContentBuffer::Allocate(size);
+    if (Compression::Read(entry.view, content.mutableData(), content.mutableData() + size, 0u, nullptr) != size) [[unlikely]]
+        return ContentBuffer {};
+
+    std::lock_guard<std::mutex> guard(_cacheMutex);
+    if (const auto cached = _cache->find(entry.view.begin()); cached)
+        return *cached;
+    _cache->evict(size, _cacheBudget.load(std::memory_order_relaxed));
+    _cache->insert(entry.view.begin(), entry.handle.environment, content);
+    _cacheSize.store(_cache->size(), std::memory_order_relaxed);
+    return content;
+}
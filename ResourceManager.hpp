@@ -5,14 +5,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <cmrc/cmrc.hpp>
 
 #include <Kube/Core/Vector.hpp>
 #include <Kube/Core/Hash.hpp>
 
 #include "Base.hpp"
+#include "Native.hpp"
+#include "ResourceData.hpp"
 
-#define KF_DECLARE_RESOURCE_ENVIRONMENT(EnvironmentName) \
+#define KF_DECLARE_RESOURCE_ENVIRONMENT_IMPL(EnvironmentName, Compressed) \
 CMRC_DECLARE(EnvironmentName); \
 namespace kF::IO::Modules \
 { \
@@ -20,12 +25,18 @@ namespace kF::IO::Modules \
     { \
         static inline const Environment Instance = [] { \
             const auto env = cmrc::EnvironmentName::get_filesystem(); \
-            ResourceManager::RegisterEnvironmentLater(Core::Hash(#EnvironmentName), env); \
+            ResourceManager::RegisterEnvironmentLater(Core::Hash(#EnvironmentName), env, Compressed); \
             return env; \
         }(); \
     }; \
 } static_assert(true)
 
+#define KF_DECLARE_RESOURCE_ENVIRONMENT(EnvironmentName) KF_DECLARE_RESOURCE_ENVIRONMENT_IMPL(EnvironmentName, false)
+
+/** @brief Declare an environment whose resources are compressed containers (see IO::Compression)
+ *  @note Resources that are not valid containers are served raw */
+#define KF_DECLARE_COMPRESSED_RESOURCE_ENVIRONMENT(EnvironmentName) KF_DECLARE_RESOURCE_ENVIRONMENT_IMPL(EnvironmentName, true)
+
 namespace kF::IO
 {
     class ResourceManager;
@@ -34,16 +45,31 @@ namespace kF::IO
     using Environment = cmrc::embedded_filesystem;
 }
 
-/** @brief Manage all resource environments */
-class alignas_half_cacheline kF::IO::ResourceManager
+/** @brief Manage all resource environments
+ *  @note Every embedded resource is indexed at registration into a flat open-addressing table, a query costs a single probe
+ *  @note Packs (see IO::Pack) are mounted at runtime by mapping them, their own index is probed in place
+ *  @note The index, the environments and the mounted packs form an immutable snapshot which is replaced on every change.
+ *      Queries only pin the current snapshot and never lock, changes are serialized and wait for in-flight queries
+ *      before releasing the snapshot they replaced
+ *  @note Compressed resources are decompressed on first query into a bounded LRU cache, guarded by its own lock.
+ *      Queries share the decompressed content with the cache, evicting it never invalidates queried data */
+class alignas_double_cacheline kF::IO::ResourceManager
 {
 public:
-    /** @brief Add environment to  */
+    /** @brief Default budget of the decompression cache in bytes */
+    static constexpr std::size_t DefaultDecompressionCacheBudget = 64 * 1024 * 1024;
+
+
+    /** @brief Register an environment into the global instance, or as soon as it is constructed
+     *  @note Thread safe, environments are also registered into every global instance constructed later */
     static void RegisterEnvironmentLater(
-            const Core::HashedName environmentName, const Environment environment) noexcept;
+            const Core::HashedName environmentName, const Environment environment, const bool compressed = false) noexcept;
+
+    /** @brief Check if the manager global instance is initialized */
+    [[nodiscard]] static inline bool IsInitialized(void) noexcept { return _Instance.load(std::memory_order_acquire); }
 
     /** @brief Get manager global instance */
-    [[nodiscard]] static inline ResourceManager &Get(void) noexcept { return *_Instance; }
+    [[nodiscard]] static inline ResourceManager &Get(void) noexcept { return *_Instance.load(std::memory_order_acquire); }
 
 
     /** @brief Destructor */
@@ -56,26 +82,239 @@ public:
     /** @brief Check if an environment exists */
     [[nodiscard]] bool environmentExists(const Core::HashedName environmentName) const noexcept;
 
-    /** @brief Get a resource environment */
+    /** @brief Get an embedded resource environment */
     [[nodiscard]] Environment getEnvironment(const Core::HashedName environment) const noexcept;
 
+    /** @brief Register an embedded environment, indexing all its resources
+     *  @note Safe while other threads are querying resources */
+    void registerEnvironment(const Core::HashedName environmentName, const Environment environment, const bool compressed = false) noexcept;
+
+    /** @brief Unregister an embedded environment
+     *  @note Returns once no query can still observe the environment, its decompressed resources are released
+     *  @return False if no embedded environment is registered as 'environmentName' */
+    bool unregisterEnvironment(const Core::HashedName environmentName) noexcept;
+
+
+    /** @brief Mount the pack file at 'path' as the environment 'environmentName'
+     *  @note Mounting only maps the pack and validates its header, its index is never walked
+     *  @return False if the pack couldn't be opened, mapped or is invalid */
+    [[nodiscard]] bool mountPack(const Core::HashedName environmentName, const std::string_view &path) noexcept;
+
+    /** @brief Unmount a pack environment
+     *  @note The pack is unmapped once no query can still observe it
+     *  @note Every view of its resources is invalidated, files must drop their cached view (see 'File::invalidateResource')
+     *  @return False if no pack is mounted as 'environmentName' */
+    bool unmountPack(const Core::HashedName environmentName) noexcept;
+
+    /** @brief Check if an environment is a mounted pack */
+    [[nodiscard]] bool isPack(const Core::HashedName environmentName) const noexcept;
+
+    /** @brief Get the mapping of a mounted pack, empty if 'environmentName' is not a pack */
+    [[nodiscard]] ResourceView getPack(const Core::HashedName environmentName) const noexcept;
+
 
     /** @brief Check if a resource exists at 'path' inside 'environment' */
     [[nodiscard]] bool resourceExists(const Core::HashedName environmentName, const std::string_view &path) const noexcept;
 
+    /** @brief Check if a resource exists
+     *  @note Handles only identify resources by hash, a handle shared by several resources of an environment is rejected */
+    [[nodiscard]] inline bool resourceExists(const ResourceHandle handle) const noexcept { return static_cast<bool>(findEntry(handle, nullptr)); }
+
+    /** @brief Check if a resource exists using a precomputed handle of 'path' */
+    [[nodiscard]] inline bool resourceExists(const ResourceHandle handle, const std::string_view &path) const noexcept
+        { return static_cast<bool>(findEntry(handle, &path)); }
+
 
     /** @brief Query a resource */
-    [[nodiscard]] ResourceView queryResource(const Core::HashedName environmentName, const std::string_view &path) const noexcept;
+    [[nodiscard]] inline ResourceData queryResource(const Core::HashedName environmentName, const std::string_view &path) const noexcept
+        { return queryResource(ResourceHandle { .environment = environmentName, .path = Core::Hash(path) }, path); }
+
+    /** @brief Query a resource using a precomputed handle
+     *  @note Compressed resources are decompressed into the decompression cache and shared with it
+     *  @note A handle shared by several resources of an environment is rejected, query them by path */
+    [[nodiscard]] inline ResourceData queryResource(const ResourceHandle handle) const noexcept
+        { return queryEntry(handle, nullptr); }
+
+    /** @brief Query a resource using a precomputed handle of 'path' */
+    [[nodiscard]] inline ResourceData queryResource(const ResourceHandle handle, const std::string_view &path) const noexcept
+        { return queryEntry(handle, &path); }
+
+    /** @brief Check if a resource is stored compressed */
+    [[nodiscard]] inline bool isCompressed(const ResourceHandle handle) const noexcept
+        { return findEntry(handle, nullptr).compressed; }
+
+    /** @brief Check if a resource is stored compressed using a precomputed handle of 'path' */
+    [[nodiscard]] inline bool isCompressed(const ResourceHandle handle, const std::string_view &path) const noexcept
+        { return findEntry(handle, &path).compressed; }
+
+    /** @brief Get the (uncompressed) size of a resource */
+    [[nodiscard]] inline std::size_t resourceSize(const ResourceHandle handle) const noexcept
+        { return entrySize(handle, nullptr); }
+
+    /** @brief Get the (uncompressed) size of a resource using a precomputed handle of 'path' */
+    [[nodiscard]] inline std::size_t resourceSize(const ResourceHandle handle, const std::string_view &path) const noexcept
+        { return entrySize(handle, &path); }
+
+    /** @brief Read a byte range of a resource into range
+     *  @note Only compressed blocks covering the requested range are decompressed
+     *  @return The number of bytes read */
+    [[nodiscard]] inline std::size_t readResource(const ResourceHandle handle,
+            std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept
+        { return readEntry(handle, nullptr, from, to, offset); }
+
+    /** @brief Read a byte range of a resource into range using a precomputed handle of 'path' */
+    [[nodiscard]] inline std::size_t readResource(const ResourceHandle handle, const std::string_view &path,
+            std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept
+        { return readEntry(handle, &path, from, to, offset); }
+
+
+    /** @brief Get the decompression cache budget in bytes */
+    [[nodiscard]] inline std::size_t decompressionCacheBudget(void) const noexcept { return _cacheBudget.load(std::memory_order_relaxed); }
+
+    /** @brief Set the decompression cache budget in bytes, evicting entries if required
+     *  @note Evicted contents stay alive until their last query is released */
+    void setDecompressionCacheBudget(const std::size_t budget) noexcept;
+
+    /** @brief Get the number of bytes used by the decompression cache */
+    [[nodiscard]] inline std::size_t decompressionCacheSize(void) const noexcept { return _cacheSize.load(std::memory_order_relaxed); }
+
+    /** @brief Release every decompressed resource held by the cache */
+    void clearDecompressionCache(void) noexcept;
 
 private:
-    /** @brief Register an environment into the manager */
-    void registerEnvironment(const Core::HashedName environmentName, const Environment environment) noexcept;
+    /** @brief Entry of the resource index */
+    struct IndexEntry
+    {
+        ResourceHandle handle {};
+        ResourceView view {};
+        std::uint32_t nameOffset {};
+        std::uint16_t nameSize {};
+        bool compressed {};
+        bool ambiguous {}; // Another resource of the environment shares the path hash
+
+        /** @brief Check if the entry is valid */
+        [[nodiscard]] explicit operator bool(void) const noexcept { return handle.environment; }
+    };
+
+    /** @brief Mounted pack */
+    struct MountedPack
+    {
+        Core::HashedName environment {};
+        Native::Handle handle { Native::InvalidHandle };
+        ResourceView mapping {};
+    };
+
+    /** @brief LRU cache of decompressed resources, keyed by their compressed container as handles may collide */
+    class DecompressionCache;
+
+    /** @brief Index of the embedded environments, immutable once published */
+    struct Index
+    {
+        Core::Vector<Core::HashedName, IOAllocator> environmentNames {};
+        Core::Vector<Environment, IOAllocator> environments {};
+        Core::Vector<IndexEntry, IOAllocator> entries {};
+        Core::Vector<char, IOAllocator, std::size_t> names {};
+        std::uint32_t count {};
+    };
+
+    /** @brief State observed by queries, immutable once published
+     *  @note Mounting a pack shares the index of the previous snapshot */
+    struct Snapshot
+    {
+        const Index *index {};
+        Core::Vector<MountedPack, IOAllocator> packs {};
+    };
+
+    /** @brief Number of in-flight queries of both epoch parities, striped to keep threads off each other's cachelines */
+    struct alignas_cacheline ReaderStripe
+    {
+        std::atomic<std::uint32_t> counts[2] {};
+    };
+
+    /** @brief Pin the current snapshot for the duration of a query */
+    class ReadGuard;
+
+    /** @brief Minimum index capacity */
+    static constexpr std::uint32_t MinIndexCapacity = 64;
+
+    /** @brief Number of reader stripes */
+    static constexpr std::uint32_t ReaderStripeCount = 32;
+
+
+    /** @brief Register an environment, the writer lock must be held */
+    void registerEnvironmentLocked(const Core::HashedName environmentName, const Environment environment, const bool compressed) noexcept;
+
+    /** @brief Recursively index every resource of 'directory' */
+    static void IndexDirectory(Index &index, const Core::HashedName environmentName, const Environment &environment,
+            const std::string_view &directory, const bool compressed) noexcept;
+
+    /** @brief Insert a resource named 'name' into an index */
+    static void InsertEntry(Index &index, const ResourceHandle handle, const std::string_view &name,
+            const ResourceView &view, const bool compressed) noexcept;
+
+    /** @brief Place an entry whose name is already stored into an index
+     *  @note Entries sharing a handle are all marked ambiguous */
+    static void PlaceEntry(Index &index, IndexEntry entry) noexcept;
+
+    /** @brief Get the name of an index entry */
+    [[nodiscard]] static inline std::string_view GetName(const Index &index, const IndexEntry &entry) noexcept
+        { return std::string_view(index.names.data() + entry.nameOffset, entry.nameSize); }
+
+    /** @brief Find a resource inside the index or a mounted pack of a snapshot
+     *  @param path Path of the resource, compared on every hit. If null, ambiguous handles are rejected
+     *  @return An invalid entry if the resource doesn't exist */
+    [[nodiscard]] static IndexEntry FindEntry(const Snapshot &snapshot, const ResourceHandle handle, const std::string_view * const path) noexcept;
+
+    /** @brief Find a mounted pack of a snapshot */
+    [[nodiscard]] static const MountedPack *FindPack(const Snapshot &snapshot, const Core::HashedName environmentName) noexcept;
+
+    /** @brief Check if an environment exists inside a snapshot */
+    [[nodiscard]] static bool EnvironmentExists(const Snapshot &snapshot, const Core::HashedName environmentName) noexcept;
+
+    /** @brief Find a resource inside the current snapshot */
+    [[nodiscard]] IndexEntry findEntry(const ResourceHandle handle, const std::string_view * const path) const noexcept;
+
+    /** @brief Find a resource and get its data, decompressing it if required
+     *  @note Entries only stay valid while their snapshot is pinned, lookups and data accesses share one query */
+    [[nodiscard]] ResourceData queryEntry(const ResourceHandle handle, const std::string_view * const path) const noexcept;
+
+    /** @brief Find a resource and get its (uncompressed) size */
+    [[nodiscard]] std::size_t entrySize(const ResourceHandle handle, const std::string_view * const path) const noexcept;
+
+    /** @brief Find a resource and read a byte range of it */
+    [[nodiscard]] std::size_t readEntry(const ResourceHandle handle, const std::string_view * const path,
+            std::uint8_t * const from, std::uint8_t * const to, const std::size_t offset) const noexcept;
+
+    /** @brief Get the current snapshot, the writer lock must be held */
+    [[nodiscard]] inline const Snapshot &currentSnapshot(void) const noexcept { return *_snapshot.load(std::memory_order_relaxed); }
+
+    /** @brief Publish a new snapshot, then release the previous one once no query can observe it
+     *  @note The writer lock must be held */
+    void publish(Snapshot * const snapshot) noexcept;
+
+    /** @brief Wait until every query started before the call is done */
+    void synchronize(void) noexcept;
+
+    /** @brief Release every decompressed resource of an environment held by the cache */
+    void releaseCache(const Core::HashedName environmentName) noexcept;
+
+    /** @brief Get the decompressed content of a compressed resource, decompressing it if required */
+    [[nodiscard]] ContentBuffer decompress(const IndexEntry &entry) const noexcept;
+
+    /** @brief Get the first probe index of a resource handle */
+    [[nodiscard]] static constexpr std::uint32_t ProbeIndex(const ResourceHandle handle, const std::uint32_t mask) noexcept
+        { return (handle.path ^ (handle.environment * 0x9E3779B1u)) & mask; }
 
 
     /** @brief Global instance */
-    static ResourceManager *_Instance;
+    static std::atomic<ResourceManager *> _Instance;
 
-    Core::Vector<Core::HashedName, IOAllocator> _environmentNames {};
-    Core::Vector<cmrc::embedded_filesystem, IOAllocator> _environments {};
+    std::atomic<const Snapshot *> _snapshot {};
+    std::atomic<std::uint32_t> _epoch {};
+    ReaderStripe *_readers {};
+    DecompressionCache *_cache {};
+    mutable std::atomic<std::size_t> _cacheSize {};
+    std::atomic<std::size_t> _cacheBudget { DefaultDecompressionCacheBudget };
+    mutable std::mutex _cacheMutex {};
 };
-static_assert_fit_half_cacheline(kF::IO::ResourceManager);
\ No newline at end of file
+static_assert_fit_double_cacheline(kF::IO::ResourceManager);
\ No newline at end of file
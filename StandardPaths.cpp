@@ -0,0 +1,172 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO StandardPaths
+ */
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include <Kube/Core/Platform.hpp>
+
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+#include <whereami.h>
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+#pragma GCC diagnostic pop
+#endif
+
+#include <platform_folders.h>
+
+#include <Kube/Core/Abort.hpp>
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+#include "Path.hpp"
+#include "StandardPaths.hpp"
+
+using namespace kF;
+
+namespace
+{
+    constexpr auto PathCount = static_cast<std::size_t>(IO::StandardPath::Count);
+
+    /** @brief Resolved standard path, immutable once published */
+    struct Entry
+    {
+        Core::Vector<char, IO::IOAllocator, std::size_t> data {};
+        mutable const Entry *previous {}; // Entries replaced by a refresh are kept alive for their views
+    };
+
+    /** @brief Release a chain of entries */
+    void Release(const Entry *entry) noexcept
+    {
+        while (entry) {
+            const auto previous = entry->previous;
+            entry->~Entry();
+            IO::IOAllocator::Deallocate(const_cast<Entry *>(entry), sizeof(Entry), alignof(Entry));
+            entry = previous;
+        }
+    }
+
+    /** @brief Published entries and their writer lock, every entry is released at exit */
+    struct Registry
+    {
+        std::array<std::atomic<const Entry *>, PathCount> entries {};
+        const Entry *retired {};
+        std::mutex mutex {};
+
+        ~Registry(void) noexcept
+        {
+            for (auto &entry : entries)
+                Release(entry.load(std::memory_order_relaxed));
+            Release(retired);
+        }
+    };
+
+    Registry &GetRegistry(void) noexcept
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /** @brief Query the executable path, wai_getExecutablePath is called twice: once for the size then for the data */
+    [[nodiscard]] std::string QueryExecutablePath(void) noexcept
+    {
+        const auto expectedSize = wai_getExecutablePath(nullptr, 0, nullptr);
+        if (expectedSize == -1) [[unlikely]]
+            return std::string();
+        std::string path(static_cast<std::size_t>(expectedSize), '\0');
+        const auto finalSize = wai_getExecutablePath(path.data(), expectedSize, nullptr);
+        kFEnsure(finalSize == expectedSize,
+            "IO::GetExecutablePath: Couldn't retreive executable path");
+        return path;
+    }
+
+    /** @brief Resolve a single standard path (platform queries are only made for the requested path) */
+    [[nodiscard]] std::string ResolvePath(const IO::StandardPath path)
+    {
+        switch (path) {
+        case IO::StandardPath::Executable:
+            return QueryExecutablePath();
+        case IO::StandardPath::ExecutableDirectory:
+            return std::string(IO::Path::DirectoryOf(QueryExecutablePath()));
+        case IO::StandardPath::Config:
+            return sago::getConfigHome();
+        case IO::StandardPath::Data:
+            return sago::getDataHome();
+        case IO::StandardPath::State:
+            return sago::getStateDir();
+        case IO::StandardPath::Cache:
+            return sago::getCacheDir();
+        case IO::StandardPath::Documents:
+            return sago::getDocumentsFolder();
+        case IO::StandardPath::Desktop:
+            return sago::getDesktopFolder();
+        case IO::StandardPath::Pictures:
+            return sago::getPicturesFolder();
+        case IO::StandardPath::Music:
+            return sago::getMusicFolder();
+        case IO::StandardPath::Video:
+            return sago::getVideoFolder();
+        case IO::StandardPath::Download:
+            return sago::getDownloadFolder();
+        case IO::StandardPath::Save:
+            return sago::getSaveGamesFolder1();
+        default:
+            return std::string();
+        }
+    }
+
+    /** @brief Resolve a single standard path, a path that can't be resolved is left empty */
+    [[nodiscard]] std::string Resolve(const IO::StandardPath path) noexcept
+    {
+        // Platform folders may throw (unset home, missing user directories)
+        try {
+            return ResolvePath(path);
+        } catch (...) {
+            return std::string();
+        }
+    }
+
+    /** @brief Get the entry of a standard path, resolving it on first use */
+    [[nodiscard]] const Entry &GetEntry(const IO::StandardPath path) noexcept
+    {
+        auto &registry = GetRegistry();
+        auto &slot = registry.entries[static_cast<std::size_t>(path)];
+        if (const auto entry = slot.load(std::memory_order_acquire); entry) [[likely]]
+            return *entry;
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        if (const auto entry = slot.load(std::memory_order_relaxed); entry)
+            return *entry;
+        const auto resolved = Resolve(path);
+        const auto entry = new (IO::IOAllocator::Allocate(sizeof(Entry), alignof(Entry))) Entry {};
+        entry->data.resize(resolved.size());
+        std::copy(resolved.begin(), resolved.end(), entry->data.begin());
+        slot.store(entry, std::memory_order_release);
+        return *entry;
+    }
+}
+
+std::string_view IO::GetStandardPath(const StandardPath path) noexcept
+{
+    const auto &entry = GetEntry(path);
+    return std::string_view(entry.data.data(), entry.data.size());
+}
+
+void IO::RefreshStandardPaths(void) noexcept
+{
+    // Resolved paths are retired, each one is resolved again on its next use
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    for (auto &slot : registry.entries) {
+        if (const auto entry = slot.exchange(nullptr, std::memory_order_acq_rel); entry) {
+            entry->previous = registry.retired;
+            registry.retired = entry;
+        }
+    }
+}
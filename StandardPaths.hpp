@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include <Kube/Core/Utils.hpp>
 
 namespace kF::IO
@@ -12,8 +14,39 @@ namespace kF::IO
     /** @brief Default guessed path size */
     constexpr std::size_t DefaultPathSize = 260;
 
-
-    /** @brief Get executable path */
+    /** @brief Standard paths */
+    enum class StandardPath : std::uint32_t
+    {
+        Executable,
+        ExecutableDirectory,
+        Config,
+        Data,
+        State,
+        Cache,
+        Documents,
+        Desktop,
+        Pictures,
+        Music,
+        Video,
+        Download,
+        Save,
+        Count
+    };
+
+
+    /** @brief Get a standard path
+     *  @note Each standard path is resolved once on its first use (thread-safe), later calls don't allocate
+     *  @note A path that can't be resolved on this platform is empty
+     *  @note Returned views stay valid until the program exits, even across 'RefreshStandardPaths' */
+    [[nodiscard]] std::string_view GetStandardPath(const StandardPath path) noexcept;
+
+    /** @brief Resolve every standard path again (e.g. after the user changed its folders)
+     *  @note Paths are resolved again lazily on their next use, views returned before stay valid */
+    void RefreshStandardPaths(void) noexcept;
+
+
+    /** @brief Get executable path
+     *  @note Use 'std::string_view' as 'Type' to avoid any allocation (this applies to every path getter) */
     template<typename Type>
     [[nodiscard]] Type GetExecutablePath(void) noexcept;
 
@@ -66,4 +99,4 @@ namespace kF::IO
 	[[nodiscard]] Type GetSavePath(void) noexcept;
 }
 
-#include "StandardPaths.ipp"
\ No newline at end of file
+#include "StandardPaths.ipp"
@@ -0,0 +1,78 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO StreamReader
+ */
+
+#include <Kube/Core/Abort.hpp>
+
+#include "StreamReader.hpp"
+
+using namespace kF;
+
+IO::StreamReader::~StreamReader(void) noexcept
+{
+    // Wait for the in-flight prefetch before releasing its buffer
+    if (_pending)
+        _engine.dispatchAll([](const AsyncEngine::Completion &) {});
+    if (_buffers)
+        IOAllocator::Deallocate(_buffers, _chunkSize * 2, BufferAlignment);
+}
+
+IO::StreamReader::StreamReader(File &file, const std::size_t chunkSize, const std::size_t offset) noexcept
+    : _file(&file)
+    , _chunkSize(chunkSize)
+    , _offset(offset)
+    , _prefetchOffset(offset)
+    , _engine(2u)
+{
+    kFEnsure(chunkSize, "IO::StreamReader: Chunk size must be greater than zero");
+    kFEnsure(Core::HasFlags(file.mode(), File::Mode::Read), "IO::StreamReader: File not opened for reading");
+    if (!file.isResource()) {
+        _buffers = reinterpret_cast<std::uint8_t *>(IOAllocator::Allocate(chunkSize * 2, BufferAlignment));
+        prefetch(0u);
+    }
+}
+
+IO::ResourceView IO::StreamReader::next(void) noexcept
+{
+    // Resources are already in memory
+    if (_file->isResource()) {
+        const auto range = _file->map();
+        if (_offset >= range.size())
+            return ResourceView {};
+        const auto from = range.begin() + _offset;
+        const auto count = std::min(_chunkSize, range.size() - _offset);
+        _offset += count;
+        return ResourceView { .from = from, .to = from + count };
+    }
+
+    if (!_pending)
+        return ResourceView {};
+
+    AsyncEngine::Completion completion {};
+    while (!_engine.wait(&completion, &completion + 1));
+    _pending = false;
+    if (completion.result <= 0) {
+        _failed = completion.result < 0;
+        return ResourceView {};
+    }
+
+    // Prefetch the next chunk into the other buffer, a short read may happen before the end of file (signals, network file systems)
+    // so the next read resumes right after it and only an empty read ends the stream
+    const auto index = static_cast<std::uint32_t>(completion.userData);
+    const auto count = static_cast<std::size_t>(completion.result);
+    _prefetchOffset -= _chunkSize - count;
+    prefetch(index ^ 1u);
+    const auto from = _buffers + index * _chunkSize;
+    _offset += count;
+    return ResourceView { .from = from, .to = from + count };
+}
+
+void IO::StreamReader::prefetch(const std::uint32_t index) noexcept
+{
+    const auto buffer = _buffers + index * _chunkSize;
+    _engine.queueRead(*_file, buffer, buffer + _chunkSize, _prefetchOffset, index);
+    _engine.submit();
+    _prefetchOffset += _chunkSize;
+    _pending = true;
+}
@@ -0,0 +1,106 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: IO StreamReader
+ */
+
+#pragma once
+
+#include <iterator>
+
+#include "AsyncEngine.hpp"
+
+namespace kF::IO
+{
+    class StreamReader;
+}
+
+/** @brief Read a file as a sequence of fixed-size chunks with bounded memory
+ *  @note Disk files are double-buffered: the next chunk is prefetched through an AsyncEngine while the current one is processed
+ *  @note Resource files yield zero-copy views into the resource data */
+class kF::IO::StreamReader
+{
+public:
+    /** @brief Default size of a chunk */
+    static constexpr std::size_t DefaultChunkSize = 1024 * 1024;
+
+    /** @brief Alignment of chunk buffers */
+    static constexpr std::size_t BufferAlignment = 4096;
+
+    /** @brief Chunk iterator, compares equal to 'std::default_sentinel' once the stream is exhausted */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ResourceView;
+        using difference_type = std::ptrdiff_t;
+
+        /** @brief Constructor */
+        Iterator(StreamReader * const reader = nullptr, const ResourceView chunk = ResourceView {}) noexcept
+            : _reader(reader), _chunk(chunk) {}
+
+        /** @brief Get current chunk */
+        [[nodiscard]] inline const ResourceView &operator*(void) const noexcept { return _chunk; }
+
+        /** @brief Advance to the next chunk */
+        inline Iterator &operator++(void) noexcept { _chunk = _reader->next(); return *this; }
+
+        /** @brief Check if the stream is exhausted */
+        [[nodiscard]] inline bool operator==(const std::default_sentinel_t) const noexcept { return _chunk.empty(); }
+
+    private:
+        StreamReader *_reader {};
+        ResourceView _chunk {};
+    };
+
+
+    /** @brief Destructor, waits for the in-flight prefetch */
+    ~StreamReader(void) noexcept;
+
+    /** @brief Constructor, starts prefetching the first chunk
+     *  @note The file must outlive the reader */
+    StreamReader(File &file, const std::size_t chunkSize = DefaultChunkSize, const std::size_t offset = 0u) noexcept;
+
+    /** @brief Deleted copy constructor */
+    StreamReader(const StreamReader &other) noexcept = delete;
+
+    /** @brief Deleted copy assignment */
+    StreamReader &operator=(const StreamReader &other) noexcept = delete;
+
+
+    /** @brief Get chunk size */
+    [[nodiscard]] inline std::size_t chunkSize(void) const noexcept { return _chunkSize; }
+
+    /** @brief Get the file offset of the next chunk returned by 'next' */
+    [[nodiscard]] inline std::size_t offset(void) const noexcept { return _offset; }
+
+    /** @brief Check if a read failed */
+    [[nodiscard]] inline bool failed(void) const noexcept { return _failed; }
+
+
+    /** @brief Get the next chunk, an empty view means the end of the stream
+     *  @note The previous chunk is invalidated
+     *  @note A chunk may be shorter than the chunk size before the end of the stream if the system returned a short read */
+    [[nodiscard]] ResourceView next(void) noexcept;
+
+
+    /** @brief Begin iterator, fetches the next chunk */
+    [[nodiscard]] inline Iterator begin(void) noexcept { return Iterator(this, next()); }
+
+    /** @brief End sentinel */
+    [[nodiscard]] inline std::default_sentinel_t end(void) const noexcept { return std::default_sentinel; }
+
+
+private:
+    /** @brief Queue the read of the chunk at '_prefetchOffset' into buffer 'index' */
+    void prefetch(const std::uint32_t index) noexcept;
+
+
+    File *_file {};
+    std::uint8_t *_buffers {};
+    std::size_t _chunkSize {};
+    std::size_t _offset {};
+    std::size_t _prefetchOffset {};
+    bool _pending {};
+    bool _failed {};
+    AsyncEngine _engine;
+};
@@ -0,0 +1,118 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of AsyncEngine
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/ResourceManager.hpp>
+#include <Kube/IO/AsyncEngine.hpp>
+#include <Kube/IO/HandlePool.hpp>
+
+using namespace kF;
+
+constexpr std::string_view ResourcePath = ":/IOTests/FileTest01.txt";
+constexpr std::string_view ContentText = "Kube Framework !";
+
+TEST(AsyncEngine, WriteThenRead)
+{
+    constexpr std::uint32_t Count = 64;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_AsyncEngine.bin").string();
+
+    {
+        IO::AsyncEngine engine(16);
+
+        // Write batch
+        IO::File output(path, IO::File::Mode::WriteBinary);
+        for (auto i = 0u; i != Count; ++i) {
+            const auto data = reinterpret_cast<const std::uint8_t *>(ContentText.data());
+            engine.queueWrite(output, data, data + ContentText.size(), i * ContentText.size(), i);
+        }
+        ASSERT_EQ(engine.queuedCount(), Count);
+        std::uint32_t written {};
+        engine.dispatchAll([&written](const IO::AsyncEngine::Completion &completion) {
+            ASSERT_EQ(completion.result, ContentText.size());
+            ++written;
+        });
+        ASSERT_EQ(written, Count);
+        ASSERT_TRUE(engine.idle());
+
+        // Read batch
+        IO::File input(path, IO::File::Mode::ReadBinary);
+        ASSERT_EQ(input.fileSize(), Count * ContentText.size());
+        std::uint8_t buffer[Count][ContentText.size()] {};
+        for (auto i = 0u; i != Count; ++i)
+            engine.queueRead(input, std::begin(buffer[i]), std::end(buffer[i]), i * ContentText.size(), i);
+        ASSERT_EQ(engine.submit(), 16);
+        std::uint32_t read {};
+        engine.dispatchAll([&read](const IO::AsyncEngine::Completion &completion) {
+            ASSERT_EQ(completion.result, ContentText.size());
+            ++read;
+        });
+        ASSERT_EQ(read, Count);
+        for (const auto &chunk : buffer)
+            ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(chunk), std::size(chunk)), ContentText);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(AsyncEngine, Resource)
+{
+    IO::ResourceManager manager;
+    IO::AsyncEngine engine;
+    IO::File file(ResourcePath, IO::File::Mode::Read);
+
+    std::uint8_t buffer[ContentText.size()] {};
+    engine.queueRead(file, std::begin(buffer), std::end(buffer), 0u, 42u);
+    IO::AsyncEngine::Completion completion {};
+    ASSERT_EQ(engine.poll(&completion, &completion + 1), 1);
+    ASSERT_EQ(completion.userData, 42u);
+    ASSERT_EQ(completion.result, ContentText.size());
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(buffer), std::size(buffer)), ContentText);
+
+    // Reads past the end complete empty
+    engine.queueRead(file, std::begin(buffer), std::end(buffer), ContentText.size() + 100u, 43u);
+    ASSERT_EQ(engine.poll(&completion, &completion + 1), 1);
+    ASSERT_EQ(completion.userData, 43u);
+    ASSERT_EQ(completion.result, 0);
+}
+
+TEST(AsyncEngine, PooledFiles)
+{
+    constexpr std::uint32_t Count = 8;
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_AsyncEnginePool";
+    std::filesystem::create_directories(directory);
+
+    // The pool must outlive the engine
+    IO::HandlePool pool(1u);
+    {
+        IO::AsyncEngine engine;
+        std::vector<IO::File> files;
+        for (auto i = 0u; i != Count; ++i) {
+            const auto path = (directory / ("File" + std::to_string(i) + ".txt")).string();
+            std::ofstream(path) << ContentText;
+            files.emplace_back(path, IO::File::Mode::Read, pool);
+        }
+
+        // Queued requests keep their handle leased, the pool can't close them before completion
+        std::uint8_t buffer[Count][ContentText.size()] {};
+        for (auto i = 0u; i != Count; ++i)
+            engine.queueRead(files[i], std::begin(buffer[i]), std::end(buffer[i]), 0u, i);
+        ASSERT_EQ(pool.size(), Count);
+        std::uint32_t read {};
+        engine.dispatchAll([&read](const IO::AsyncEngine::Completion &completion) {
+            ASSERT_EQ(completion.result, ContentText.size());
+            ++read;
+        });
+        ASSERT_EQ(read, Count);
+        ASSERT_EQ(pool.size(), 1u);
+        for (const auto &chunk : buffer)
+            ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(chunk), std::size(chunk)), ContentText);
+    }
+    std::filesystem::remove_all(directory);
+}
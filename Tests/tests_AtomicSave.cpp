@@ -0,0 +1,89 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of AtomicSave
+ */
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/AtomicSave.hpp>
+
+using namespace kF;
+
+namespace
+{
+    [[nodiscard]] std::string ReadText(const std::string &path)
+    {
+        IO::File file(path, IO::File::Mode::Read);
+        return file.readAll<std::string>();
+    }
+
+    [[nodiscard]] std::size_t CountEntries(const std::filesystem::path &directory)
+    {
+        return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()));
+    }
+}
+
+TEST(AtomicSave, Replace)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_AtomicSave";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto path = (directory / "State.txt").string();
+
+    ASSERT_TRUE(IO::SaveAtomically(path, std::string_view("First")));
+    ASSERT_EQ(ReadText(path), "First");
+    ASSERT_TRUE(IO::SaveAtomically(path, std::string_view("Second")));
+    ASSERT_EQ(ReadText(path), "Second");
+    ASSERT_EQ(CountEntries(directory), 1);
+
+    // Replacing a file keeps its permissions
+    constexpr auto Permissions = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write;
+    std::filesystem::permissions(path, Permissions);
+    ASSERT_TRUE(IO::SaveAtomically(path, std::string_view("Third")));
+    ASSERT_EQ(ReadText(path), "Third");
+    ASSERT_EQ(std::filesystem::status(path).permissions(), Permissions);
+
+    // Saving into a missing directory fails without side effects
+    ASSERT_FALSE(IO::SaveAtomically((directory / "Missing" / "State.txt").string(), std::string_view("Lost")));
+    ASSERT_EQ(CountEntries(directory), 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(AtomicSave, GroupCommit)
+{
+    constexpr auto Count = 100u;
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_GroupCommit";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto pathOf = [&directory](const std::uint32_t index) { return (directory / ("State" + std::to_string(index) + ".txt")).string(); };
+
+    {
+        IO::GroupCommit group;
+        for (auto i = 0u; i != Count; ++i)
+            ASSERT_TRUE(group.save(pathOf(i), "Value" + std::to_string(i)));
+        // Only the last save of a path is kept
+        ASSERT_TRUE(group.save(pathOf(0), std::string_view("Overwritten")));
+        ASSERT_EQ(group.pendingCount(), Count);
+
+        // Targets are untouched until commit
+        ASSERT_FALSE(std::filesystem::exists(pathOf(1)));
+        ASSERT_TRUE(group.commit());
+        ASSERT_EQ(group.pendingCount(), 0);
+    }
+    ASSERT_EQ(CountEntries(directory), Count);
+    ASSERT_EQ(ReadText(pathOf(0)), "Overwritten");
+    for (auto i = 1u; i != Count; ++i)
+        ASSERT_EQ(ReadText(pathOf(i)), "Value" + std::to_string(i));
+
+    {
+        IO::GroupCommit group;
+        ASSERT_TRUE(group.save(pathOf(1), std::string_view("Discarded")));
+        group.discard();
+    }
+    ASSERT_EQ(ReadText(pathOf(1)), "Value1");
+    ASSERT_EQ(CountEntries(directory), Count);
+    std::filesystem::remove_all(directory);
+}
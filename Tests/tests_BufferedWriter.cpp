@@ -0,0 +1,63 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of BufferedWriter
+ */
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/BufferedWriter.hpp>
+
+using namespace kF;
+
+TEST(BufferedWriter, Coalescing)
+{
+    constexpr std::uint32_t Count = 10000;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_BufferedWriter.bin").string();
+
+    {
+        IO::File file(path, IO::File::Mode::WriteBinary);
+        IO::BufferedWriter writer(file, IO::BufferedWriter::BlockSize * 2);
+        for (auto i = 0u; i != Count; ++i) {
+            ASSERT_TRUE(writer.writeValue(i));
+            ASSERT_EQ(writer.offset(), (i + 1) * sizeof(i));
+        }
+        // Only complete blocks reached the file so far
+        ASSERT_EQ(file.fileSize() % IO::BufferedWriter::BlockSize, 0);
+        ASSERT_EQ(file.fileSize() + writer.bufferedSize(), Count * sizeof(std::uint32_t));
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        const auto content = file.readAll<std::string>();
+        ASSERT_EQ(content.size(), Count * sizeof(std::uint32_t));
+        const auto values = reinterpret_cast<const std::uint32_t *>(content.data());
+        for (auto i = 0u; i != Count; ++i)
+            ASSERT_EQ(values[i], i);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(BufferedWriter, Scattered)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_BufferedWriterScattered.bin").string();
+    const std::string large(IO::BufferedWriter::DefaultCapacity * 2, 'L');
+
+    {
+        IO::File file(path, IO::File::Mode::WriteBinary);
+        IO::BufferedWriter writer(file);
+        ASSERT_TRUE(writer.writeAll(std::string_view("Header")));
+        ASSERT_TRUE(writer.writeAll(large));
+        ASSERT_EQ(writer.bufferedSize(), 0);
+        ASSERT_TRUE(writer.writeAll(std::string_view("Footer")));
+        ASSERT_TRUE(writer.write(reinterpret_cast<const std::uint8_t *>("Kube"), reinterpret_cast<const std::uint8_t *>("Kube") + 4, 2));
+        ASSERT_TRUE(writer.flush());
+        ASSERT_EQ(writer.bufferedSize(), 0);
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        const auto content = file.readAll<std::string>();
+        ASSERT_EQ(content, "HeKube" + large + "Footer");
+    }
+    std::filesystem::remove(path);
+}
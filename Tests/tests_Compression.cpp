@@ -0,0 +1,110 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Compression
+ */
+
+#include <cstring>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Compression.hpp>
+
+using namespace kF;
+
+namespace
+{
+    std::string MakeInput(const std::size_t size)
+    {
+        std::mt19937 engine(42);
+        std::string input;
+        while (input.size() < size) {
+            // Mix compressible text and random bytes
+            if (engine() % 4)
+                input.append("Kube Framework ! ");
+            else
+                input.push_back(static_cast<char>(engine()));
+        }
+        input.resize(size);
+        return input;
+    }
+
+    IO::ResourceView ToView(const std::string &string)
+    {
+        const auto data = reinterpret_cast<const std::uint8_t *>(string.data());
+        return IO::ResourceView { .from = data, .to = data + string.size() };
+    }
+}
+
+TEST(Compression, Block)
+{
+    const auto input = MakeInput(10000);
+    std::uint8_t compressed[10000] {};
+    std::uint8_t output[10000] {};
+
+    const auto size = IO::Compression::CompressBlock(ToView(input).begin(), input.size(), std::begin(compressed), std::size(compressed));
+    ASSERT_GT(size, 0);
+    ASSERT_LT(size, input.size());
+    ASSERT_TRUE(IO::Compression::DecompressBlock(std::begin(compressed), size, std::begin(output), std::size(output)));
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(output), std::size(output)), input);
+
+    // Corrupted data must be rejected
+    ASSERT_FALSE(IO::Compression::DecompressBlock(std::begin(compressed), size / 2, std::begin(output), std::size(output)));
+}
+
+TEST(Compression, Container)
+{
+    constexpr std::uint32_t BlockSize = 1024;
+    const auto input = MakeInput(BlockSize * 10 + 123);
+    Core::Vector<std::uint8_t, IO::IOAllocator, std::size_t> container;
+    IO::Compression::Compress(ToView(input), container, BlockSize);
+    const IO::ResourceView view { .from = container.data(), .to = container.data() + container.size() };
+
+    IO::Compression::Header header;
+    ASSERT_TRUE(IO::Compression::ParseHeader(view, header));
+    ASSERT_EQ(header.size, input.size());
+    ASSERT_EQ(header.blockCount, 11);
+    ASSERT_LT(container.size(), input.size());
+
+    // Whole resource
+    std::string output(input.size(), '\0');
+    std::uint8_t scratch[BlockSize];
+    auto data = reinterpret_cast<std::uint8_t *>(output.data());
+    ASSERT_EQ(IO::Compression::Read(view, data, data + output.size(), 0, scratch), input.size());
+    ASSERT_EQ(output, input);
+
+    // Partial ranges across block boundaries
+    for (const auto &[offset, count] : { std::pair<std::size_t, std::size_t> { 10, 20 }, { 1000, 100 }, { 2047, 3000 }, { input.size() - 5, 100 } }) {
+        std::string range(count, '\0');
+        data = reinterpret_cast<std::uint8_t *>(range.data());
+        const auto read = IO::Compression::Read(view, data, data + count, offset, scratch);
+        ASSERT_EQ(read, std::min(count, input.size() - offset));
+        ASSERT_EQ(range.substr(0, read), input.substr(offset, read));
+    }
+
+    // Empty ranges never decode
+    ASSERT_EQ(IO::Compression::Read(view, data, data, 0, scratch), 0u);
+    ASSERT_EQ(IO::Compression::Read(view, data, data, input.size() - 1, scratch), 0u);
+
+    // Block offsets pointing outside of the container are rejected
+    auto corrupted = container;
+    const auto offsets = corrupted.data() + sizeof(IO::Compression::Header);
+    const std::uint32_t outside = 0xFFFFFF00u;
+    std::memcpy(offsets + 2 * sizeof(std::uint32_t), &outside, sizeof(outside));
+    const IO::ResourceView corruptedView { .from = corrupted.data(), .to = corrupted.data() + corrupted.size() };
+    ASSERT_TRUE(IO::Compression::ParseHeader(corruptedView, header));
+    data = reinterpret_cast<std::uint8_t *>(output.data());
+    ASSERT_EQ(IO::Compression::Read(corruptedView, data, data + output.size(), 0, scratch), 0u);
+}
+
+TEST(Compression, Empty)
+{
+    Core::Vector<std::uint8_t, IO::IOAllocator, std::size_t> container;
+    IO::Compression::Compress(IO::ResourceView {}, container);
+    const IO::ResourceView view { .from = container.data(), .to = container.data() + container.size() };
+    IO::Compression::Header header;
+    ASSERT_TRUE(IO::Compression::ParseHeader(view, header));
+    ASSERT_EQ(header.size, 0u);
+    std::uint8_t byte {};
+    ASSERT_EQ(IO::Compression::Read(view, &byte, &byte + 1, 0, nullptr), 0u);
+}
@@ -0,0 +1,133 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of ContentCache
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/ContentCache.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Load 'path' until 'predicate' holds, changes are noticed once the watcher thread is notified */
+    template<typename Predicate>
+        requires std::invocable<Predicate, const IO::ContentBuffer &>
+    IO::ContentBuffer LoadUntil(IO::ContentCache &cache, const std::string &path, Predicate &&predicate)
+    {
+        for (auto attempt = 0u; attempt != 1000u; ++attempt) {
+            auto buffer = cache.load(path);
+            if (predicate(buffer))
+                return buffer;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return cache.load(path);
+    }
+
+    /** @brief Load 'path' until its content is 'expected' */
+    IO::ContentBuffer LoadUntil(IO::ContentCache &cache, const std::string &path, const std::string_view &expected)
+    {
+        return LoadUntil(cache, path, [&expected](const IO::ContentBuffer &buffer) { return buffer.toView() == expected; });
+    }
+}
+
+TEST(ContentCache, LoadAndInvalidate)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_ContentCache";
+    std::filesystem::create_directories(directory);
+    const auto path = (directory / "Config.txt").generic_string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "Version 1";
+
+    IO::ContentCache cache;
+    ASSERT_TRUE(IO::ContentCache::IsInitialized());
+    const auto first = cache.load(path);
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first.toView(), "Version 1");
+
+    // Hits share the same buffer, whatever the spelling of the path
+    const auto second = IO::ContentCache::Get().load((directory / "." / ".." / "IOTests_ContentCache" / "Config.txt").string());
+    ASSERT_EQ(second.data(), first.data());
+    ASSERT_EQ(first.useCount(), 3u);
+    ASSERT_EQ(cache.count(), 1u);
+    ASSERT_EQ(cache.size(), first.size());
+    ASSERT_EQ(cache.statistics().hits, 1u);
+    ASSERT_EQ(cache.statistics().misses, 1u);
+
+    // Any change to the file drops its content, previous buffers stay valid
+    std::ofstream(path, std::ios::binary | std::ios::app) << " and 2";
+    const auto third = LoadUntil(cache, path, "Version 1 and 2");
+    ASSERT_EQ(third.toView(), "Version 1 and 2");
+    ASSERT_EQ(first.toView(), "Version 1");
+    ASSERT_EQ(first.useCount(), 2u);
+    ASSERT_EQ(cache.statistics().invalidations, 1u);
+
+    // Replacing the file by a rename is noticed as well
+    const auto temporary = (directory / "Config.tmp").string();
+    std::ofstream(temporary, std::ios::binary | std::ios::trunc) << "Version 3";
+    std::filesystem::rename(temporary, path);
+    ASSERT_EQ(LoadUntil(cache, path, "Version 3").toView(), "Version 3");
+    ASSERT_EQ(cache.load(path).data(), cache.load(path).data());
+
+    // Removed files can't be loaded anymore
+    std::filesystem::remove(path);
+    ASSERT_FALSE(LoadUntil(cache, path, [](const IO::ContentBuffer &buffer) { return !buffer; }));
+    ASSERT_EQ(cache.count(), 0u);
+    ASSERT_FALSE(cache.load((directory / "Missing.txt").string()));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ContentCache, Budget)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_ContentCacheBudget";
+    std::filesystem::create_directories(directory);
+    std::string paths[3];
+    for (auto i = 0u; i != std::size(paths); ++i) {
+        paths[i] = (directory / ("File" + std::to_string(i) + ".txt")).string();
+        std::ofstream(paths[i], std::ios::binary | std::ios::trunc) << std::string(100, static_cast<char>('a' + i));
+    }
+
+    IO::ContentCache cache(250);
+    static_cast<void>(cache.load(paths[0]));
+    static_cast<void>(cache.load(paths[1]));
+    static_cast<void>(cache.load(paths[0]));
+    // paths[1] is the least recently used content
+    static_cast<void>(cache.load(paths[2]));
+    ASSERT_EQ(cache.count(), 2u);
+    ASSERT_EQ(cache.size(), 200u);
+    ASSERT_EQ(cache.statistics().evictions, 1u);
+    cache.resetStatistics();
+    static_cast<void>(cache.load(paths[0]));
+    static_cast<void>(cache.load(paths[2]));
+    ASSERT_EQ(cache.statistics().hits, 2u);
+
+    // Contents larger than the budget are read but not cached
+    cache.setBudget(50);
+    ASSERT_EQ(cache.count(), 0u);
+    ASSERT_EQ(cache.load(paths[1]).size(), 100u);
+    ASSERT_EQ(cache.count(), 0u);
+
+    cache.setBudget(IO::ContentCache::DefaultBudget);
+    static_cast<void>(cache.load(paths[1]));
+    cache.invalidate(paths[1]);
+    ASSERT_EQ(cache.count(), 0u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ContentCache, Resource)
+{
+    IO::ResourceManager manager;
+    IO::ContentCache cache;
+    const auto buffer = cache.load(":/IOTests/FileTest01.txt");
+    ASSERT_EQ(buffer.toView(), "Kube Framework !");
+    ASSERT_EQ(cache.load(":/IOTests/FileTest01.txt").data(), buffer.data());
+    ASSERT_FALSE(cache.load(":/IOTests/Missing.txt"));
+}
@@ -0,0 +1,110 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Copy
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Copy.hpp>
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+namespace
+{
+    [[nodiscard]] std::string ReadContent(const std::string &path)
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        return file.readAll<std::string>();
+    }
+
+    [[nodiscard]] std::string MakeSource(const std::string &path, const std::size_t size)
+    {
+        std::string content(size, '\0');
+        for (auto i = 0ul; i != size; ++i)
+            content[i] = static_cast<char>(i * 7 + i / 251);
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+        return content;
+    }
+}
+
+TEST(Copy, Disk)
+{
+    const auto source = (std::filesystem::temp_directory_path() / "IOTests_CopySource.bin").string();
+    const auto destination = (std::filesystem::temp_directory_path() / "IOTests_CopyDestination.bin").string();
+    const auto content = MakeSource(source, 1024 * 1024 + 17);
+    std::filesystem::remove(destination);
+
+    for (const auto allowClone : { true, false }) {
+        std::size_t lastProgress {};
+        const auto result = IO::CopyFile(source, destination, IO::CopyOptions {
+            .chunkSize = 64 * 1024,
+            .threadCount = 4,
+            .allowClone = allowClone,
+            .progress = [](const std::size_t copied, const std::size_t total, void * const userData) noexcept {
+                auto &last = *reinterpret_cast<std::size_t *>(userData);
+                EXPECT_GT(copied, last);
+                EXPECT_LE(copied, total);
+                last = copied;
+                return true;
+            },
+            .userData = &lastProgress
+        });
+        ASSERT_EQ(result.status, IO::CopyStatus::Success);
+        ASSERT_NE(result.method, IO::CopyMethod::Resource);
+        ASSERT_EQ(result.copied, content.size());
+        ASSERT_EQ(lastProgress, content.size());
+        ASSERT_EQ(ReadContent(destination), content);
+
+        // Destination exists and overwrite is not allowed
+        ASSERT_EQ(IO::CopyFile(source, destination).status, IO::CopyStatus::Failed);
+        ASSERT_TRUE(std::filesystem::remove(destination));
+    }
+
+    // File::copy goes through the same engine
+    ASSERT_TRUE(IO::File(source).copy(destination));
+    ASSERT_EQ(ReadContent(destination), content);
+    std::filesystem::remove(destination);
+    std::filesystem::remove(source);
+}
+
+TEST(Copy, Cancel)
+{
+    const auto source = (std::filesystem::temp_directory_path() / "IOTests_CopyCancelSource.bin").string();
+    const auto destination = (std::filesystem::temp_directory_path() / "IOTests_CopyCancelDestination.bin").string();
+    static_cast<void>(MakeSource(source, 1024 * 1024));
+    std::filesystem::remove(destination);
+
+    const auto result = IO::CopyFile(source, destination, IO::CopyOptions {
+        .chunkSize = 4096,
+        .threadCount = 1,
+        .allowClone = false,
+        .progress = [](const std::size_t, const std::size_t, void * const) noexcept { return false; }
+    });
+    ASSERT_EQ(result.status, IO::CopyStatus::Cancelled);
+    ASSERT_EQ(result.copied, 4096);
+    ASSERT_FALSE(std::filesystem::exists(destination));
+
+    ASSERT_EQ(IO::CopyFile(destination, source).status, IO::CopyStatus::Failed);
+    std::filesystem::remove(source);
+}
+
+TEST(Copy, Resource)
+{
+    IO::ResourceManager manager;
+    const auto destination = (std::filesystem::temp_directory_path() / "IOTests_CopyResource.txt").string();
+    std::filesystem::remove(destination);
+
+    const auto result = IO::CopyFile(":/IOTests/FileTest01.txt", destination);
+    ASSERT_EQ(result.status, IO::CopyStatus::Success);
+    ASSERT_EQ(result.method, IO::CopyMethod::Resource);
+    ASSERT_EQ(ReadContent(destination), "Kube Framework !");
+    // A missing source doesn't touch the destination
+    ASSERT_EQ(IO::CopyFile(":/IOTests/FileTestZZ.txt", destination, IO::CopyOptions { .overwrite = true }).status, IO::CopyStatus::Failed);
+    ASSERT_EQ(ReadContent(destination), "Kube Framework !");
+    std::filesystem::remove(destination);
+}
@@ -0,0 +1,136 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Direct
+ */
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Direct.hpp>
+#include <Kube/IO/File.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Aligned buffer */
+    struct Buffer
+    {
+        Buffer(const std::size_t size_) noexcept
+            : data(reinterpret_cast<std::uint8_t *>(IO::Direct::Allocator::Allocate(size_, IO::Direct::Alignment))), size(size_) {}
+        ~Buffer(void) noexcept { IO::Direct::Allocator::Deallocate(data, size, IO::Direct::Alignment); }
+
+        std::uint8_t *data {};
+        std::size_t size {};
+    };
+
+    constexpr std::uint8_t Pattern(const std::size_t index) noexcept { return static_cast<std::uint8_t>(index * 31u + 7u); }
+}
+
+TEST(Direct, AlignedAndUnalignedTransfers)
+{
+    // The working directory is more likely than the temporary one to support unbuffered handles
+    const auto path = (std::filesystem::current_path() / "IOTests_Direct.bin").string();
+    constexpr auto Size = 3 * IO::Direct::Alignment + 123;
+    Buffer source(Size + IO::Direct::Alignment);
+    for (auto i = 0u; i != source.size; ++i)
+        source.data[i] = Pattern(i);
+
+    bool direct {};
+    const auto handle = IO::Native::OpenDirect(path, false, true, direct);
+    ASSERT_NE(handle, IO::Native::InvalidHandle);
+    ASSERT_TRUE(IO::Direct::IsAligned(source.data));
+
+    // Aligned body then unaligned tail, followed by a write patching the middle of two blocks
+    ASSERT_EQ(IO::Direct::Write(handle, source.data, Size, 0), Size);
+    ASSERT_EQ(IO::Native::Size(handle), Size);
+    const std::uint8_t patch[10] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    ASSERT_EQ(IO::Direct::Write(handle, patch, sizeof(patch), IO::Direct::Alignment - 5), sizeof(patch));
+    ASSERT_EQ(IO::Native::Size(handle), Size);
+
+    Buffer destination(Size + IO::Direct::Alignment);
+    ASSERT_EQ(IO::Direct::Read(handle, destination.data, Size + 100, 0), Size);
+    for (auto i = 0u; i != Size; ++i) {
+        const auto offset = i - (IO::Direct::Alignment - 5);
+        ASSERT_EQ(destination.data[i], offset < sizeof(patch) ? patch[offset] : Pattern(i));
+    }
+
+    // Unaligned destination and offset
+    ASSERT_EQ(IO::Direct::Read(handle, destination.data + 3, 2 * IO::Direct::Alignment, 17), 2 * IO::Direct::Alignment);
+    ASSERT_EQ(destination.data[3], Pattern(17));
+    ASSERT_EQ(IO::Direct::Read(handle, destination.data, 10, Size + 1), 0u);
+
+    // Appending an unaligned range past the end keeps the exact file size
+    ASSERT_EQ(IO::Direct::Write(handle, source.data + 1, 50, Size + 10), 50u);
+    ASSERT_EQ(IO::Native::Size(handle), Size + 60);
+    IO::Native::Close(handle);
+    std::filesystem::remove(path);
+}
+
+TEST(Direct, WriteVector)
+{
+    const auto path = (std::filesystem::current_path() / "IOTests_DirectVector.bin").string();
+    constexpr auto Size = 4 * IO::Direct::Alignment;
+    Buffer source(Size);
+    for (auto i = 0u; i != source.size; ++i)
+        source.data[i] = Pattern(i);
+
+    bool direct {};
+    const auto handle = IO::Native::OpenDirect(path, false, true, direct);
+    ASSERT_NE(handle, IO::Native::InvalidHandle);
+    ASSERT_EQ(IO::Direct::Write(handle, source.data, Size, 0), Size);
+
+    // Small unaligned pieces around an aligned body, then pieces patching the middle of the file
+    const std::uint8_t header[3] { 1, 2, 3 };
+    const std::uint8_t footer[5] { 4, 5, 6, 7, 8 };
+    const IO::ResourceView pieces[] {
+        IO::ResourceView { .from = header, .to = header + sizeof(header) },
+        IO::ResourceView { .from = source.data + 3, .to = source.data + IO::Direct::Alignment },
+        IO::ResourceView { .from = source.data, .to = source.data + IO::Direct::Alignment },
+        IO::ResourceView { .from = footer, .to = footer + sizeof(footer) },
+        IO::ResourceView { .from = footer, .to = footer },
+        IO::ResourceView { .from = header, .to = header + sizeof(header) }
+    };
+    constexpr auto VectorSize = sizeof(header) + (IO::Direct::Alignment - 3) + IO::Direct::Alignment + sizeof(footer) + sizeof(header);
+    ASSERT_EQ(IO::Direct::WriteVector(handle, pieces, static_cast<std::uint32_t>(std::size(pieces)), 0), VectorSize);
+    ASSERT_EQ(IO::Direct::WriteVector(handle, pieces, 1u, 2 * IO::Direct::Alignment + 100), sizeof(header));
+    ASSERT_EQ(IO::Native::Size(handle), Size);
+
+    std::string expected(reinterpret_cast<const char *>(source.data), Size);
+    std::string written;
+    for (const auto &piece : pieces)
+        written.append(reinterpret_cast<const char *>(piece.from), piece.size());
+    expected.replace(0, written.size(), written);
+    expected.replace(2 * IO::Direct::Alignment + 100, sizeof(header), reinterpret_cast<const char *>(header), sizeof(header));
+    Buffer destination(Size);
+    ASSERT_EQ(IO::Direct::Read(handle, destination.data, Size, 0), Size);
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(destination.data), Size), expected);
+
+    // Writing past the end keeps the exact file size
+    ASSERT_EQ(IO::Direct::WriteVector(handle, pieces + 3, 3u, Size + 10), sizeof(footer) + sizeof(header));
+    ASSERT_EQ(IO::Native::Size(handle), Size + 10 + sizeof(footer) + sizeof(header));
+    IO::Native::Close(handle);
+    std::filesystem::remove(path);
+}
+
+TEST(Direct, File)
+{
+    const auto path = (std::filesystem::current_path() / "IOTests_DirectFile.txt").string();
+    const std::string data = "Hello unbuffered world";
+    {
+        IO::File file(path, IO::File::Mode::WriteDirect);
+        ASSERT_TRUE(IO::File::IsDirect(file.mode()));
+        ASSERT_TRUE(file.writeAll(data));
+        ASSERT_TRUE(file.write(reinterpret_cast<const std::uint8_t *>(data.data()), reinterpret_cast<const std::uint8_t *>(data.data()) + 5, 6));
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadDirect);
+        ASSERT_EQ(file.fileSize(), data.size());
+        ASSERT_EQ(file.readAll<std::string>(), "Hello Hellofered world");
+    }
+    ASSERT_FALSE(IO::File::IsDirect(IO::File::Mode::ReadAndWriteBinary));
+    ASSERT_FALSE(IO::File::IsDirect(IO::File::Mode::ReadMapped));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,70 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Directory
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/ResourceManager.hpp>
+#include <Kube/IO/Directory.hpp>
+
+using namespace kF;
+
+TEST(Directory, Disk)
+{
+    const auto root = std::filesystem::temp_directory_path() / "IOTests_Directory";
+    std::filesystem::remove_all(root);
+    for (auto i = 0u; i != 8; ++i) {
+        const auto directory = root / ("Dir" + std::to_string(i)) / "Sub";
+        std::filesystem::create_directories(directory);
+        for (auto j = 0u; j != 4; ++j) {
+            std::ofstream(directory / ("File" + std::to_string(j) + ".txt")) << j;
+            std::ofstream(directory.parent_path() / ("File" + std::to_string(j) + ".txt")) << j;
+        }
+    }
+
+    std::vector<std::string> expected;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(root))
+        expected.push_back(entry.path().string());
+    std::sort(expected.begin(), expected.end());
+
+    // Flat listing
+    IO::DirectoryListing listing;
+    ASSERT_TRUE(IO::ListDirectory(root.string(), listing));
+    ASSERT_EQ(listing.size(), 8);
+    for (const auto entry : listing)
+        ASSERT_EQ(entry.type, IO::EntryType::Directory);
+
+    // Parallel recursive walk
+    listing.clear();
+    ASSERT_TRUE(IO::WalkDirectory(root.string(), listing, 4));
+    listing.sort();
+    ASSERT_EQ(listing.size(), expected.size());
+    for (auto i = 0u; i != listing.size(); ++i) {
+        ASSERT_EQ(listing[i].path, expected[i]);
+        ASSERT_EQ(listing[i].type, std::filesystem::is_directory(expected[i]) ? IO::EntryType::Directory : IO::EntryType::File);
+    }
+    ASSERT_EQ(listing[listing.size() - 1].name(), "File3.txt");
+
+    ASSERT_FALSE(IO::WalkDirectory((root / "Missing").string(), listing));
+    std::filesystem::remove_all(root);
+}
+
+TEST(Directory, Resource)
+{
+    IO::ResourceManager manager;
+    IO::DirectoryListing listing;
+
+    ASSERT_TRUE(IO::WalkDirectory(":/IOTests", listing));
+    const auto it = std::find_if(listing.begin(), listing.end(), [](const auto &entry) {
+        return entry.path == ":/IOTests/FileTest01.txt";
+    });
+    ASSERT_NE(it, listing.end());
+    ASSERT_EQ((*it).type, IO::EntryType::File);
+    ASSERT_EQ((*it).name(), "FileTest01.txt");
+}
@@ -3,6 +3,11 @@
  * @ Description: Unit tests of File
  */
 
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <Kube/IO/ResourceManager.hpp>
@@ -43,6 +48,46 @@ TEST(File, Test01)
     ASSERT_EQ(view, Test01ContentText);
 }
 
+TEST(File, ResourceHandle)
+{
+    constexpr auto Handle = IO::MakeResourceHandle(Test01Path);
+    static_assert(Handle.environment == EnvironmentHash);
+    static_assert(Handle.path == Core::Hash(Test01ResourcePath));
+
+    IO::ResourceManager manager;
+    IO::File file(Test01Path);
+    ASSERT_EQ(file.resourceHandle(), Handle);
+    ASSERT_TRUE(manager.resourceExists(Handle));
+    ASSERT_FALSE(manager.resourceExists(IO::MakeResourceHandle(WrongPath)));
+
+    const auto range = manager.queryResource(Handle);
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(range.begin()), range.size()), Test01ContentText);
+    ASSERT_EQ(range.begin(), file.queryResource().begin());
+}
+
+TEST(File, ResourceCache)
+{
+    IO::File lazy(Test01Path, IO::File::Mode::Read);
+    IO::ResourceManager manager;
+    IO::File file(Test01Path, IO::File::Mode::Read);
+
+    // Both the eagerly and lazily resolved files serve the same cached view
+    ASSERT_EQ(file.fileSize(), Test01ContentText.size());
+    ASSERT_EQ(lazy.map().begin(), file.queryResource().begin());
+
+    // Chunked reads
+    std::string content;
+    char buffer[5] {};
+    while (const auto count = file.read(reinterpret_cast<std::uint8_t *>(std::begin(buffer)), reinterpret_cast<std::uint8_t *>(std::end(buffer))))
+        content.append(buffer, count);
+    ASSERT_EQ(content, Test01ContentText);
+
+    // Invalidation
+    file.invalidateResource();
+    ASSERT_TRUE(file.exists());
+    ASSERT_EQ(file.readAll<std::string>(), Test01ContentText);
+}
+
 TEST(File, NonExisting)
 {
 
@@ -76,9 +121,208 @@ TEST(File, Dangerous)
 
     // Queries must crash when resource manager is not initialized
     ASSERT_DEATH(
-        [file] { ASSERT_FALSE(file.resourceExists()); }(), ""
+        [&file] { ASSERT_FALSE(file.resourceExists()); }(), ""
     );
     ASSERT_DEATH(
-        [file] { ASSERT_EQ(file.queryResource().begin(), nullptr); }(), ""
+        [&file] { ASSERT_EQ(file.queryResource().begin(), nullptr); }(), ""
     );
+}
+
+TEST(File, Mapped)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_Mapped.txt").string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << Test01ContentText;
+
+    {
+        IO::File file(path, IO::File::Mode::ReadMapped);
+        ASSERT_FALSE(file.isMapped());
+
+        // Map
+        auto range = file.map();
+        ASSERT_TRUE(file.isMapped());
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(range.begin()), range.size()), Test01ContentText);
+
+        // Remap on growth
+        std::ofstream(path, std::ios::binary | std::ios::app) << Test01ContentText;
+        range = file.map();
+        ASSERT_EQ(range.size(), Test01ContentText.size() * 2);
+        ASSERT_EQ(file.fileSize(), Test01ContentText.size() * 2);
+
+        // Read from mapping
+        std::uint8_t buffer[Test01ContentText.size()] {};
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer), Test01ContentText.size()), Test01ContentText.size());
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(buffer), std::size(buffer)), Test01ContentText);
+
+        // Unmap
+        file.unmap();
+        ASSERT_FALSE(file.isMapped());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(File, MappedResource)
+{
+    IO::ResourceManager manager;
+    IO::File file(Test01Path);
+
+    const auto range = file.map();
+    ASSERT_EQ(range.begin(), file.queryResource().begin());
+    ASSERT_EQ(range.size(), Test01ContentText.size());
+}
+
+TEST(File, AccessHints)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_AccessHints.txt").string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << Test01ContentText;
+    std::uint8_t buffer[Test01ContentText.size()] {};
+
+    {
+        // The pattern is applied once the handle is opened
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        file.advise(IO::File::AccessHint::Random);
+        ASSERT_EQ(file.accessPattern(), IO::File::AccessHint::Random);
+        file.prefetch(0, Test01ContentText.size());
+        file.advise(IO::File::AccessHint::DontNeed, 4);
+        ASSERT_EQ(file.accessPattern(), IO::File::AccessHint::Random);
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer), 0), Test01ContentText.size());
+
+        // Hints past the end of the file or on a missing file are ignored
+        file.prefetch(Test01ContentText.size() * 2, 16);
+        IO::File missing(path + ".missing", IO::File::Mode::ReadBinary);
+        missing.prefetch(0, 16);
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadMapped);
+        file.advise(IO::File::AccessHint::Sequential);
+        const auto range = file.map();
+        file.prefetch(1, 0);
+        file.advise(IO::File::AccessHint::DontNeed);
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(range.begin()), range.size()), Test01ContentText);
+    }
+    {
+        IO::ResourceManager manager;
+        IO::File file(Test01Path, IO::File::Mode::Read);
+        file.prefetch(0, Test01ContentText.size());
+        file.advise(IO::File::AccessHint::DontNeed);
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer), 0), Test01ContentText.size());
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(buffer), std::size(buffer)), Test01ContentText);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(File, ReadWrite)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_ReadWrite.txt").string();
+
+    {
+        IO::File file(path, IO::File::Mode::WriteBinary);
+        ASSERT_TRUE(file.writeAll(Test01ContentText));
+        ASSERT_EQ(file.offset(), Test01ContentText.size());
+        ASSERT_TRUE(file.writeAll(Test01ContentText));
+        ASSERT_EQ(file.fileSize(), Test01ContentText.size() * 2);
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        const auto content = file.readAll<std::string>();
+        ASSERT_EQ(content.size(), Test01ContentText.size() * 2);
+        ASSERT_EQ(std::string_view(content).substr(Test01ContentText.size()), Test01ContentText);
+
+        // Sequential reads
+        std::uint8_t buffer[Test01ContentText.size()] {};
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer), 0), Test01ContentText.size());
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer)), Test01ContentText.size());
+        ASSERT_EQ(file.read(std::begin(buffer), std::end(buffer)), 0);
+        ASSERT_EQ(file.offset(), Test01ContentText.size() * 2);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(File, Vectored)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_Vectored.bin").string();
+    const std::string header = "Header:", payload(100, 'p'), footer = ":Footer";
+    const auto View = [](const std::string &data) {
+        const auto from = reinterpret_cast<const std::uint8_t *>(data.data());
+        return IO::ResourceView { .from = from, .to = from + data.size() };
+    };
+
+    {
+        IO::File file(path, IO::File::Mode::WriteBinary);
+        ASSERT_TRUE(file.writeVectored({ View(header), View(payload), View(footer) }));
+        ASSERT_EQ(file.offset(), header.size() + payload.size() + footer.size());
+        ASSERT_TRUE(file.writeVectored({ View(footer) }, 0));
+
+        // More buffers than a single system call accepts
+        std::vector<IO::ResourceView> pieces(200, View(footer));
+        const auto range = Core::IteratorRange<const IO::ResourceView *> { .from = pieces.data(), .to = pieces.data() + pieces.size() };
+        ASSERT_TRUE(file.writeVectored(range, 1000));
+        ASSERT_EQ(file.fileSize(), 1000 + pieces.size() * footer.size());
+        ASSERT_TRUE(IO::Native::Resize(file.nativeHandle(), header.size() + payload.size() + footer.size()));
+    }
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        std::string first(header.size(), '\0'), second(payload.size() - 1, '\0'), third(footer.size() + 8, '\0');
+        const auto Buffer = [](std::string &data) {
+            const auto from = reinterpret_cast<std::uint8_t *>(data.data());
+            return IO::BufferView { .from = from, .to = from + data.size() };
+        };
+        const IO::BufferView buffers[] { Buffer(first), Buffer(second), Buffer(third) };
+        const auto range = Core::IteratorRange<const IO::BufferView *> { .from = std::begin(buffers), .to = std::end(buffers) };
+
+        // Buffers are filled in order, the last one is only partially filled at end of file
+        ASSERT_EQ(file.readVectored(range, 0), header.size() + payload.size() + footer.size());
+        ASSERT_EQ(first, footer);
+        ASSERT_EQ(second, payload.substr(1));
+        ASSERT_EQ(third.substr(0, footer.size() + 1), 'p' + footer);
+        ASSERT_EQ(file.offset(), header.size() + payload.size() + footer.size());
+        ASSERT_EQ(file.readVectoredAt(range, header.size() + payload.size()), footer.size());
+    }
+    {
+        IO::ResourceManager manager;
+        IO::File file(Test01Path, IO::File::Mode::Read);
+        std::uint8_t first[4] {}, second[64] {};
+        const IO::BufferView buffers[] {
+            IO::BufferView { .from = std::begin(first), .to = std::end(first) },
+            IO::BufferView { .from = std::begin(second), .to = std::end(second) }
+        };
+        ASSERT_EQ(file.readVectored(Core::IteratorRange<const IO::BufferView *> { .from = std::begin(buffers), .to = std::end(buffers) }),
+            Test01ContentText.size());
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(first), std::size(first)), Test01ContentText.substr(0, 4));
+        ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(second), Test01ContentText.size() - 4), Test01ContentText.substr(4));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(File, ConcurrentReadAt)
+{
+    constexpr std::size_t ThreadCount = 4;
+    constexpr std::size_t ChunkCount = 256;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_ConcurrentReadAt.bin").string();
+
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        for (auto i = 0u; i != ThreadCount * ChunkCount; ++i)
+            output << Test01ContentText;
+    }
+    {
+        const IO::File file(path, IO::File::Mode::ReadBinary);
+        std::atomic<std::size_t> matches {};
+        std::thread threads[ThreadCount];
+        for (auto t = 0u; t != ThreadCount; ++t) {
+            threads[t] = std::thread([&file, &matches, t] {
+                std::uint8_t buffer[Test01ContentText.size()] {};
+                for (auto i = 0u; i != ChunkCount; ++i) {
+                    const auto offset = (t * ChunkCount + i) * Test01ContentText.size();
+                    const auto count = file.readAt(std::begin(buffer), std::end(buffer), offset);
+                    matches += count == Test01ContentText.size()
+                        && std::string_view(reinterpret_cast<const char *>(buffer), count) == Test01ContentText;
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        ASSERT_EQ(matches, ThreadCount * ChunkCount);
+        ASSERT_EQ(file.offset(), 0);
+    }
+    std::filesystem::remove(path);
 }
\ No newline at end of file
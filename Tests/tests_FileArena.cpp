@@ -0,0 +1,70 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of FileArena
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/FileArena.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+KF_DECLARE_RESOURCE_ENVIRONMENT(IOTests);
+
+namespace
+{
+    /** @brief Allocator counting its allocations */
+    struct CountingAllocator
+    {
+        static inline std::size_t Allocations {};
+
+        [[nodiscard]] static void *Allocate(const std::size_t size, const std::size_t alignment) noexcept
+            { ++Allocations; return IO::IOAllocator::Allocate(size, alignment); }
+
+        static void Deallocate(void * const data, const std::size_t size, const std::size_t alignment) noexcept
+            { IO::IOAllocator::Deallocate(data, size, alignment); }
+    };
+}
+
+TEST(FileArena, Load)
+{
+    IO::ResourceManager manager;
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_FileArena";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (auto i = 0u; i != 100u; ++i) {
+        paths.push_back((directory / ("Config" + std::to_string(i) + ".txt")).string());
+        std::ofstream(paths.back(), std::ios::binary) << std::string(i, static_cast<char>('a' + i % 26));
+    }
+    paths.push_back(":/IOTests/FileTest01.txt");
+
+    IO::FileArena<CountingAllocator> arena;
+    CountingAllocator::Allocations = 0;
+    ASSERT_TRUE(arena.load(paths, 16u));
+    ASSERT_LE(CountingAllocator::Allocations, 3u); // At most the stat table, the views and the arena, whatever the file count
+    ASSERT_EQ(arena.count(), paths.size());
+    for (auto i = 0u; i != 100u; ++i) {
+        ASSERT_EQ(arena[i].size(), i);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(arena[i].from) % 16u, 0u);
+        ASSERT_TRUE(std::all_of(arena[i].begin(), arena[i].end(), [i](const std::uint8_t c) { return c == 'a' + i % 26; }));
+    }
+    const auto resource = manager.queryResource(Core::Hash("IOTests"), "FileTest01.txt");
+    ASSERT_TRUE(std::equal(resource.begin(), resource.end(), arena[100].begin(), arena[100].end()));
+
+    // Missing files get an empty view
+    paths[3] = (directory / "Missing.txt").string();
+    ASSERT_FALSE(arena.load(paths));
+    ASSERT_TRUE(arena[3].empty());
+    ASSERT_EQ(arena[4].size(), 4u);
+
+    IO::FileArena<CountingAllocator> moved(std::move(arena));
+    ASSERT_EQ(moved.count(), paths.size());
+    ASSERT_EQ(arena.count(), 0u);
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,90 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of HandlePool
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/HandlePool.hpp>
+
+using namespace kF;
+
+TEST(HandlePool, LeaseAndEvict)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_HandlePool";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (auto i = 0u; i != 4u; ++i) {
+        paths.push_back((directory / ("File" + std::to_string(i) + ".txt")).string());
+        std::ofstream(paths.back()) << "File" << i;
+    }
+
+    IO::HandlePool pool(2u);
+    {
+        auto first = pool.acquire(paths[0], false);
+        ASSERT_TRUE(first);
+        auto again = pool.acquire(paths[0], false);
+        ASSERT_EQ(again.handle(), first.handle());
+        ASSERT_FALSE(pool.acquire((directory / "Missing.txt").string(), false));
+
+        // Leased handles are never closed, the pool grows past its capacity
+        auto second = pool.acquire(paths[1], false);
+        auto third = pool.acquire(paths[2], false);
+        ASSERT_EQ(pool.size(), 3u);
+    }
+    ASSERT_EQ(pool.size(), 2u);
+    const auto statistics = pool.statistics();
+    ASSERT_EQ(statistics.hits, 1u);
+    ASSERT_EQ(statistics.misses, 4u);
+    ASSERT_EQ(statistics.failures, 1u);
+    ASSERT_EQ(statistics.evictions, 1u);
+
+    // paths[2] was the only unleased handle when the pool went over its capacity
+    pool.resetStatistics();
+    static_cast<void>(pool.acquire(paths[1], false));
+    static_cast<void>(pool.acquire(paths[2], false));
+    ASSERT_EQ(pool.statistics().hits, 1u);
+    ASSERT_EQ(pool.statistics().misses, 1u);
+
+    pool.invalidate(paths[2]);
+    ASSERT_EQ(pool.size(), 1u);
+    pool.clear();
+    ASSERT_EQ(pool.size(), 0u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(HandlePool, PooledFiles)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_PooledFiles";
+    std::filesystem::create_directories(directory);
+
+    IO::HandlePool pool(4u);
+    std::vector<IO::File> files;
+    for (auto i = 0u; i != 32u; ++i) {
+        files.emplace_back((directory / ("File" + std::to_string(i) + ".txt")).string(), IO::File::Mode::Write, pool);
+        const auto content = "Content" + std::to_string(i);
+        ASSERT_TRUE(files.back().writeAll(content));
+    }
+    ASSERT_EQ(pool.size(), 4u);
+
+    // Write-only files are only truncated on their first access
+    for (auto i = 0u; i != 32u; ++i)
+        ASSERT_TRUE(files[i].writeAll(std::string("!")));
+    for (auto i = 0u; i != 32u; ++i) {
+        IO::File file(files[i].path(), IO::File::Mode::Read, pool);
+        const auto content = file.readAll<std::string>();
+        ASSERT_EQ(content, "Content" + std::to_string(i) + "!");
+    }
+    ASSERT_LE(pool.size(), 4u);
+    ASSERT_GT(pool.statistics().evictions, 0u);
+
+    ASSERT_TRUE(files[0].remove());
+    ASSERT_FALSE(files[0].exists());
+    std::filesystem::remove_all(directory);
+}
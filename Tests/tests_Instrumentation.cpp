@@ -0,0 +1,140 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Instrumentation
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/Instrumentation.hpp>
+
+using namespace kF;
+
+TEST(Instrumentation, Buckets)
+{
+    ASSERT_EQ(IO::Instrumentation::BucketOf(0), 0);
+    ASSERT_EQ(IO::Instrumentation::BucketOf(1), 1);
+    ASSERT_EQ(IO::Instrumentation::BucketOf(1023), 10);
+    ASSERT_EQ(IO::Instrumentation::BucketOf(1024), 11);
+    ASSERT_EQ(IO::Instrumentation::BucketOf(~0ull), IO::Instrumentation::HistogramBucketCount - 1);
+}
+
+TEST(Instrumentation, FileCounters)
+{
+    if constexpr (!IO::Instrumentation::IsEnabled())
+        GTEST_SKIP();
+
+    using Operation = IO::Instrumentation::Operation;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_Instrumentation.txt").string();
+    const auto before = IO::Instrumentation::TakeThreadSnapshot();
+    {
+        IO::File file(path, IO::File::Mode::Write);
+        ASSERT_TRUE(file.writeAll(std::string_view("Instrumented")));
+    }
+    {
+        IO::File file(path, IO::File::Mode::Read);
+        ASSERT_EQ(file.readAll<std::string>(), "Instrumented");
+    }
+    const auto after = IO::Instrumentation::TakeThreadSnapshot();
+    ASSERT_EQ(after[Operation::Open].count - before[Operation::Open].count, 2);
+    ASSERT_EQ(after[Operation::Write].count - before[Operation::Write].count, 1);
+    ASSERT_EQ(after[Operation::Write].bytes - before[Operation::Write].bytes, 12);
+    ASSERT_EQ(after[Operation::Read].bytes - before[Operation::Read].bytes, 12);
+    ASSERT_GT(after.syscalls, before.syscalls);
+
+    std::uint64_t histogramCount {};
+    for (const auto bucket : after[Operation::Read].histogram)
+        histogramCount += bucket;
+    ASSERT_EQ(histogramCount, after[Operation::Read].count);
+    std::filesystem::remove(path);
+}
+
+TEST(Instrumentation, PerFileCounters)
+{
+    if constexpr (!IO::Instrumentation::IsEnabled())
+        GTEST_SKIP();
+
+    using Operation = IO::Instrumentation::Operation;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_InstrumentationFile.txt").string();
+    std::ofstream(path, std::ios::trunc);
+    IO::File file(path, IO::File::Mode::ReadAndWriteBinary);
+    IO::File other(path, IO::File::Mode::ReadBinary);
+    ASSERT_FALSE(file.hasStatistics());
+    ASSERT_TRUE(file.writeAll(std::string_view("Instrumented")));
+    ASSERT_EQ(file.statistics()[Operation::Write].count, 0u);
+
+    // Only the operations made through the file are counted, from any thread
+    file.enableStatistics();
+    ASSERT_TRUE(file.hasStatistics());
+    ASSERT_EQ(file.readAll<std::string>(), "Instrumented");
+    std::thread([&file] {
+        const std::uint8_t data[] { '!' };
+        ASSERT_TRUE(file.write(std::begin(data), std::end(data), 12));
+    }).join();
+    ASSERT_EQ(other.readAll<std::string>(), "Instrumented!");
+    auto stats = file.statistics();
+    ASSERT_EQ(stats[Operation::Read].count, 1u);
+    ASSERT_EQ(stats[Operation::Read].bytes, 12u);
+    ASSERT_EQ(stats[Operation::Write].count, 1u);
+    ASSERT_EQ(stats[Operation::Write].bytes, 1u);
+    ASSERT_EQ(stats[Operation::Read].histogram[IO::Instrumentation::BucketOf(stats[Operation::Read].nanoseconds)], 1u);
+
+    // Statistics follow the file when moved
+    IO::File moved(std::move(file));
+    ASSERT_EQ(moved.statistics()[Operation::Read].count, 1u);
+    moved.resetStatistics();
+    ASSERT_EQ(moved.statistics()[Operation::Read].count, 0u);
+    moved.disableStatistics();
+    ASSERT_FALSE(moved.hasStatistics());
+    std::filesystem::remove(path);
+}
+
+TEST(Instrumentation, RetiredThreads)
+{
+    if constexpr (!IO::Instrumentation::IsEnabled())
+        GTEST_SKIP();
+
+    using Operation = IO::Instrumentation::Operation;
+    const auto before = IO::Instrumentation::TakeSnapshot();
+    std::thread([] {
+        for (auto i = 0u; i != 10u; ++i)
+            IO::Instrumentation::Record(Operation::Read, 100u, 1000u);
+    }).join();
+    const auto after = IO::Instrumentation::TakeSnapshot();
+    ASSERT_EQ(after[Operation::Read].count - before[Operation::Read].count, 10);
+    ASSERT_EQ(after[Operation::Read].bytes - before[Operation::Read].bytes, 1000);
+    ASSERT_EQ(after[Operation::Read].nanoseconds - before[Operation::Read].nanoseconds, 10000);
+}
+
+TEST(Instrumentation, Trace)
+{
+    if constexpr (!IO::Instrumentation::IsEnabled())
+        GTEST_SKIP();
+
+    using Operation = IO::Instrumentation::Operation;
+    std::size_t writtenBytes {};
+    IO::Instrumentation::SetTraceCallback([](const IO::Instrumentation::Event &event, void * const userData) noexcept {
+        if (event.operation == Operation::Write)
+            *reinterpret_cast<std::size_t *>(userData) += event.bytes;
+    }, &writtenBytes);
+    IO::Instrumentation::Record(Operation::Write, 42u, 10u, "Traced");
+    IO::Instrumentation::Record(Operation::Read, 24u, 10u, "Traced");
+    IO::Instrumentation::SetTraceCallback(nullptr);
+    IO::Instrumentation::Record(Operation::Write, 42u, 10u, "Traced");
+    ASSERT_EQ(writtenBytes, 42);
+}
+
+TEST(Instrumentation, Percentile)
+{
+    IO::Instrumentation::OperationStats stats;
+    stats.count = 100;
+    stats.histogram[IO::Instrumentation::BucketOf(100)] = 90;
+    stats.histogram[IO::Instrumentation::BucketOf(100000)] = 10;
+    ASSERT_EQ(stats.percentile(0.5), 128);
+    ASSERT_EQ(stats.percentile(0.99), 131072);
+}
@@ -0,0 +1,112 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Loader
+ */
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Loader.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+KF_DECLARE_RESOURCE_ENVIRONMENT(IOTests);
+
+TEST(Loader, Load)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_Loader.bin").string();
+    const std::string content(300000, 'L');
+    std::ofstream(path, std::ios::binary) << content;
+
+    IO::ResourceManager manager;
+    IO::Loader loader(2u, 4096u);
+    ASSERT_EQ(loader.threadCount(), 2u);
+
+    auto disk = loader.load(IO::LoadRequest { .path = path });
+    auto resource = loader.load(IO::LoadRequest { .path = ":/IOTests/FileTest01.txt" });
+    auto missing = loader.load(IO::LoadRequest { .path = "IOTests_LoaderMissing.bin" });
+    ASSERT_EQ(disk.wait(), IO::LoadStatus::Completed);
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(disk.data().from), disk.data().size()), content);
+    ASSERT_EQ(resource.wait(), IO::LoadStatus::Completed);
+    const auto expected = manager.queryResource(Core::Hash("IOTests"), "FileTest01.txt");
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), resource.data().begin(), resource.data().end()));
+    ASSERT_EQ(missing.wait(), IO::LoadStatus::Failed);
+    ASSERT_FALSE(loader.cancel(disk));
+
+    // Custom destination allocator
+    std::vector<std::uint8_t> destination;
+    auto custom = loader.load(IO::LoadRequest {
+        .path = path,
+        .allocator = [](const std::size_t size, void * const userData) noexcept {
+            auto &vector = *reinterpret_cast<std::vector<std::uint8_t> *>(userData);
+            vector.resize(size);
+            return vector.data();
+        },
+        .userData = &destination
+    });
+    ASSERT_EQ(custom.wait(), IO::LoadStatus::Completed);
+    ASSERT_EQ(custom.data().from, destination.data());
+    ASSERT_EQ(destination.size(), content.size());
+    std::filesystem::remove(path);
+}
+
+TEST(Loader, PriorityAndCancellation)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_LoaderPriority.bin").string();
+    std::ofstream(path, std::ios::binary) << "Priority";
+
+    struct Context
+    {
+        std::atomic<bool> release {};
+        std::mutex mutex {};
+        std::vector<int> order {};
+    } context;
+    struct Tag
+    {
+        Context *context {};
+        int id {};
+    };
+    const auto record = [](const IO::LoadFuture &, void * const userData) noexcept {
+        auto &tag = *reinterpret_cast<Tag *>(userData);
+        // The first request blocks the single I/O thread until every other request is queued
+        while (tag.id < 0 && !tag.context->release.load())
+            std::this_thread::yield();
+        std::lock_guard<std::mutex> guard(tag.context->mutex);
+        tag.context->order.push_back(tag.id);
+    };
+
+    IO::Loader loader(1u);
+    Tag tags[6] { { &context, -1 }, { &context, 0 }, { &context, 1 }, { &context, 2 }, { &context, 3 }, { &context, 100 } };
+    auto blocker = loader.load(IO::LoadRequest { .path = path, .callback = record, .userData = &tags[0] });
+    while (blocker.status() == IO::LoadStatus::Queued)
+        std::this_thread::yield();
+
+    std::vector<IO::LoadFuture> futures;
+    for (auto priority = 0; priority != 4; ++priority)
+        futures.push_back(loader.load(IO::LoadRequest { .path = path, .priority = priority, .callback = record, .userData = &tags[priority + 1] }));
+    auto cancelled = loader.load(IO::LoadRequest { .path = path, .priority = 100, .callback = record, .userData = &tags[5] });
+    ASSERT_EQ(loader.queuedCount(), 5u);
+    ASSERT_TRUE(loader.cancel(cancelled));
+    ASSERT_EQ(cancelled.status(), IO::LoadStatus::Cancelled);
+    ASSERT_FALSE(loader.reprioritize(cancelled, 0));
+    ASSERT_TRUE(loader.reprioritize(futures[0], 10));
+    ASSERT_EQ(loader.queuedCount(), 4u);
+    ASSERT_EQ(futures[0].status(), IO::LoadStatus::Queued);
+
+    context.release = true;
+
+    for (auto &future : futures)
+        ASSERT_EQ(future.wait(), IO::LoadStatus::Completed);
+    ASSERT_EQ(blocker.wait(), IO::LoadStatus::Completed);
+    std::lock_guard<std::mutex> guard(context.mutex);
+    ASSERT_EQ(context.order, (std::vector<int> { 100, -1, 0, 3, 2, 1 }));
+    std::filesystem::remove(path);
+}
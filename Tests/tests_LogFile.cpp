@@ -0,0 +1,137 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of LogFile
+ */
+
+#include <filesystem>
+#include <string>
+
+#if defined(__linux__)
+# include <csignal>
+# include <sys/resource.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/LogFile.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Remove a log and its rotated copies */
+    void RemoveLogs(const std::string &path) noexcept
+    {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        for (auto i = 1u; i != 4u; ++i)
+            std::filesystem::remove(path + '.' + std::to_string(i), error);
+    }
+
+    [[nodiscard]] std::string ReadText(const std::string &path) noexcept
+    {
+        IO::File file(path, IO::File::Mode::Read);
+        std::string text;
+        static_cast<void>(file.readAll(text));
+        return text;
+    }
+}
+
+TEST(LogFile, AppendAndReopen)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_LogFile.log").string();
+    RemoveLogs(path);
+    {
+        IO::LogFile log(path, 4096);
+        ASSERT_EQ(log.size(), 0);
+        ASSERT_TRUE(log.appendAll(std::string_view("first\n")));
+        const std::string_view header("second "), body("record\n");
+        ASSERT_TRUE(log.append({
+            IO::ResourceView { reinterpret_cast<const std::uint8_t *>(header.data()), reinterpret_cast<const std::uint8_t *>(header.data() + header.size()) },
+            IO::ResourceView { reinterpret_cast<const std::uint8_t *>(body.data()), reinterpret_cast<const std::uint8_t *>(body.data() + body.size()) }
+        }));
+        ASSERT_EQ(log.size(), 20);
+        ASSERT_GE(log.reservedSize(), 4096);
+        ASSERT_TRUE(log.sync());
+        // The reservation never shows in the file size
+        ASSERT_EQ(std::filesystem::file_size(path), 20);
+    }
+    ASSERT_EQ(ReadText(path), "first\nsecond record\n");
+
+    // Reopening continues after the existing content
+    {
+        IO::LogFile log(path, 4096);
+        ASSERT_EQ(log.size(), 20);
+        ASSERT_TRUE(log.appendAll(std::string_view("third\n")));
+    }
+    ASSERT_EQ(ReadText(path), "first\nsecond record\nthird\n");
+    RemoveLogs(path);
+}
+
+TEST(LogFile, Rotation)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_LogFileRotation.log").string();
+    RemoveLogs(path);
+    {
+        IO::LogFile log(path, 4096, 16);
+        ASSERT_TRUE(log.appendAll(std::string_view("0123456789\n")));
+        ASSERT_TRUE(log.appendAll(std::string_view("abcd\n")));
+        ASSERT_EQ(log.rotationIndex(), 0);
+        // A record is never split, the log rotates before exceeding its threshold
+        ASSERT_TRUE(log.appendAll(std::string_view("efgh\n")));
+        ASSERT_EQ(log.rotationIndex(), 1);
+        ASSERT_EQ(log.size(), 5);
+        // Records larger than the threshold still go to their own log
+        ASSERT_TRUE(log.appendAll(std::string_view("a record larger than the threshold\n")));
+        ASSERT_EQ(log.rotationIndex(), 2);
+    }
+    ASSERT_EQ(ReadText(path + ".1"), "0123456789\nabcd\n");
+    ASSERT_EQ(ReadText(path + ".2"), "efgh\n");
+    ASSERT_EQ(ReadText(path), "a record larger than the threshold\n");
+    ASSERT_EQ(std::filesystem::file_size(path + ".1"), 16);
+    RemoveLogs(path);
+}
+
+TEST(LogFile, AppendModeIgnoresOffset)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_LogFileAppend.log").string();
+    RemoveLogs(path);
+    {
+        IO::File file(path, IO::File::Mode::Append);
+        ASSERT_TRUE(file.writeAll(std::string_view("abc")));
+        const std::string_view text("def");
+        ASSERT_TRUE(file.write(reinterpret_cast<const std::uint8_t *>(text.data()), reinterpret_cast<const std::uint8_t *>(text.data() + text.size()), 0));
+        ASSERT_EQ(file.offset(), 6);
+    }
+    ASSERT_EQ(ReadText(path), "abcdef");
+    RemoveLogs(path);
+}
+
+#if defined(__linux__)
+TEST(LogFile, ShortAppend)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_LogFileShort.log").string();
+    RemoveLogs(path);
+    {
+        IO::LogFile log(path, 0);
+        ASSERT_TRUE(log.appendAll(std::string_view("first\n")));
+
+        // Limit the file size so the next append is cut short
+        const auto handler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit previous {};
+        ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &previous), 0);
+        rlimit limit = previous;
+        limit.rlim_cur = 10;
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+        const auto success = log.appendAll(std::string_view("second record\n"));
+        ::setrlimit(RLIMIT_FSIZE, &previous);
+        std::signal(SIGXFSZ, handler);
+
+        // Only the bytes actually written are counted
+        ASSERT_FALSE(success);
+        ASSERT_EQ(log.size(), 10);
+        ASSERT_EQ(std::filesystem::file_size(path), 10);
+    }
+    RemoveLogs(path);
+}
+#endif
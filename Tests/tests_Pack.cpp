@@ -0,0 +1,238 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Pack
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Directory.hpp>
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/Pack.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Search two resource names sharing a path hash */
+    std::pair<std::string, std::string> FindCollidingNames(void)
+    {
+        std::unordered_map<Core::HashedName, std::string> names;
+        for (auto i = 0u; ; ++i) {
+            auto name = "Directory/Resource" + std::to_string(i);
+            const auto [it, inserted] = names.try_emplace(Core::Hash(name), name);
+            if (!inserted)
+                return std::make_pair(it->second, std::move(name));
+        }
+    }
+
+    IO::ResourceView ToView(const std::string &data)
+    {
+        const auto from = reinterpret_cast<const std::uint8_t *>(data.data());
+        return IO::ResourceView { .from = from, .to = from + data.size() };
+    }
+
+    std::string_view ToText(const IO::ResourceData &data)
+        { return std::string_view(reinterpret_cast<const char *>(data.data()), data.size()); }
+}
+
+TEST(Pack, BuildAndMount)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "IOTests_PackSource";
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_Pack.kfp").string();
+    const std::string large(100000, 'K');
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "Textures" / "Environment");
+    std::ofstream(directory / "Config.txt") << "Config";
+    std::ofstream(directory / "Textures" / "Large.bin") << large;
+    std::ofstream(directory / "Textures" / "Environment" / "Sky.txt") << "Sky";
+
+    ASSERT_TRUE(IO::Pack::BuildFromDirectory(directory.string(), packPath, true));
+
+    IO::ResourceManager manager;
+    constexpr auto Environment = Core::Hash("Pack");
+    ASSERT_FALSE(manager.mountPack(Environment, directory.string() + "/Config.txt"));
+    ASSERT_TRUE(manager.mountPack(Environment, packPath));
+    ASSERT_TRUE(manager.environmentExists(Environment));
+    ASSERT_TRUE(manager.isPack(Environment));
+
+    {
+        IO::File file(":/Pack/Config.txt", IO::File::Mode::Read);
+        ASSERT_TRUE(file.exists());
+        ASSERT_EQ(file.readAll<std::string>(), "Config");
+        IO::File compressed(":/Pack/Textures/Large.bin", IO::File::Mode::Read);
+        ASSERT_TRUE(manager.isCompressed(compressed.resourceHandle()));
+        ASSERT_EQ(compressed.fileSize(), large.size());
+        ASSERT_EQ(compressed.readAll<std::string>(), large);
+        ASSERT_EQ(IO::File(":/Pack/Textures/Environment/Sky.txt", IO::File::Mode::Read).readAll<std::string>(), "Sky");
+        ASSERT_FALSE(IO::File(":/Pack/Missing.txt").exists());
+        ASSERT_TRUE(IO::File(":/Pack/Textures").exists());
+    }
+
+    IO::DirectoryListing listing;
+    ASSERT_TRUE(IO::ListDirectory(":/Pack/Textures", listing));
+    listing.sort();
+    ASSERT_EQ(listing.size(), 2);
+    ASSERT_EQ(listing[0].path, ":/Pack/Textures/Environment");
+    ASSERT_EQ(listing[0].type, IO::EntryType::Directory);
+    ASSERT_EQ(listing[1].path, ":/Pack/Textures/Large.bin");
+    listing.clear();
+    ASSERT_TRUE(IO::WalkDirectory(":/Pack", listing));
+    ASSERT_EQ(listing.size(), 5);
+    ASSERT_FALSE(IO::ListDirectory(":/Pack/Missing", listing));
+
+    ASSERT_TRUE(manager.unmountPack(Environment));
+    ASSERT_FALSE(manager.environmentExists(Environment));
+    ASSERT_FALSE(manager.unmountPack(Environment));
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove(packPath);
+}
+
+TEST(Pack, Builder)
+{
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_PackBuilder.kfp").string();
+    const std::string_view content = "Content";
+    const IO::ResourceView view {
+        .from = reinterpret_cast<const std::uint8_t *>(content.data()),
+        .to = reinterpret_cast<const std::uint8_t *>(content.data() + content.size())
+    };
+    IO::Pack::Builder builder(4096);
+    for (auto i = 0u; i != 100u; ++i)
+        builder.add("Resource" + std::to_string(i), view);
+    ASSERT_EQ(builder.count(), 100);
+    ASSERT_TRUE(builder.write(packPath));
+
+    {
+        IO::File file(packPath, IO::File::Mode::ReadMapped);
+        const auto pack = file.map();
+        const auto header = IO::Pack::Validate(pack);
+        ASSERT_NE(header, nullptr);
+        ASSERT_EQ(header->entryCount, 100);
+        for (auto i = 0u; i != 100u; ++i) {
+            const auto name = "Resource" + std::to_string(i);
+            const std::string_view path(name);
+            const auto entry = IO::Pack::Find(pack, Core::Hash(path), &path);
+            ASSERT_EQ(IO::Pack::Find(pack, Core::Hash(path), nullptr), entry);
+            ASSERT_NE(entry, nullptr);
+            ASSERT_EQ(entry->offset % 4096, 0);
+            ASSERT_EQ(IO::Pack::GetName(pack, *entry), "Resource" + std::to_string(i));
+            const auto data = IO::Pack::GetData(pack, *entry);
+            ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(data.from), data.size()), content);
+        }
+        ASSERT_EQ(IO::Pack::Find(pack, Core::Hash("Missing"), nullptr), nullptr);
+    }
+
+    // Duplicated paths can't be written
+    builder.add("Resource0", view);
+    ASSERT_FALSE(builder.write(packPath));
+    std::filesystem::remove(packPath);
+}
+
+TEST(Pack, OverflowingOffsets)
+{
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_PackOverflow.kfp").string();
+    const std::string content = "Content";
+    IO::Pack::Builder builder;
+    builder.add("Resource", ToView(content));
+    ASSERT_TRUE(builder.write(packPath));
+    std::vector<std::uint8_t> bytes(std::filesystem::file_size(packPath));
+    std::ifstream(packPath, std::ios::binary).read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    std::filesystem::remove(packPath);
+    const IO::ResourceView pack { .from = bytes.data(), .to = bytes.data() + bytes.size() };
+    const auto header = const_cast<IO::Pack::Header *>(IO::Pack::Validate(pack));
+    ASSERT_NE(header, nullptr);
+    const std::string_view path("Resource");
+    const auto entry = const_cast<IO::Pack::Entry *>(IO::Pack::Find(pack, Core::Hash(path), &path));
+    ASSERT_NE(entry, nullptr);
+
+    // Offsets wrapping around once added to their size are out of bounds
+    const auto offset = entry->offset;
+    entry->offset = ~std::uint64_t {} - 1u;
+    ASSERT_EQ(IO::Pack::Find(pack, Core::Hash(path), &path), nullptr);
+    entry->offset = offset;
+    entry->size = ~std::uint64_t {};
+    ASSERT_EQ(IO::Pack::Find(pack, Core::Hash(path), &path), nullptr);
+    header->namesOffset = ~std::uint64_t {} - 1u;
+    ASSERT_EQ(IO::Pack::Validate(pack), nullptr);
+}
+
+TEST(Pack, CollisionsAndDirectories)
+{
+    const auto [first, second] = FindCollidingNames();
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_PackCollisions.kfp").string();
+    IO::Pack::Builder builder;
+    builder.add(first, ToView(first));
+    builder.add(second, ToView(second));
+    builder.add("Directory/Nested/Sky.txt", ToView(first));
+    ASSERT_TRUE(builder.write(packPath));
+
+    {
+        IO::ResourceManager manager;
+        constexpr auto Environment = Core::Hash("Pack");
+        ASSERT_TRUE(manager.mountPack(Environment, packPath));
+
+        // Colliding resources are told apart by path, their shared handle alone is rejected
+        ASSERT_EQ(ToText(manager.queryResource(Environment, first)), first);
+        ASSERT_EQ(ToText(manager.queryResource(Environment, second)), second);
+        ASSERT_EQ(IO::File(":/Pack/" + second, IO::File::Mode::Read).readAll<std::string>(), second);
+        ASSERT_FALSE(manager.resourceExists(IO::MakeResourceHandle(":/Pack/" + first)));
+
+        // Directories are found without being resources
+        ASSERT_TRUE(manager.resourceExists(Environment, "Directory"));
+        ASSERT_TRUE(manager.resourceExists(Environment, "Directory/Nested"));
+        ASSERT_TRUE(manager.resourceExists(Environment, "Directory/Nested/Sky.txt"));
+        ASSERT_FALSE(manager.resourceExists(Environment, "Direct"));
+        ASSERT_FALSE(manager.resourceExists(Environment, "Directory/Missing"));
+        ASSERT_FALSE(manager.resourceExists(IO::MakeResourceHandle(":/Pack/Directory")));
+        ASSERT_TRUE(manager.queryResource(Environment, "Directory").empty());
+
+        IO::DirectoryListing listing;
+        ASSERT_TRUE(IO::WalkDirectory(":/Pack", listing));
+        ASSERT_EQ(listing.size(), 5);
+        ASSERT_TRUE(manager.unmountPack(Environment));
+    }
+
+    // A resource can't also be a directory
+    builder.add("Directory", ToView(first));
+    ASSERT_FALSE(builder.write(packPath));
+    std::filesystem::remove(packPath);
+}
+
+TEST(Pack, CompressedCollisions)
+{
+    const auto [first, second] = FindCollidingNames();
+    const std::string firstData(4096, 'A');
+    const std::string secondData(4096, 'B');
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_PackCompressedCollisions.kfp").string();
+    IO::Pack::Builder builder;
+    builder.add(first, ToView(firstData), true);
+    builder.add(second, ToView(secondData), true);
+    ASSERT_TRUE(builder.write(packPath));
+
+    {
+        IO::ResourceManager manager;
+        constexpr auto Environment = Core::Hash("Pack");
+        ASSERT_TRUE(manager.mountPack(Environment, packPath));
+        const IO::ResourceHandle handle { .environment = Environment, .path = Core::Hash(first) };
+        ASSERT_TRUE(manager.isCompressed(handle, first));
+        ASSERT_TRUE(manager.isCompressed(handle, second));
+
+        // Colliding resources have their own decompressed content
+        ASSERT_EQ(ToText(manager.queryResource(Environment, first)), firstData);
+        ASSERT_EQ(ToText(manager.queryResource(Environment, second)), secondData);
+        char byte {};
+        const auto data = reinterpret_cast<std::uint8_t *>(&byte);
+        ASSERT_EQ(manager.readResource(handle, second, data, data + 1, 10u), 1u);
+        ASSERT_EQ(byte, 'B');
+        ASSERT_EQ(manager.readResource(handle, first, data, data + 1, 10u), 1u);
+        ASSERT_EQ(byte, 'A');
+        ASSERT_TRUE(manager.unmountPack(Environment));
+    }
+    std::filesystem::remove(packPath);
+}
@@ -0,0 +1,79 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Path
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/Path.hpp>
+
+using namespace kF;
+
+TEST(Path, Components)
+{
+    const IO::Path path("/home/user/assets/textures/environment/skybox.front.png");
+    ASSERT_EQ(path.filenameWithExtension(), "skybox.front.png");
+    ASSERT_EQ(path.filename(), "skybox.front");
+    ASSERT_EQ(path.extension(), ".png");
+    ASSERT_EQ(path.directoryPath(), "/home/user/assets/textures/environment");
+    ASSERT_FALSE(path.isResource());
+
+    const IO::Path windows("C:\\Users\\user\\AppData\\Local\\kube\\settings");
+    ASSERT_EQ(windows.filename(), "settings");
+    ASSERT_EQ(windows.extension(), "");
+    ASSERT_EQ(windows.directoryPath(), "C:\\Users\\user\\AppData\\Local\\kube");
+
+    // The scan must handle dots found in a block preceding the separator block
+    const IO::Path longName("/a/" + std::string(40, 'x') + ".extension");
+    ASSERT_EQ(longName.extension(), ".extension");
+    ASSERT_EQ(longName.filename(), std::string(40, 'x'));
+    const IO::Path dotInDirectory("/directory.with.dots/" + std::string(40, 'x'));
+    ASSERT_EQ(dotInDirectory.extension(), "");
+    ASSERT_EQ(dotInDirectory.directoryPath(), "/directory.with.dots");
+
+    ASSERT_EQ(IO::Path(".hidden").extension(), "");
+    ASSERT_EQ(IO::Path(".hidden").filename(), ".hidden");
+    ASSERT_EQ(IO::Path("..").extension(), "");
+    ASSERT_EQ(IO::Path("file").directoryPath(), "");
+    ASSERT_EQ(IO::Path("/file").directoryPath(), "/");
+    ASSERT_EQ(IO::Path().filename(), "");
+}
+
+TEST(Path, Resource)
+{
+    const IO::Path path(":/Environment/Directory/Resource.bin");
+    ASSERT_TRUE(path.isResource());
+    ASSERT_EQ(path.environment(), "Environment");
+    ASSERT_EQ(path.resourcePath(), "Directory/Resource.bin");
+    ASSERT_EQ(path.filename(), "Resource");
+
+    const IO::Path environment(":/Environment");
+    ASSERT_EQ(environment.environment(), "Environment");
+    ASSERT_EQ(environment.resourcePath(), "");
+}
+
+TEST(Path, Normalize)
+{
+    ASSERT_EQ(IO::Path::Normalize("/a//b/./c/../d/"), "/a/b/d");
+    ASSERT_EQ(IO::Path::Normalize("a\\b\\..\\c"), "a/c");
+    ASSERT_EQ(IO::Path::Normalize("../../a/.."), "../..");
+    ASSERT_EQ(IO::Path::Normalize("/../a"), "/a");
+    ASSERT_EQ(IO::Path::Normalize("a/.."), ".");
+    ASSERT_EQ(IO::Path::Normalize(""), ".");
+    ASSERT_EQ(IO::Path::Normalize(":/Environment/a/../../b"), ":/Environment/b");
+    ASSERT_EQ(IO::Path::Normalize("/" + std::string(300, 'x') + "/../y"), "/y");
+    ASSERT_EQ(IO::Path("x/./y//z.txt").normalized().extension(), ".txt");
+}
+
+TEST(Path, Join)
+{
+    const IO::Path root("/assets");
+    ASSERT_EQ(root / "textures/skybox.png", "/assets/textures/skybox.png");
+    ASSERT_EQ((root / "textures/skybox.png").filename(), "skybox");
+    ASSERT_EQ(IO::Path("/assets/") / "file", "/assets/file");
+    ASSERT_EQ(root / "/absolute", "/absolute");
+    ASSERT_EQ(root / ":/Environment/file", ":/Environment/file");
+    ASSERT_EQ(root / "", "/assets");
+    ASSERT_EQ(IO::Path() / "file", "file");
+    ASSERT_EQ((root / std::string(300, 'x')).size(), 308);
+}
@@ -0,0 +1,244 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of ResourceManager
+ */
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/File.hpp>
+#include <Kube/IO/Pack.hpp>
+#include <Kube/IO/ResourceManager.hpp>
+
+using namespace kF;
+
+KF_DECLARE_RESOURCE_ENVIRONMENT(IOTests);
+
+namespace
+{
+    /** @brief Name of the test environment registered as compressed */
+    constexpr auto CompressedEnvironment = Core::Hash("IOTestsCompressed");
+
+    /** @brief Uncompressed content of 'FileTest02.kfz' */
+    [[nodiscard]] std::string CompressedContent(void) noexcept
+    {
+        std::string text;
+        for (auto i = 0u; i != 10000u; ++i)
+            text += "Compressed resource line " + std::to_string(i) + '\n';
+        return text;
+    }
+
+    [[nodiscard]] std::string_view ToText(const IO::ResourceData &data) noexcept
+        { return std::string_view(reinterpret_cast<const char *>(data.data()), data.size()); }
+}
+
+TEST(ResourceManager, RegisterAtRuntime)
+{
+    IO::ResourceManager manager;
+    constexpr auto Runtime = Core::Hash("Runtime");
+    const auto handle = IO::ResourceHandle { .environment = Runtime, .path = Core::Hash("FileTest01.txt") };
+
+    ASSERT_TRUE(manager.environmentExists(Core::Hash("IOTests")));
+    ASSERT_FALSE(manager.environmentExists(Runtime));
+    manager.registerEnvironment(Runtime, cmrc::IOTests::get_filesystem());
+    ASSERT_TRUE(manager.environmentExists(Runtime));
+    ASSERT_TRUE(manager.resourceExists(handle));
+    ASSERT_EQ(manager.queryResource(handle).size(), manager.queryResource(Core::Hash("IOTests"), "FileTest01.txt").size());
+
+    ASSERT_TRUE(manager.unregisterEnvironment(Runtime));
+    ASSERT_FALSE(manager.unregisterEnvironment(Runtime));
+    ASSERT_FALSE(manager.environmentExists(Runtime));
+    ASSERT_FALSE(manager.resourceExists(handle));
+    ASSERT_TRUE(manager.resourceExists(Core::Hash("IOTests"), "FileTest01.txt"));
+}
+
+TEST(ResourceManager, ConcurrentQueries)
+{
+    const auto packPath = (std::filesystem::temp_directory_path() / "IOTests_ConcurrentPack.kfp").string();
+    const std::uint8_t data[] { 1, 2, 3, 4 };
+    const std::vector<std::uint8_t> large(16 * 1024 * 1024, 'K');
+    IO::Pack::Builder builder;
+    builder.add("Data.bin", IO::ResourceView { .from = std::begin(data), .to = std::end(data) });
+    builder.add("Large.bin", IO::ResourceView { .from = large.data(), .to = large.data() + large.size() });
+    ASSERT_TRUE(builder.write(packPath));
+
+    IO::ResourceManager manager;
+    constexpr auto Runtime = Core::Hash("Runtime");
+    constexpr auto Pack = Core::Hash("Pack");
+    const auto embedded = IO::ResourceHandle { .environment = Core::Hash("IOTests"), .path = Core::Hash("FileTest01.txt") };
+    const auto expected = manager.queryResource(embedded);
+    ASSERT_FALSE(expected.empty());
+
+    std::atomic<bool> stop {};
+    std::atomic<std::size_t> failures {};
+    std::vector<std::thread> readers;
+    for (auto i = 0u; i != 4u; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Embedded resources must stay visible while other environments come and go
+                if (manager.queryResource(embedded).data() != expected.data())
+                    ++failures;
+                // Pack resources are either visible or not, an unmounted pack must never be probed
+                static_cast<void>(manager.resourceExists(IO::ResourceHandle { .environment = Pack, .path = Core::Hash("Data.bin") }));
+                static_cast<void>(manager.environmentExists(Runtime));
+            }
+        });
+    }
+
+    // Pack content is read while the pack gets unmounted, its mapping must outlive the read
+    std::vector<std::uint8_t> output(large.size());
+    std::atomic<std::uint32_t> requested {};
+    std::atomic<std::uint32_t> completed {};
+    std::thread packReader([&] {
+        const IO::ResourceHandle handle { .environment = Pack, .path = Core::Hash("Large.bin") };
+        for (auto request = 1u; request <= 50u; ++request) {
+            while (requested.load(std::memory_order_acquire) != request)
+                std::this_thread::yield();
+            if (manager.readResource(handle, output.data(), output.data() + output.size(), 0u) != large.size() || output != large)
+                ++failures;
+            completed.store(request, std::memory_order_release);
+        }
+    });
+
+    for (auto i = 0u; i != 200u; ++i) {
+        manager.registerEnvironment(Runtime, cmrc::IOTests::get_filesystem());
+        ASSERT_TRUE(manager.mountPack(Pack, packPath));
+        if (const auto request = i / 4u + 1u; !(i % 4u)) {
+            // Unmount once a quarter of the resource is copied
+            std::atomic_ref progress(output[output.size() / 4u]);
+            progress.store(0u, std::memory_order_relaxed);
+            requested.store(request, std::memory_order_release);
+            while (!progress.load(std::memory_order_relaxed) && completed.load(std::memory_order_acquire) != request)
+                std::this_thread::yield();
+            ASSERT_TRUE(manager.unmountPack(Pack));
+            while (completed.load(std::memory_order_acquire) != request)
+                std::this_thread::yield();
+        } else
+            ASSERT_TRUE(manager.unmountPack(Pack));
+        ASSERT_TRUE(manager.unregisterEnvironment(Runtime));
+    }
+    stop = true;
+    packReader.join();
+    for (auto &reader : readers)
+        reader.join();
+    ASSERT_EQ(failures.load(), 0u);
+    std::filesystem::remove(packPath);
+}
+
+TEST(ResourceManager, ConcurrentQueriesAndEvictions)
+{
+    IO::ResourceManager manager;
+    manager.registerEnvironment(CompressedEnvironment, cmrc::IOTests::get_filesystem(), true);
+    const auto expected = CompressedContent();
+    const auto handle = IO::ResourceHandle { .environment = CompressedEnvironment, .path = Core::Hash("FileTest02.kfz") };
+
+    std::atomic<bool> stop {};
+    std::atomic<std::size_t> failures {};
+    std::vector<std::thread> readers;
+    for (auto i = 0u; i != 4u; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Queried content must stay intact while the cache evicts it
+                const auto data = manager.queryResource(handle);
+                std::this_thread::yield();
+                if (ToText(data) != expected)
+                    ++failures;
+            }
+        });
+    }
+    for (auto i = 0u; i != 200u; ++i) {
+        manager.setDecompressionCacheBudget(0u);
+        manager.setDecompressionCacheBudget(IO::ResourceManager::DefaultDecompressionCacheBudget);
+        manager.clearDecompressionCache();
+        std::this_thread::yield();
+    }
+    stop = true;
+    for (auto &reader : readers)
+        reader.join();
+    ASSERT_EQ(failures.load(), 0u);
+}
+
+TEST(ResourceManager, CompressedEnvironment)
+{
+    // Same registration as 'KF_DECLARE_COMPRESSED_RESOURCE_ENVIRONMENT', made at runtime to reuse the test resources
+    IO::ResourceManager manager;
+    manager.registerEnvironment(CompressedEnvironment, cmrc::IOTests::get_filesystem(), true);
+    const auto expected = CompressedContent();
+    const auto handle = IO::ResourceHandle { .environment = CompressedEnvironment, .path = Core::Hash("FileTest02.kfz") };
+    const auto raw = IO::ResourceHandle { .environment = Core::Hash("IOTests"), .path = Core::Hash("FileTest02.kfz") };
+
+    ASSERT_TRUE(manager.isCompressed(handle));
+    ASSERT_FALSE(manager.isCompressed(raw));
+    ASSERT_LT(manager.resourceSize(raw), expected.size());
+    ASSERT_EQ(manager.resourceSize(handle), expected.size());
+    ASSERT_FALSE(manager.isCompressed(IO::ResourceHandle { .environment = CompressedEnvironment, .path = Core::Hash("FileTest01.txt") }));
+    ASSERT_EQ(ToText(manager.queryResource(CompressedEnvironment, "FileTest01.txt")), "Kube Framework !");
+
+    // Ranges decode only the blocks they cover, including across a block boundary and at the end of the resource
+    ASSERT_EQ(manager.decompressionCacheSize(), 0u);
+    std::string range(100, '\0');
+    const auto read = [&](const std::size_t offset) {
+        return manager.readResource(handle, reinterpret_cast<std::uint8_t *>(range.data()),
+            reinterpret_cast<std::uint8_t *>(range.data() + range.size()), offset);
+    };
+    ASSERT_EQ(read(64 * 1024 - 50), 100u);
+    ASSERT_EQ(range, expected.substr(64 * 1024 - 50, 100));
+    ASSERT_EQ(read(expected.size() - 30), 30u);
+    ASSERT_EQ(range.substr(0, 30), expected.substr(expected.size() - 30));
+    ASSERT_EQ(read(expected.size()), 0u);
+    ASSERT_EQ(manager.decompressionCacheSize(), 0u);
+
+    // Queries share the decompressed content, it outlives evictions and the environment itself
+    const auto data = manager.queryResource(handle);
+    ASSERT_EQ(ToText(data), expected);
+    ASSERT_EQ(manager.decompressionCacheSize(), expected.size());
+    ASSERT_EQ(manager.queryResource(handle).data(), data.data());
+    ASSERT_EQ(read(1000), 100u);
+    ASSERT_EQ(range, expected.substr(1000, 100));
+    manager.setDecompressionCacheBudget(expected.size() - 1);
+    ASSERT_EQ(manager.decompressionCacheSize(), 0u);
+    ASSERT_EQ(ToText(data), expected);
+    manager.setDecompressionCacheBudget(IO::ResourceManager::DefaultDecompressionCacheBudget);
+    const auto reloaded = manager.queryResource(handle);
+    ASSERT_NE(reloaded.data(), data.data());
+    ASSERT_TRUE(manager.unregisterEnvironment(CompressedEnvironment));
+    ASSERT_EQ(manager.decompressionCacheSize(), 0u);
+    ASSERT_EQ(ToText(data), expected);
+    ASSERT_EQ(ToText(reloaded), expected);
+}
+
+TEST(ResourceManager, CompressedFile)
+{
+    IO::ResourceManager manager;
+    manager.registerEnvironment(CompressedEnvironment, cmrc::IOTests::get_filesystem(), true);
+    const auto expected = CompressedContent();
+
+    IO::File file(":/IOTestsCompressed/FileTest02.kfz", IO::File::Mode::Read);
+    ASSERT_EQ(file.fileSize(), expected.size());
+    std::string range(100, '\0');
+    ASSERT_EQ(file.read(reinterpret_cast<std::uint8_t *>(range.data()), reinterpret_cast<std::uint8_t *>(range.data() + range.size()), 70000u), 100u);
+    ASSERT_EQ(range, expected.substr(70000u, 100));
+    ASSERT_EQ(file.read(reinterpret_cast<std::uint8_t *>(range.data()), reinterpret_cast<std::uint8_t *>(range.data()), 70000u), 0u);
+    ASSERT_EQ(file.readAll<std::string>(), expected);
+
+    // A mapped compressed resource is pinned by its file
+    const auto mapping = file.map();
+    manager.clearDecompressionCache();
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(mapping.begin()), mapping.size()), expected);
+    ASSERT_EQ(ToText(file.queryResource()), expected);
+    file.invalidateResource();
+
+    // Hints never discard a decompressed content shared with the cache
+    const auto shared = manager.queryResource(file.resourceHandle(), file.resourcePath());
+    const auto view = file.map();
+    file.advise(IO::File::AccessHint::DontNeed);
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char *>(view.begin()), view.size()), expected);
+    ASSERT_EQ(ToText(shared), expected);
+    file.invalidateResource();
+    ASSERT_TRUE(manager.unregisterEnvironment(CompressedEnvironment));
+}
@@ -29,3 +29,20 @@ TEST(StandardPaths, GetExecutableDirectory)
     ASSERT_GT(str.size(), 0);
     ASSERT_TRUE(std::filesystem::exists(str.toView()));
 }
+
+TEST(StandardPaths, Cached)
+{
+    const auto executable = IO::GetExecutablePath<std::string_view>();
+    const auto cache = IO::GetCachePath<std::string_view>();
+
+    ASSERT_EQ(executable, IO::GetStandardPath(IO::StandardPath::Executable));
+    ASSERT_EQ(executable.data(), IO::GetExecutablePath<std::string_view>().data());
+    ASSERT_EQ(cache.data(), IO::GetCachePath<std::string_view>().data());
+    ASSERT_TRUE(executable.starts_with(IO::GetExecutableDirectory<std::string_view>()));
+
+    IO::RefreshStandardPaths();
+    ASSERT_EQ(executable, IO::GetExecutablePath<std::string_view>());
+    ASSERT_EQ(cache, IO::GetCachePath<std::string_view>());
+    ASSERT_NE(executable.data(), IO::GetExecutablePath<std::string_view>().data());
+    ASSERT_TRUE(std::filesystem::exists(executable)); // Views taken before the refresh stay valid
+}
@@ -0,0 +1,100 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of StreamReader
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#if defined(__linux__)
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <Kube/IO/ResourceManager.hpp>
+#include <Kube/IO/StreamReader.hpp>
+
+using namespace kF;
+
+constexpr std::string_view ResourcePath = ":/IOTests/FileTest01.txt";
+constexpr std::string_view ContentText = "Kube Framework !";
+
+TEST(StreamReader, Disk)
+{
+    constexpr std::size_t ChunkSize = 4096;
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_StreamReader.bin").string();
+
+    std::string expected;
+    for (auto i = 0u; i != 1000; ++i)
+        expected.append(ContentText);
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << expected;
+
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        IO::StreamReader reader(file, ChunkSize);
+        std::string content;
+        std::size_t chunks {};
+        for (const auto chunk : reader) {
+            ASSERT_LE(chunk.size(), ChunkSize);
+            content.append(reinterpret_cast<const char *>(chunk.begin()), chunk.size());
+            ++chunks;
+        }
+        ASSERT_FALSE(reader.failed());
+        ASSERT_EQ(chunks, (expected.size() + ChunkSize - 1) / ChunkSize);
+        ASSERT_EQ(content, expected);
+        ASSERT_EQ(reader.offset(), expected.size());
+        ASSERT_TRUE(reader.next().empty());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(StreamReader, Resource)
+{
+    IO::ResourceManager manager;
+    IO::File file(ResourcePath, IO::File::Mode::Read);
+    IO::StreamReader reader(file, 5);
+
+    std::string content;
+    for (const auto chunk : reader) {
+        ASSERT_GE(chunk.begin(), file.queryResource().begin());
+        content.append(reinterpret_cast<const char *>(chunk.begin()), chunk.size());
+    }
+    ASSERT_EQ(content, ContentText);
+}
+
+#if defined(__linux__)
+TEST(StreamReader, ShortReads)
+{
+    // Pipes return whatever is available, the stream must only end on an empty read
+    if (!IO::AsyncEngine(1u).isAsync())
+        GTEST_SKIP() << "io_uring is not available";
+    const auto path = (std::filesystem::temp_directory_path() / "IOTests_StreamReader.fifo").string();
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+    std::thread writer([&path] {
+        const auto descriptor = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        for (auto i = 0u; i != 3u; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            static_cast<void>(::write(descriptor, ContentText.data(), ContentText.size()));
+        }
+        ::close(descriptor);
+    });
+    std::string content;
+    {
+        IO::File file(path, IO::File::Mode::ReadBinary);
+        IO::StreamReader reader(file, 4096);
+        for (const auto chunk : reader)
+            content.append(reinterpret_cast<const char *>(chunk.begin()), chunk.size());
+        ASSERT_FALSE(reader.failed());
+    }
+    writer.join();
+    ASSERT_EQ(content.size(), ContentText.size() * 3);
+    std::filesystem::remove(path);
+}
+#endif